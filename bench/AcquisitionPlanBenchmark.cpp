@@ -0,0 +1,192 @@
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AcquisitionPlan.hpp"
+#include "Benchmark.hpp"
+
+namespace
+{
+
+struct Setup
+{
+	Setup(size_t plotsCount, size_t seriesPerPlot, bool sameVariablesInEveryPlot = false, bool shareColumns = false, bool storeRawSamples = false, const std::vector<Variable::Type>& types = {Variable::Type::U32, Variable::Type::F32}) : group("bench")
+	{
+		uint32_t address = 0x20000000;
+		for (size_t p = 0; p < plotsCount; p++)
+		{
+			auto plot = plotHandler.addPlot("plot" + std::to_string(p));
+			for (size_t s = 0; s < seriesPerPlot; s++)
+			{
+				if (sameVariablesInEveryPlot && p > 0)
+				{
+					plot->addSeries(variableHandler.getVariable("var0_" + std::to_string(s)).get());
+					continue;
+				}
+				auto var = std::make_shared<Variable>("var" + std::to_string(p) + "_" + std::to_string(s));
+				var->setType(types[s % types.size()]);
+				var->setAddress(address);
+				address += 4;
+				variableHandler.addVariable(var);
+				plot->addSeries(var.get());
+			}
+			group.addPlot(plot);
+		}
+		if (shareColumns)
+			plotHandler.shareColumns(false, "", storeRawSamples);
+		plan.compile(group, plotHandler, variableHandler);
+		raw.resize(plan.getSlotCount());
+	}
+
+	/* per-sample path as it was before the acquisition plan was introduced */
+	void legacySample(double timestamp)
+	{
+		std::unordered_map<uint32_t, double> values;
+		auto& sampleList = plan.getSampleList();
+		for (size_t i = 0; i < sampleList.size(); i++)
+			values[sampleList[i].first] = raw[i];
+
+		for (std::shared_ptr<Variable> var : variableHandler)
+		{
+			uint32_t address = var->getAddress();
+			if (values.contains(address))
+				var->setRawValue(values.at(address));
+		}
+
+		for (std::shared_ptr<Variable> var : variableHandler)
+		{
+			uint32_t address = var->getAddress();
+			if (values.contains(address))
+				csvEntry[var->getName()] = var->transformToDouble();
+		}
+
+		for (auto plot : plotHandler)
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			plot->updateSeries();
+			plot->addTimePoint(timestamp);
+		}
+	}
+
+	void planSample(double timestamp, SampleBatch& batch)
+	{
+		plan.updateVariables(raw.data());
+		plan.stage(batch, timestamp);
+
+		if (batch.isDue())
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			plan.publish(batch);
+			batch.clear();
+		}
+	}
+
+	/* bytes of the ring buffers and their snapshots per point of all series */
+	double bytesPerPoint()
+	{
+		size_t bytes = 0;
+		size_t points = 0;
+		for (auto plot : plotHandler)
+			for (auto& [name, ser] : plot->getSeriesMap())
+			{
+				bytes += ser->buffer->getAllocatedBytes();
+				points += ser->buffer->getMaxSize();
+			}
+		return points > 0 ? static_cast<double>(bytes) / points : 0.0;
+	}
+
+	PlotHandler plotHandler;
+	VariableHandler variableHandler;
+	PlotGroup group;
+	AcquisitionPlan plan;
+	std::vector<uint32_t> raw;
+	std::unordered_map<std::string, double> csvEntry;
+	std::mutex mtx;
+};
+
+void runCase(size_t plotsCount, size_t seriesPerPlot, size_t iterations)
+{
+	Setup setup(plotsCount, seriesPerPlot);
+	std::string suffix = " (" + std::to_string(plotsCount) + " plots x " + std::to_string(seriesPerPlot) + " series)";
+	double t = 0.0;
+
+	auto legacy = bench::run("legacy per-sample update" + suffix, iterations, [&]()
+							 { setup.raw[0]++; setup.legacySample(t += 0.001); });
+	SampleBatch singleSample(1, std::chrono::seconds(1));
+	singleSample.setWidth(setup.plan.getDestinationCount());
+	auto plan = bench::run("acquisition plan per-sample update" + suffix, iterations, [&]()
+						   { setup.raw[0]++; setup.planSample(t += 0.001, singleSample); });
+	bench::compare(legacy, plan);
+
+	SampleBatch batch(100, std::chrono::seconds(1));
+	batch.setWidth(setup.plan.getDestinationCount());
+	auto batched = bench::run("acquisition plan batched update (100 samples per lock)" + suffix, iterations, [&]()
+							  { setup.raw[0]++; setup.planSample(t += 0.001, batch); });
+	bench::compare(legacy, batched);
+}
+
+/* the same variables shown in every plot, appended to per-plot buffers or once to the sample store columns */
+void runSharedCase(size_t plotsCount, size_t seriesPerPlot, size_t iterations)
+{
+	std::string suffix = " (" + std::to_string(plotsCount) + " plots x the same " + std::to_string(seriesPerPlot) + " series)";
+	double t = 0.0;
+
+	Setup perPlot(plotsCount, seriesPerPlot, true, false);
+	SampleBatch perPlotBatch(100, std::chrono::seconds(1));
+	perPlotBatch.setWidth(perPlot.plan.getDestinationCount());
+	auto owned = bench::run("per-plot buffers, " + std::to_string(perPlot.plan.getDestinationCount()) + " destinations" + suffix, iterations, [&]()
+							{ perPlot.raw[0]++; perPlot.planSample(t += 0.001, perPlotBatch); });
+
+	Setup shared(plotsCount, seriesPerPlot, true, true);
+	SampleBatch sharedBatch(100, std::chrono::seconds(1));
+	sharedBatch.setWidth(shared.plan.getDestinationCount());
+	auto columns = bench::run("sample store columns, " + std::to_string(shared.plan.getDestinationCount()) + " destinations" + suffix, iterations, [&]()
+							  { shared.raw[0]++; shared.planSample(t += 0.001, sharedBatch); });
+	bench::compare(owned, columns);
+}
+
+/* sample store columns of typical firmware variables stored as doubles or packed in their native width,
+the samples are published and the snapshot the GUI draws from is updated (decoding the packed columns) */
+void runPackedCase(size_t plotsCount, size_t seriesPerPlot, size_t iterations)
+{
+	std::string suffix = " (" + std::to_string(plotsCount) + " plots x " + std::to_string(seriesPerPlot) + " series of u8/i16/u16/u32/f32)";
+	const std::vector<Variable::Type> types = {Variable::Type::U8, Variable::Type::I16, Variable::Type::U16, Variable::Type::U32, Variable::Type::F32};
+	double t = 0.0;
+
+	auto runSetup = [&](const std::string& name, Setup& setup)
+	{
+		SampleBatch batch(100, std::chrono::seconds(1));
+		batch.setWidth(setup.plan.getDestinationCount());
+		uint32_t sample = 0;
+		auto result = bench::run(name + suffix, iterations, [&]()
+								 {
+			setup.raw[0]++;
+			setup.planSample(t += 0.001, batch);
+			/* the GUI copies about once per frame */
+			if (++sample % 1000 == 0)
+				for (auto plot : setup.plotHandler)
+					for (auto& [serName, ser] : plot->getSeriesMap())
+						ser->buffer->copyData(); });
+		std::printf("  %-80s %14.2f B/point\n", ("ring + snapshot storage, " + name).c_str(), setup.bytesPerPoint());
+		return result;
+	};
+
+	Setup plain(plotsCount, seriesPerPlot, false, true, false, types);
+	auto plainResult = runSetup("double columns, publish + snapshot", plain);
+	Setup packed(plotsCount, seriesPerPlot, false, true, true, types);
+	auto packedResult = runSetup("packed columns, publish + decoded snapshot", packed);
+	bench::compare(plainResult, packedResult);
+}
+
+}  // namespace
+
+BENCHMARK(AcquisitionPlanBenchmark)
+{
+	runCase(1, 4, 200000);
+	runCase(4, 8, 100000);
+	runCase(8, 16, 20000);
+	runSharedCase(4, 8, 100000);
+	runPackedCase(4, 8, 100000);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace bench
+{
+
+/* keeps the compiler from optimizing away the benchmarked computation */
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct Result
+{
+	std::string name;
+	size_t iterations;
+	double nsPerIteration;
+};
+
+/// @brief calls f iterations times after a short warm-up and prints the average time per call
+template <typename F>
+inline Result run(const std::string& name, size_t iterations, F&& f)
+{
+	for (size_t i = 0; i < iterations / 10 + 1; i++)
+		f();
+
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < iterations; i++)
+		f();
+	auto end = std::chrono::steady_clock::now();
+
+	double ns = std::chrono::duration_cast<std::chrono::duration<double, std::nano>>(end - start).count() / static_cast<double>(iterations);
+	std::printf("  %-80s %14.1f ns/op  (%zu iterations)\n", name.c_str(), ns, iterations);
+	return Result{name, iterations, ns};
+}
+
+/// @brief prints the ratio between two results of the same benchmark
+inline void compare(const Result& baseline, const Result& candidate)
+{
+	std::printf("  %-80s %14.2fx\n", ("speedup " + candidate.name).c_str(), baseline.nsPerIteration / candidate.nsPerIteration);
+}
+
+using BenchmarkFunction = void (*)();
+
+inline std::vector<std::pair<std::string, BenchmarkFunction>>& registry()
+{
+	static std::vector<std::pair<std::string, BenchmarkFunction>> benchmarks;
+	return benchmarks;
+}
+
+struct Registrar
+{
+	Registrar(const char* name, BenchmarkFunction function) { registry().emplace_back(name, function); }
+};
+
+}  // namespace bench
+
+#define BENCHMARK(name)                                        \
+	static void name();                                        \
+	static bench::Registrar name##Registrar(#name, name);      \
+	static void name()
@@ -0,0 +1,51 @@
+#include <cmath>
+#include <cstdio>
+#include <string>
+
+#include "Benchmark.hpp"
+#include "CompressedHistory.hpp"
+#include "ScrollingBuffer.hpp"
+
+namespace
+{
+
+/* a slowly changing ADC reading sampled at 1 kHz with a little timestamp jitter */
+void runCase(const std::string& name, double (*signal)(uint32_t), size_t iterations)
+{
+	ScrollingBuffer<double> raw;
+	raw.setMaxSize(static_cast<uint32_t>(iterations * 2));
+	CompressedHistory time(CompressedHistory::Encoding::DELTA_OF_DELTA);
+	CompressedHistory values(CompressedHistory::Encoding::XOR);
+	uint32_t i = 0;
+
+	auto ring = bench::run("ring buffer append, " + name, iterations, [&]()
+						   { raw.addPoint(signal(i++)); });
+
+	i = 0;
+	auto compressed = bench::run("compressed history append (time + value), " + name, iterations, [&]()
+								 {
+		time.append(i * 1e-3 + ((i * 2654435761u) % 1000) * 1e-9);
+		values.append(signal(i++)); });
+	bench::compare(ring, compressed);
+
+	double bytesPerPoint = static_cast<double>(time.getMemoryBytes() + values.getMemoryBytes()) / static_cast<double>(values.size());
+	std::printf("  %-80s %14.2f B/point (raw 16.00)\n", ("compressed size, " + name).c_str(), bytesPerPoint);
+}
+
+double slowInteger(uint32_t i)
+{
+	return std::floor(2048.0 + 100.0 * std::sin(i * 1e-4));
+}
+
+double noisyFloat(uint32_t i)
+{
+	return static_cast<float>(std::sin(i * 1e-3) + ((i * 2654435761u) % 1000) * 1e-5);
+}
+
+}  // namespace
+
+BENCHMARK(CompressedHistoryBenchmark)
+{
+	runCase("slowly changing integer", slowInteger, 2000000);
+	runCase("noisy float", noisyFloat, 2000000);
+}
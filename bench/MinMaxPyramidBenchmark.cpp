@@ -0,0 +1,57 @@
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "MinMaxPyramid.hpp"
+#include "ScrollingBuffer.hpp"
+
+namespace
+{
+
+/* cost of preparing one frame of a plot 2000 pixels wide showing the whole buffer */
+void runCase(uint32_t points, size_t iterations)
+{
+	constexpr uint32_t plotWidth = 2000;
+
+	ScrollingBuffer<double> time;
+	ScrollingBuffer<double> values;
+	time.setMaxSize(points);
+	values.setMaxSize(points);
+
+	for (uint32_t i = 0; i < points; i++)
+	{
+		time.addPoint(i * 0.001);
+		values.addPoint(std::sin(i * 0.01));
+	}
+	time.copyData();
+	values.copyData();
+
+	MinMaxPyramid<double> pyramid;
+	pyramid.update(values);
+
+	std::vector<double> xs;
+	std::vector<double> ys;
+	std::string suffix = " (" + std::to_string(points) + " points)";
+
+	auto full = bench::run("linearized full buffer" + suffix, iterations, [&]()
+						   {
+		xs.assign(time.getFirstElementCopy(), time.getFirstElementCopy() + time.getCopySize());
+		ys.assign(values.getFirstElementCopy(), values.getFirstElementCopy() + values.getCopySize());
+		bench::doNotOptimize(ys.data()); });
+
+	auto decimated = bench::run("min/max pyramid decimation" + suffix, iterations, [&]()
+								{
+		pyramid.decimate(time, values, 0.0, points * 0.001, plotWidth, xs, ys);
+		bench::doNotOptimize(ys.data()); });
+	bench::compare(full, decimated);
+}
+
+}  // namespace
+
+BENCHMARK(MinMaxPyramidBenchmark)
+{
+	runCase(10000, 2000);
+	runCase(1000000, 200);
+	runCase(10000000, 20);
+}
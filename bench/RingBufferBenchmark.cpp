@@ -0,0 +1,139 @@
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "RingBuffer.hpp"
+#include "RingBufferBlocking.hpp"
+#include "SpscRingBuffer.hpp"
+
+namespace
+{
+
+constexpr size_t capacity = 2000;
+constexpr uint32_t items = 200000;
+
+/* one HSS sample of 8 variables, the same type the J-Link and simulated probes queue */
+using HssEntry = std::pair<double, std::vector<uint32_t>>;
+/* one decoded SWO timestamp frame, the same type the trace reader queues */
+using TraceEntry = std::pair<std::array<uint32_t, 10>, double>;
+
+/* producer and consumer run on their own threads, one iteration moves all items - polling sides yield
+so that the results are meaningful on a single core as well */
+template <typename Produce, typename Consume>
+void transfer(Produce&& produce, Consume&& consume)
+{
+	std::thread producer([&]()
+						 {
+		for (uint32_t i = 0; i < items; i++)
+			produce(i); });
+
+	for (uint32_t i = 0; i < items; i++)
+		consume();
+	producer.join();
+}
+
+void runHssCase()
+{
+	constexpr uint32_t variables = 8;
+	std::string suffix = " (" + std::to_string(items) + " HSS entries)";
+
+	RingBuffer<HssEntry, capacity> locked;
+	auto mutexResult = bench::run("mutex RingBuffer push/pop" + suffix, 5, [&]()
+								  {
+		HssEntry entry{0.0, std::vector<uint32_t>(variables)};
+		transfer([&](uint32_t i)
+				 {
+			entry.first = i;
+			while (!locked.push(entry))
+				std::this_thread::yield(); },
+				 [&]()
+				 {
+			std::optional<HssEntry> popped;
+			while (!(popped = locked.pop()))
+				std::this_thread::yield();
+			bench::doNotOptimize(popped->first); }); });
+
+	SpscRingBuffer<HssEntry> ring(capacity);
+	auto spscResult = bench::run("SPSC ring claim/publish in place, tryPop" + suffix, 5, [&]()
+								 {
+		transfer([&](uint32_t i)
+				 {
+			HssEntry* slot;
+			while ((slot = ring.claim()) == nullptr)
+				std::this_thread::yield();
+			slot->first = i;
+			slot->second.assign(variables, i);
+			ring.publish(); },
+				 [&]()
+				 {
+			HssEntry entry;
+			while (!ring.tryPop(entry))
+				std::this_thread::yield();
+			bench::doNotOptimize(entry.first); }); });
+	bench::compare(mutexResult, spscResult);
+}
+
+void runTraceCase()
+{
+	std::string suffix = " (" + std::to_string(items) + " trace entries)";
+
+	RingBufferBlocking<TraceEntry, capacity> blocking;
+	auto blockingResult = bench::run("mutex/condvar RingBufferBlocking push/pop" + suffix, 5, [&]()
+									 {
+		transfer([&](uint32_t i)
+				 {
+			while (!blocking.push(TraceEntry{{i}, static_cast<double>(i)}))
+				; },
+				 [&]()
+				 { bench::doNotOptimize(blocking.pop().second); }); });
+
+	SpscRingBuffer<TraceEntry> ring(capacity, true);
+	auto spscResult = bench::run("SPSC ring push, waitForData" + suffix, 5, [&]()
+								 {
+		transfer([&](uint32_t i)
+				 {
+			while (!ring.push(TraceEntry{{i}, static_cast<double>(i)}))
+				std::this_thread::yield(); },
+				 [&]()
+				 {
+			TraceEntry entry;
+			while (!ring.tryPop(entry))
+				ring.waitForData(std::chrono::microseconds(1000));
+			bench::doNotOptimize(entry.second); }); });
+	bench::compare(blockingResult, spscResult);
+
+	/* the consumer drains everything available at once */
+	std::vector<TraceEntry> batch(256);
+	auto bulkResult = bench::run("SPSC ring push, waitForData, popN" + suffix, 5, [&]()
+								 {
+		std::thread producer([&]()
+							 {
+			for (uint32_t i = 0; i < items; i++)
+				while (!ring.push(TraceEntry{{i}, static_cast<double>(i)}))
+					std::this_thread::yield(); });
+
+		for (uint32_t received = 0; received < items;)
+		{
+			size_t count = ring.popN(batch.data(), batch.size());
+			if (count == 0)
+				ring.waitForData(std::chrono::microseconds(1000));
+			received += static_cast<uint32_t>(count);
+		}
+		bench::doNotOptimize(batch[0].second);
+		producer.join(); });
+	bench::compare(blockingResult, bulkResult);
+}
+
+}  // namespace
+
+BENCHMARK(RingBufferBenchmark)
+{
+	runHssCase();
+	runTraceCase();
+}
@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "FileTraceProbe.hpp"
+#include "ItmDecoder.hpp"
+#include "SpscRingBuffer.hpp"
+#include "spdlog/sinks/null_sink.h"
+
+namespace
+{
+
+constexpr uint32_t channels = ItmDecoder::channels;
+/* the dense snapshot of all channels the old decoder emitted per timestamp */
+using Entry = std::pair<std::array<uint32_t, channels>, double>;
+
+/* the chunk size TraceReader reads from the probe */
+constexpr size_t chunkSize = 10 * 2048;
+constexpr size_t streamSize = 50 * chunkSize;
+
+/// @brief the byte-at-a-time state machine TraceReader used before ItmDecoder, with the logging removed and
+/// the out of range indices clamped
+class LegacyTraceDecoder
+{
+   public:
+	explicit LegacyTraceDecoder(SpscRingBuffer<Entry>& traceTable) : traceTable(traceTable) {}
+
+	void decode(const uint8_t* data, size_t length)
+	{
+		for (size_t i = 0; i < length; i++)
+			state = updateTrace(data[i]);
+	}
+
+   private:
+	typedef enum
+	{
+		TRACE_STATE_IDLE,
+		TRACE_STATE_TARGET_SOURCE_1B,
+		TRACE_STATE_TARGET_SOURCE_2B,
+		TRACE_STATE_TARGET_SOURCE_3B,
+		TRACE_STATE_TARGET_SOURCE_4B,
+		TRACE_STATE_TARGET_TIMESTAMP_HEADER,
+		TRACE_STATE_TARGET_TIMESTAMP_CONT,
+		TRACE_STATE_SKIP_FRAME,
+	} TraceState;
+
+	TraceState updateTraceIdle(uint8_t c)
+	{
+		framesTotal++;
+
+		if ((c & 0x03) != 0x00 && (c & 0x04) == 0x00)
+		{
+			sourceFrameSize = (c & 0x03);
+			currentChannel[awaitingTimestamp] = (c & 0xf8) >> 3;
+			return TRACE_STATE_TARGET_SOURCE_1B;
+		}
+		else if ((c & 0x0f) == 0x00 && (c & 0x70) != 0x00)
+		{
+			timestampVec.clear();
+			timestamp = 0;
+
+			if (c == 0xD0)
+				delayedTimestamp1++;
+			else if (c == 0xE0)
+				delayedTimestamp2++;
+			else if (c == 0xF0)
+				delayedTimestamp3++;
+
+			if (c & 0x80)
+				return TRACE_STATE_TARGET_TIMESTAMP_HEADER;
+			timestampVec.push_back(c);
+			timestampEnd(true);
+			return TRACE_STATE_IDLE;
+		}
+		else if ((c & 0x0b) == 0x08)
+			return (c & 0x80) ? TRACE_STATE_SKIP_FRAME : TRACE_STATE_IDLE;
+
+		errorFramesTotal++;
+		return TRACE_STATE_IDLE;
+	}
+
+	void timestampEnd(bool headerData)
+	{
+		if (headerData)
+			timestamp = (uint32_t)(timestampVec[0] & 0x7f) >> 4;
+		else
+		{
+			for (uint32_t i = 0; i < timestampVec.size(); i++)
+				timestamp |= (uint32_t)(timestampVec[i] & 0x7f) << 7 * i;
+		}
+
+		std::array<uint32_t, channels> currentEntry{previousEntry};
+
+		uint32_t i = 0;
+		while (awaitingTimestamp--)
+		{
+			if (currentChannel[i] >= channels || i >= channels - 1)
+			{
+				errorFramesTotal++;
+				break;
+			}
+			currentEntry[currentChannel[i]] = currentValue[i];
+			i++;
+		}
+
+		traceTable.push(Entry{currentEntry, timestamp});
+		previousEntry = currentEntry;
+		awaitingTimestamp = 0;
+	}
+
+	TraceState updateTrace(uint8_t c)
+	{
+		awaitingTimestamp = std::clamp(awaitingTimestamp, (uint8_t)0, (uint8_t)(channels - 1));
+
+		switch (state)
+		{
+			case TRACE_STATE_IDLE:
+				return updateTraceIdle(c);
+			case TRACE_STATE_TARGET_SOURCE_1B:
+				currentValue[awaitingTimestamp] = c;
+				if (sourceFrameSize == 0x01)
+				{
+					awaitingTimestamp++;
+					return TRACE_STATE_IDLE;
+				}
+				return TRACE_STATE_TARGET_SOURCE_2B;
+			case TRACE_STATE_TARGET_SOURCE_2B:
+				currentValue[awaitingTimestamp] |= (c << 8);
+				if (sourceFrameSize == 0x02)
+				{
+					awaitingTimestamp++;
+					return TRACE_STATE_IDLE;
+				}
+				return TRACE_STATE_TARGET_SOURCE_3B;
+			case TRACE_STATE_TARGET_SOURCE_3B:
+				currentValue[awaitingTimestamp] |= (c << 16);
+				return TRACE_STATE_TARGET_SOURCE_4B;
+			case TRACE_STATE_TARGET_SOURCE_4B:
+				currentValue[awaitingTimestamp++] |= (c << 24);
+				return TRACE_STATE_IDLE;
+			case TRACE_STATE_TARGET_TIMESTAMP_HEADER:
+			case TRACE_STATE_TARGET_TIMESTAMP_CONT:
+				timestampVec.push_back(c);
+				if (c & 0x80)
+					return TRACE_STATE_TARGET_TIMESTAMP_CONT;
+				timestampEnd(false);
+				return TRACE_STATE_IDLE;
+			case TRACE_STATE_SKIP_FRAME:
+				return (c & 0x80) ? TRACE_STATE_SKIP_FRAME : TRACE_STATE_IDLE;
+		}
+		return TRACE_STATE_IDLE;
+	}
+
+   private:
+	SpscRingBuffer<Entry>& traceTable;
+	TraceState state = TRACE_STATE_IDLE;
+	uint32_t currentValue[channels]{};
+	uint8_t currentChannel[channels]{};
+	uint8_t awaitingTimestamp = 0;
+	uint32_t timestamp = 0;
+	uint8_t sourceFrameSize = 0;
+	std::vector<uint8_t> timestampVec;
+	std::array<uint32_t, channels> previousEntry{};
+	uint32_t framesTotal = 0;
+	uint32_t errorFramesTotal = 0;
+	uint32_t delayedTimestamp1 = 0;
+	uint32_t delayedTimestamp2 = 0;
+	uint32_t delayedTimestamp3 = 0;
+};
+
+/* frames shaped like the TraceReaderTest inputs - sources of the given size on the given channels, each
+followed by a local timestamp with two continuation bytes */
+std::vector<uint8_t> makeStream(uint8_t sourceSize, uint32_t sourcesPerTimestamp)
+{
+	const uint8_t sizeBits = sourceSize == 4 ? 0x03 : sourceSize;
+	std::vector<uint8_t> stream;
+	stream.reserve(streamSize);
+
+	for (uint32_t frame = 0; stream.size() < streamSize; frame++)
+	{
+		for (uint32_t source = 0; source < sourcesPerTimestamp; source++)
+		{
+			stream.push_back(static_cast<uint8_t>(((source + 1) << 3) | sizeBits));
+			for (uint8_t byte = 0; byte < sourceSize; byte++)
+				stream.push_back(static_cast<uint8_t>(187 + frame + byte));
+		}
+		stream.push_back(192);
+		stream.push_back(static_cast<uint8_t>(0x80 | (frame & 0x7f)));
+		stream.push_back(9);
+	}
+	stream.resize(streamSize);
+	return stream;
+}
+
+void runCase(const std::string& name, const std::vector<uint8_t>& stream)
+{
+	SpscRingBuffer<Entry> traceTable(8192);
+	SpscRingBuffer<ItmDecoder::Event> eventTable(32768);
+
+	/* the table is drained after every chunk, as the data handler would */
+	auto legacyResult = bench::run("byte-wise state machine, push per entry (" + name + ")", 10, [&]()
+								   {
+		LegacyTraceDecoder legacy(traceTable);
+		for (size_t offset = 0; offset < stream.size(); offset += chunkSize)
+		{
+			legacy.decode(stream.data() + offset, std::min(chunkSize, stream.size() - offset));
+			traceTable.clear();
+		} });
+
+	std::array<ItmDecoder::Event, 256> batch{};
+	auto decoderResult = bench::run("ItmDecoder into batch, pushN (" + name + ")", 10, [&]()
+									{
+		ItmDecoder decoder;
+		for (size_t offset = 0; offset < stream.size(); offset += chunkSize)
+		{
+			size_t length = std::min(chunkSize, stream.size() - offset);
+			for (size_t decoded = 0; decoded < length;)
+			{
+				auto result = decoder.decode(stream.data() + offset + decoded, length - decoded, batch.data(), batch.size());
+				eventTable.pushN(batch.data(), result.events);
+				decoded += result.bytes;
+			}
+			eventTable.clear();
+		} });
+	bench::compare(legacyResult, decoderResult);
+
+	double megabytes = static_cast<double>(stream.size()) / 1e6;
+	std::printf("  %-80s %14.2f MB/s\n", ("byte-wise state machine throughput (" + name + ")").c_str(), megabytes / (legacyResult.nsPerIteration * 1e-9));
+	std::printf("  %-80s %14.2f MB/s\n", ("ItmDecoder throughput (" + name + ")").c_str(), megabytes / (decoderResult.nsPerIteration * 1e-9));
+}
+
+/* the raw bytes of a capture recorded with RecordingTraceProbe, read the way TraceReader reads them */
+std::vector<uint8_t> loadCapture(const std::string& path)
+{
+	auto logger = std::make_shared<spdlog::logger>("bench", std::make_shared<spdlog::sinks::null_sink_mt>());
+	FileTraceProbe probe(logger.get());
+
+	ITraceProbe::TraceProbeSettings probeSettings{};
+	probeSettings.replayFilePath = path;
+	probeSettings.replayRealTime = false;
+
+	std::vector<uint8_t> stream;
+	if (!probe.startTrace(probeSettings, 0, 0, 0, false))
+		return stream;
+
+	std::vector<uint8_t> chunk(chunkSize);
+	for (int32_t length; (length = probe.readTraceBuffer(chunk.data(), chunk.size())) > 0;)
+		stream.insert(stream.end(), chunk.begin(), chunk.begin() + length);
+	probe.stopTrace();
+	return stream;
+}
+
+}  // namespace
+
+BENCHMARK(TraceDecoderBenchmark)
+{
+	runCase("3 x 1 byte sources per timestamp", makeStream(1, 3));
+	runCase("8 x 4 byte sources per timestamp", makeStream(4, 8));
+
+	/* MCUVIEWER_SWO_CAPTURE=<file> adds a case decoding a real SWO capture */
+	if (const char* path = std::getenv("MCUVIEWER_SWO_CAPTURE"))
+	{
+		auto stream = loadCapture(path);
+		if (stream.empty())
+			std::printf("  could not read the SWO capture %s\n", path);
+		else
+			runCase("SWO capture", stream);
+	}
+}
@@ -0,0 +1,20 @@
+#include <cstdio>
+#include <string>
+
+#include "Benchmark.hpp"
+
+int main(int argc, char** argv)
+{
+	/* optional argument filters the benchmarks by name */
+	std::string filter = argc > 1 ? argv[1] : "";
+
+	for (auto& [name, function] : bench::registry())
+	{
+		if (!filter.empty() && name.find(filter) == std::string::npos)
+			continue;
+
+		std::printf("%s\n", name.c_str());
+		function();
+	}
+	return 0;
+}
@@ -0,0 +1,8 @@
+#!/usr/bin/env bash
+
+rm -rf build_bench
+mkdir build_bench
+cd build_bench
+cmake .. -DMAKE_BENCHMARKS=1
+make -j
+./bench/MCUViewer_bench "$@"
@@ -66,6 +66,23 @@ void CSVStreamer::writeLine(double time, std::unordered_map<std::string, double>
 	}
 	line.back() = '\n';
 
+	appendLine(line);
+}
+
+void CSVStreamer::writeLine(double time, const std::vector<double>& values)
+{
+	std::string line = std::to_string(time) + ",";
+	for (const auto& value : values)
+	{
+		line += std::to_string(value) + ",";
+	}
+	line.back() = '\n';
+
+	appendLine(line);
+}
+
+void CSVStreamer::appendLine(std::string& line)
+{
 	currentBuffer->appendLine(line);
 
 	if (currentBuffer->isFull())
@@ -39,6 +39,11 @@ class CSVStreamer
 	/// @param valuesMap
 	void writeLine(double time, std::unordered_map<std::string, double>& valuesMap);
 
+	/// @brief writes single line to internal buffer
+	/// @param time
+	/// @param values values in the order of the header names
+	void writeLine(double time, const std::vector<double>& values);
+
 	/// @brief exchanges the buffer that is being processed with the one that's being written to
 	void exchangeBuffers();
 
@@ -49,6 +54,8 @@ class CSVStreamer
 	void finishLogging();
 
    private:
+	void appendLine(std::string& line);
+
 	const char* logFileName = "/logfile.csv";
 
 	spdlog::logger* logger;
@@ -279,9 +279,23 @@ bool ConfigHandler::readConfigFile(std::string& elfPath)
 	getValue("settings", "probe_mode", debugProbeSettings.mode);
 	getValue("settings", "probe_speed_kHz", debugProbeSettings.speedkHz);
 	debugProbeSettings.serialNumber = ini->get("settings").get("probe_SN");
+	debugProbeSettings.simulationGenerators = ini->get("settings").get("simulation_generators");
+	getValue("settings", "simulation_latency_us", debugProbeSettings.simulationLatencyUs);
+	getValue("settings", "simulation_bandwidth_kBps", debugProbeSettings.simulationBandwidthKBps);
+	debugProbeSettings.replayFilePath = ini->get("settings").get("replay_file_path");
+	getValue("settings", "replay_real_time", debugProbeSettings.replayRealTime);
+	debugProbeSettings.gdbServerAddress = ini->get("settings").get("gdb_server_address");
 	getValue("settings", "should_log", viewerSettings.shouldLog);
 	viewerSettings.logFilePath = ini->get("settings").get("log_directory");
 	viewerSettings.gdbCommand = ini->get("settings").get("gdb_command");
+	getValue("settings", "read_max_gap", viewerSettings.readMaxGap);
+	getValue("settings", "read_max_block_size", viewerSettings.readMaxBlockSize);
+	getValue("settings", "overrun_policy", viewerSettings.overrunPolicy);
+	getValue("settings", "compressed_history", viewerSettings.keepCompressedHistory);
+	viewerSettings.historyDirectory = ini->get("settings").get("history_directory");
+	getValue("settings", "store_raw_samples", viewerSettings.storeRawSamples);
+	getValue("settings", "record_capture", viewerSettings.shouldRecordCapture);
+	viewerSettings.captureFilePath = ini->get("settings").get("capture_file_path");
 
 	if (viewerSettings.gdbCommand.empty())
 		viewerSettings.gdbCommand = "gdb";
@@ -299,6 +313,12 @@ bool ConfigHandler::readConfigFile(std::string& elfPath)
 	traceProbeSettings.serialNumber = ini->get("trace_settings").get("probe_SN");
 	getValue("trace_settings", "should_log", traceSettings.shouldLog);
 	traceSettings.logFilePath = ini->get("trace_settings").get("log_directory");
+	getValue("trace_settings", "compressed_history", traceSettings.keepCompressedHistory);
+	traceSettings.historyDirectory = ini->get("trace_settings").get("history_directory");
+	getValue("trace_settings", "record_capture", traceSettings.shouldRecordCapture);
+	traceSettings.captureFilePath = ini->get("trace_settings").get("capture_file_path");
+	traceProbeSettings.replayFilePath = ini->get("trace_settings").get("replay_file_path");
+	getValue("trace_settings", "replay_real_time", traceProbeSettings.replayRealTime);
 
 	/* TODO magic numbers (lots of them)! */
 	if (traceSettings.timeout == 0)
@@ -322,6 +342,9 @@ bool ConfigHandler::readConfigFile(std::string& elfPath)
 	if (viewerSettings.maxViewportPoints == 0)
 		viewerSettings.maxViewportPoints = viewerSettings.maxPoints;
 
+	if (viewerSettings.readMaxBlockSize == 0)
+		viewerSettings.readMaxBlockSize = MemoryReadPlanner::Settings{}.maxBlockSize;
+
 	if (debugProbeSettings.speedkHz == 0)
 		debugProbeSettings.speedkHz = 100;
 
@@ -392,9 +415,23 @@ mINI::INIStructure ConfigHandler::prepareSaveConfigFile(const std::string& elfPa
 	(configIni)["settings"]["probe_mode"] = std::to_string(debugProbeSettings.mode);
 	(configIni)["settings"]["probe_speed_kHz"] = std::to_string(debugProbeSettings.speedkHz);
 	(configIni)["settings"]["probe_SN"] = debugProbeSettings.serialNumber;
+	(configIni)["settings"]["simulation_generators"] = debugProbeSettings.simulationGenerators;
+	(configIni)["settings"]["simulation_latency_us"] = std::to_string(debugProbeSettings.simulationLatencyUs);
+	(configIni)["settings"]["simulation_bandwidth_kBps"] = std::to_string(debugProbeSettings.simulationBandwidthKBps);
+	(configIni)["settings"]["replay_file_path"] = debugProbeSettings.replayFilePath;
+	(configIni)["settings"]["replay_real_time"] = debugProbeSettings.replayRealTime ? std::string("true") : std::string("false");
+	(configIni)["settings"]["gdb_server_address"] = debugProbeSettings.gdbServerAddress;
 	(configIni)["settings"]["should_log"] = viewerSettings.shouldLog ? std::string("true") : std::string("false");
 	(configIni)["settings"]["log_directory"] = viewerSettings.logFilePath;
 	(configIni)["settings"]["gdb_command"] = viewerSettings.gdbCommand;
+	(configIni)["settings"]["read_max_gap"] = std::to_string(viewerSettings.readMaxGap);
+	(configIni)["settings"]["read_max_block_size"] = std::to_string(viewerSettings.readMaxBlockSize);
+	(configIni)["settings"]["overrun_policy"] = std::to_string(static_cast<uint8_t>(viewerSettings.overrunPolicy));
+	(configIni)["settings"]["compressed_history"] = viewerSettings.keepCompressedHistory ? std::string("true") : std::string("false");
+	(configIni)["settings"]["history_directory"] = viewerSettings.historyDirectory;
+	(configIni)["settings"]["store_raw_samples"] = viewerSettings.storeRawSamples ? std::string("true") : std::string("false");
+	(configIni)["settings"]["record_capture"] = viewerSettings.shouldRecordCapture ? std::string("true") : std::string("false");
+	(configIni)["settings"]["capture_file_path"] = viewerSettings.captureFilePath;
 
 	(configIni)["trace_settings"]["core_frequency"] = std::to_string(traceSettings.coreFrequency);
 	(configIni)["trace_settings"]["trace_prescaler"] = std::to_string(traceSettings.tracePrescaler);
@@ -409,6 +446,12 @@ mINI::INIStructure ConfigHandler::prepareSaveConfigFile(const std::string& elfPa
 	(configIni)["trace_settings"]["probe_SN"] = traceProbeSettings.serialNumber;
 	(configIni)["trace_settings"]["should_log"] = traceSettings.shouldLog ? std::string("true") : std::string("false");
 	(configIni)["trace_settings"]["log_directory"] = traceSettings.logFilePath;
+	(configIni)["trace_settings"]["compressed_history"] = traceSettings.keepCompressedHistory ? std::string("true") : std::string("false");
+	(configIni)["trace_settings"]["history_directory"] = traceSettings.historyDirectory;
+	(configIni)["trace_settings"]["record_capture"] = traceSettings.shouldRecordCapture ? std::string("true") : std::string("false");
+	(configIni)["trace_settings"]["capture_file_path"] = traceSettings.captureFilePath;
+	(configIni)["trace_settings"]["replay_file_path"] = traceProbeSettings.replayFilePath;
+	(configIni)["trace_settings"]["replay_real_time"] = traceProbeSettings.replayRealTime ? std::string("true") : std::string("false");
 
 	uint32_t varId = 0;
 	for (std::shared_ptr<Variable> var : *variableHandler)
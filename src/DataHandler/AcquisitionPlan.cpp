@@ -0,0 +1,217 @@
+#include "AcquisitionPlan.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+void AcquisitionPlan::clear()
+{
+	sampleList.clear();
+	bindings.clear();
+	destinations.clear();
+	timeBuffers.clear();
+	timeHistories.clear();
+	csvColumns.clear();
+	csvHeader.clear();
+}
+
+void AcquisitionPlan::addSlot(uint32_t address, uint8_t size)
+{
+	std::pair<uint32_t, uint8_t> newElement{address, size};
+	if (std::find(sampleList.begin(), sampleList.end(), newElement) == sampleList.end())
+		sampleList.push_back(newElement);
+}
+
+void AcquisitionPlan::compile(PlotGroup& activeGroup, PlotHandler& plotHandler, VariableHandler& variableHandler)
+{
+	clear();
+
+	for (auto& [name, plotElem] : activeGroup)
+	{
+		auto plot = plotElem.plot;
+
+		if (!plotElem.visibility)
+			continue;
+
+		for (auto& [serName, ser] : plot->getSeriesMap())
+		{
+			if (!ser->visible)
+				continue;
+
+			addSlot(ser->var->getAddress(), ser->var->getSize());
+
+			Variable* maybeXAxisVariable = plot->getXAxisVariable();
+			if (plot->getType() == Plot::Type::XY && maybeXAxisVariable != nullptr)
+				addSlot(maybeXAxisVariable->getAddress(), maybeXAxisVariable->getSize());
+		}
+	}
+
+	/* additionally scan for eventual bases of fractional variables that should be sampled */
+	for (auto variable : variableHandler)
+	{
+		auto baseVariable = variable->getFractional().baseVariable;
+		if (baseVariable != nullptr)
+			addSlot(baseVariable->getAddress(), baseVariable->getSize());
+	}
+
+	/* bind variables to slots - exact matches are marked as actively sampled, variables
+	sharing only the address are updated from the slot as well */
+	for (auto variable : variableHandler)
+	{
+		variable->setIsCurrentlySampled(false);
+
+		auto exact = std::find(sampleList.begin(), sampleList.end(), std::pair<uint32_t, uint8_t>(variable->getAddress(), variable->getSize()));
+		if (exact != sampleList.end())
+		{
+			variable->setIsCurrentlySampled(true);
+			bindings.push_back({static_cast<uint32_t>(exact - sampleList.begin()), variable.get()});
+			continue;
+		}
+
+		auto sameAddress = std::find_if(sampleList.begin(), sampleList.end(), [&](const auto& element)
+										{ return element.first == variable->getAddress(); });
+		if (sameAddress != sampleList.end())
+			bindings.push_back({static_cast<uint32_t>(sameAddress - sampleList.begin()), variable.get()});
+	}
+
+	/* fractional variables read their base value, so the bases have to be converted first */
+	std::stable_partition(bindings.begin(), bindings.end(), [](const Binding& binding)
+						  { return !binding.var->isFractional(); });
+
+	/* every plot with a sampled series receives a point per sample so that all its series stay aligned
+	with its time buffer, the other plots would only record stale values and get no buffers at all.
+	Buffers shared between plots (sample store columns) are appended once */
+	auto addDestination = [&](Plot::Series* series)
+	{
+		if (std::none_of(destinations.begin(), destinations.end(), [&](const Destination& destination)
+						 { return destination.buffer == series->buffer.get(); }))
+			destinations.push_back({series->buffer.get(), series->history.get(), series->var, series->buffer->getCodec()});
+	};
+
+	for (std::shared_ptr<Plot> plot : plotHandler)
+	{
+		bool isSampled = std::any_of(plot->getSeriesMap().begin(), plot->getSeriesMap().end(), [&](const auto& entry)
+									 { return std::any_of(bindings.begin(), bindings.end(), [&](const Binding& binding)
+														  { return binding.var == entry.second->var; }); });
+		if (!isSampled)
+			continue;
+
+		for (auto& [serName, ser] : plot->getSeriesMap())
+			addDestination(ser.get());
+
+		auto xAxisSeries = plot->getXAxisVariableSeries();
+		if (xAxisSeries->var != nullptr)
+			addDestination(xAxisSeries);
+
+		if (std::find(timeBuffers.begin(), timeBuffers.end(), plot->getTimeSeries()) == timeBuffers.end())
+		{
+			timeBuffers.push_back(plot->getTimeSeries());
+			if (plot->getTimeHistory() != nullptr)
+				timeHistories.push_back(plot->getTimeHistory());
+		}
+	}
+
+	for (auto& [name, plotElem] : activeGroup)
+	{
+		if (!plotElem.visibility)
+			continue;
+
+		for (auto& [serName, ser] : plotElem.plot->getSeriesMap())
+		{
+			bool isBound = std::any_of(bindings.begin(), bindings.end(), [&](const Binding& binding)
+									   { return binding.var == ser->var; });
+			csvHeader.push_back(serName);
+			csvColumns.push_back(isBound ? ser->var : nullptr);
+		}
+	}
+}
+
+AcquisitionPlan::SampleListType& AcquisitionPlan::getSampleList()
+{
+	return sampleList;
+}
+
+size_t AcquisitionPlan::getSlotCount() const
+{
+	return sampleList.size();
+}
+
+void AcquisitionPlan::updateVariables(const uint32_t* raw)
+{
+	for (const auto& binding : bindings)
+		binding.var->setRawValue(raw[binding.slot]);
+
+	for (const auto& binding : bindings)
+		binding.var->transformToDouble();
+}
+
+size_t AcquisitionPlan::getDestinationCount() const
+{
+	return destinations.size();
+}
+
+void AcquisitionPlan::stage(SampleBatch& batch, double timestamp) const
+{
+	double* values = batch.stage(timestamp);
+	for (size_t i = 0; i < destinations.size(); i++)
+		values[i] = destinations[i].codec != nullptr ? destinations[i].var->getRawValue() : destinations[i].var->getValue();
+}
+
+void AcquisitionPlan::publish(const SampleBatch& batch)
+{
+	for (size_t i = 0; i < destinations.size(); i++)
+	{
+		const PackedCodec<double>* codec = destinations[i].codec;
+
+		/* raw values are staged exactly as doubles */
+		if (codec != nullptr)
+		{
+			for (size_t sample = 0; sample < batch.size(); sample++)
+				destinations[i].buffer->addRaw(static_cast<uint32_t>(batch.getValues(sample)[i]));
+		}
+		else
+		{
+			for (size_t sample = 0; sample < batch.size(); sample++)
+				destinations[i].buffer->addPoint(batch.getValues(sample)[i]);
+		}
+
+		if (destinations[i].history == nullptr)
+			continue;
+
+		for (size_t sample = 0; sample < batch.size(); sample++)
+		{
+			double value = batch.getValues(sample)[i];
+			if (codec != nullptr)
+			{
+				uint32_t word = static_cast<uint32_t>(value);
+				uint8_t bytes[sizeof(word)];
+				std::memcpy(bytes, &word, sizeof(word));
+				codec->decode(bytes, 1, &value);
+			}
+			destinations[i].history->append(value);
+		}
+	}
+
+	for (auto timeBuffer : timeBuffers)
+	{
+		for (size_t sample = 0; sample < batch.size(); sample++)
+			timeBuffer->addPoint(batch.getTimestamp(sample));
+	}
+
+	for (auto timeHistory : timeHistories)
+	{
+		for (size_t sample = 0; sample < batch.size(); sample++)
+			timeHistory->append(batch.getTimestamp(sample));
+	}
+}
+
+const std::vector<std::string>& AcquisitionPlan::getCsvHeader() const
+{
+	return csvHeader;
+}
+
+void AcquisitionPlan::fillCsvLine(std::vector<double>& line) const
+{
+	line.resize(csvColumns.size());
+	for (size_t i = 0; i < csvColumns.size(); i++)
+		line[i] = csvColumns[i] != nullptr ? csvColumns[i]->getValue() : 0.0;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CompressedHistory.hpp"
+#include "PlotGroupHandler.hpp"
+#include "PlotHandler.hpp"
+#include "SampleBatch.hpp"
+#include "ScrollingBuffer.hpp"
+#include "Variable.hpp"
+#include "VariableHandler.hpp"
+
+/// @brief Flat description of the work done for every sample of the active group. It is compiled once
+/// on acquisition start so that the per-sample path walks contiguous arrays only - no hashing, no string
+/// keys and no shared_ptr copies.
+class AcquisitionPlan
+{
+   public:
+	using SampleListType = std::vector<std::pair<uint32_t, uint8_t>>;
+
+	/* raw value of a slot feeds the variable */
+	struct Binding
+	{
+		uint32_t slot;
+		Variable* var;
+	};
+
+	/* variable value is appended to the buffer and to its history if kept, a packed buffer receives
+	the raw value and only the history gets it decoded */
+	struct Destination
+	{
+		ScrollingBuffer<double>* buffer;
+		CompressedHistory* history;
+		Variable* var;
+		const PackedCodec<double>* codec;
+	};
+
+	/// @brief builds sample slots, variable bindings and series destinations for the active group
+	/// @param activeGroup group whose visible plots and series should be sampled
+	/// @param plotHandler all plots - these with a sampled series receive a point per sample to keep the series aligned with time
+	/// @param variableHandler all variables - these sharing an address with a slot are updated from it
+	void compile(PlotGroup& activeGroup, PlotHandler& plotHandler, VariableHandler& variableHandler);
+	void clear();
+
+	/// @brief (address, size) pairs in slot order - the order in which raw values are expected
+	SampleListType& getSampleList();
+	size_t getSlotCount() const;
+
+	/// @brief propagates slot-ordered raw values to bound variables and converts them to doubles
+	void updateVariables(const uint32_t* rawValues);
+
+	/// @brief number of values staged per sample
+	size_t getDestinationCount() const;
+
+	/// @brief stores current variable values of all destinations in the batch, raw values for the packed ones
+	void stage(SampleBatch& batch, double timestamp) const;
+
+	/// @brief appends all staged samples to the destinations and time buffers, has to be called under the plots mutex
+	void publish(const SampleBatch& batch);
+
+	const std::vector<std::string>& getCsvHeader() const;
+	void fillCsvLine(std::vector<double>& line) const;
+
+   private:
+	void addSlot(uint32_t address, uint8_t size);
+
+   private:
+	SampleListType sampleList;
+	std::vector<Binding> bindings;
+	std::vector<Destination> destinations;
+	std::vector<ScrollingBuffer<double>*> timeBuffers;
+	std::vector<CompressedHistory*> timeHistories;
+	std::vector<Variable*> csvColumns;
+	std::vector<std::string> csvHeader;
+};
@@ -5,6 +5,7 @@
 #include <thread>
 
 #include "CSVStreamer.hpp"
+#include "LockStatistics.hpp"
 #include "PlotGroupHandler.hpp"
 #include "PlotHandler.hpp"
 #include "VariableHandler.hpp"
@@ -42,6 +43,12 @@ class DataHandlerBase
 		return viewerState;
 	}
 
+	/* wait and hold times of the plots mutex taken to publish sample batches */
+	LockStatistics::Summary getPublishLockStatistics() const
+	{
+		return publishLockStatistics.getSummary();
+	}
+
    protected:
 	PlotGroupHandler* plotGroupHandler;
 	VariableHandler* variableHandler;
@@ -55,4 +62,5 @@ class DataHandlerBase
 	spdlog::logger* logger;
 
 	std::unique_ptr<CSVStreamer> csvStreamer;
+	LockStatistics publishLockStatistics;
 };
\ No newline at end of file
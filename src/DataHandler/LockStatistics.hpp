@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+/// @brief Wait (time to acquire) and hold times of a mutex, updated by a single thread and readable from any.
+class LockStatistics
+{
+   public:
+	struct Summary
+	{
+		uint64_t count = 0;
+		double averageWait = 0.0;
+		double maxWait = 0.0;
+		double averageHold = 0.0;
+		double maxHold = 0.0;
+	};
+
+	void reset()
+	{
+		count = 0;
+		totalWaitNs = 0;
+		maxWaitNs = 0;
+		totalHoldNs = 0;
+		maxHoldNs = 0;
+	}
+
+	void add(std::chrono::nanoseconds wait, std::chrono::nanoseconds hold)
+	{
+		count.fetch_add(1, std::memory_order_relaxed);
+		totalWaitNs.fetch_add(wait.count(), std::memory_order_relaxed);
+		totalHoldNs.fetch_add(hold.count(), std::memory_order_relaxed);
+		if (wait.count() > maxWaitNs.load(std::memory_order_relaxed))
+			maxWaitNs.store(wait.count(), std::memory_order_relaxed);
+		if (hold.count() > maxHoldNs.load(std::memory_order_relaxed))
+			maxHoldNs.store(hold.count(), std::memory_order_relaxed);
+	}
+
+	/* times in seconds */
+	Summary getSummary() const
+	{
+		Summary summary{};
+		summary.count = count.load(std::memory_order_relaxed);
+		if (summary.count == 0)
+			return summary;
+
+		summary.averageWait = totalWaitNs.load(std::memory_order_relaxed) / 1e9 / summary.count;
+		summary.maxWait = maxWaitNs.load(std::memory_order_relaxed) / 1e9;
+		summary.averageHold = totalHoldNs.load(std::memory_order_relaxed) / 1e9 / summary.count;
+		summary.maxHold = maxHoldNs.load(std::memory_order_relaxed) / 1e9;
+		return summary;
+	}
+
+   private:
+	std::atomic<uint64_t> count = 0;
+	std::atomic<int64_t> totalWaitNs = 0;
+	std::atomic<int64_t> maxWaitNs = 0;
+	std::atomic<int64_t> totalHoldNs = 0;
+	std::atomic<int64_t> maxHoldNs = 0;
+};
+
+/// @brief lock_guard that records its wait and hold times into LockStatistics
+class TimedLockGuard
+{
+   public:
+	TimedLockGuard(std::mutex& mutex, LockStatistics& statistics) : mutex(mutex), statistics(statistics)
+	{
+		auto start = std::chrono::steady_clock::now();
+		mutex.lock();
+		acquired = std::chrono::steady_clock::now();
+		wait = acquired - start;
+	}
+
+	~TimedLockGuard()
+	{
+		auto hold = std::chrono::steady_clock::now() - acquired;
+		mutex.unlock();
+		statistics.add(std::chrono::duration_cast<std::chrono::nanoseconds>(wait), std::chrono::duration_cast<std::chrono::nanoseconds>(hold));
+	}
+
+	TimedLockGuard(const TimedLockGuard&) = delete;
+	TimedLockGuard& operator=(const TimedLockGuard&) = delete;
+
+   private:
+	std::mutex& mutex;
+	LockStatistics& statistics;
+	std::chrono::steady_clock::time_point acquired;
+	std::chrono::steady_clock::duration wait;
+};
@@ -0,0 +1,61 @@
+#include "SampleBatch.hpp"
+
+SampleBatch::SampleBatch(size_t maxSamples, Clock::duration maxAge) : maxSamples(maxSamples), maxAge(maxAge)
+{
+	timestamps.reserve(maxSamples);
+}
+
+void SampleBatch::setWidth(size_t newWidth)
+{
+	width = newWidth;
+	clear();
+	values.reserve(width * maxSamples);
+}
+
+size_t SampleBatch::getWidth() const
+{
+	return width;
+}
+
+double* SampleBatch::stage(double timestamp)
+{
+	if (timestamps.empty())
+		oldestStaged = Clock::now();
+
+	timestamps.push_back(timestamp);
+	values.resize(values.size() + width);
+	return values.data() + values.size() - width;
+}
+
+bool SampleBatch::isDue() const
+{
+	if (timestamps.empty())
+		return false;
+	return timestamps.size() >= maxSamples || Clock::now() - oldestStaged >= maxAge;
+}
+
+void SampleBatch::clear()
+{
+	timestamps.clear();
+	values.clear();
+}
+
+size_t SampleBatch::size() const
+{
+	return timestamps.size();
+}
+
+bool SampleBatch::empty() const
+{
+	return timestamps.empty();
+}
+
+double SampleBatch::getTimestamp(size_t sample) const
+{
+	return timestamps[sample];
+}
+
+const double* SampleBatch::getValues(size_t sample) const
+{
+	return values.data() + sample * width;
+}
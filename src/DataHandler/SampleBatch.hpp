@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+/// @brief Accumulates converted samples (a timestamp and a fixed number of values each) so that they can be
+/// published to the plots in a single critical section. The batch is due once it holds maxSamples samples or
+/// its oldest sample is older than maxAge.
+class SampleBatch
+{
+   public:
+	using Clock = std::chrono::steady_clock;
+
+	SampleBatch(size_t maxSamples, Clock::duration maxAge);
+
+	/// @brief sets the number of values per sample, drops the staged samples
+	void setWidth(size_t newWidth);
+	size_t getWidth() const;
+
+	/// @brief appends a sample and returns its values to be filled by the caller
+	double* stage(double timestamp);
+
+	bool isDue() const;
+	void clear();
+
+	size_t size() const;
+	bool empty() const;
+
+	double getTimestamp(size_t sample) const;
+	const double* getValues(size_t sample) const;
+
+   private:
+	size_t width = 0;
+	size_t maxSamples;
+	Clock::duration maxAge;
+	Clock::time_point oldestStaged{};
+
+	std::vector<double> timestamps;
+	std::vector<double> values;
+};
@@ -0,0 +1,73 @@
+#include "SamplingScheduler.hpp"
+
+#include <algorithm>
+#include <thread>
+
+void SamplingScheduler::start(double frequencyHz, OverrunPolicy policy)
+{
+	period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / frequencyHz));
+	period = std::max(period, Clock::duration(1));
+	overrunPolicy = policy;
+	deadline = Clock::now();
+
+	for (auto& bin : histogram)
+		bin = 0;
+	maxLatenessNs = 0;
+	skipped = 0;
+}
+
+bool SamplingScheduler::isSampleDue()
+{
+	auto now = Clock::now();
+	auto remaining = deadline - now;
+
+	if (remaining > spinThreshold)
+	{
+		std::this_thread::sleep_for(std::min(remaining - spinThreshold, maxSleep));
+		return false;
+	}
+
+	while (now < deadline)
+		now = Clock::now();
+
+	recordLateness(now - deadline);
+	deadline += period;
+
+	if (overrunPolicy == OverrunPolicy::SKIP && deadline <= now)
+	{
+		auto missed = (now - deadline) / period + 1;
+		deadline += missed * period;
+		skipped += missed;
+	}
+	return true;
+}
+
+void SamplingScheduler::recordLateness(Clock::duration lateness)
+{
+	auto latenessNs = std::chrono::duration_cast<std::chrono::nanoseconds>(lateness).count();
+	auto latenessUs = static_cast<uint64_t>(latenessNs / 1000);
+
+	size_t bin = std::upper_bound(latenessBinEdgesUs.begin(), latenessBinEdgesUs.end(), latenessUs) - latenessBinEdgesUs.begin();
+	histogram[bin]++;
+
+	if (latenessNs > maxLatenessNs)
+		maxLatenessNs = latenessNs;
+}
+
+std::array<uint64_t, SamplingScheduler::histogramBins> SamplingScheduler::getLatenessHistogram() const
+{
+	std::array<uint64_t, histogramBins> result{};
+	for (size_t i = 0; i < histogramBins; i++)
+		result[i] = histogram[i];
+	return result;
+}
+
+double SamplingScheduler::getMaxLateness() const
+{
+	return maxLatenessNs / 1e9;
+}
+
+uint64_t SamplingScheduler::getSkippedCount() const
+{
+	return skipped;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/// @brief Paces NORMAL mode sampling against absolute deadlines. The thread sleeps until shortly before
+/// the deadline and spins only for the remaining part, so the sampling grid does not drift when a single
+/// read overruns. Lateness of every sample is collected into a histogram.
+class SamplingScheduler
+{
+   public:
+	using Clock = std::chrono::steady_clock;
+
+	enum class OverrunPolicy : uint8_t
+	{
+		CATCH_UP = 0, /* missed deadlines are sampled back-to-back until the grid is reached again */
+		SKIP = 1,	  /* missed deadlines are dropped, the next sample is taken on the next grid point */
+	};
+
+	static constexpr size_t histogramBins = 8;
+	/* upper bin edges in microseconds, the last bin collects everything above */
+	static constexpr std::array<uint32_t, histogramBins - 1> latenessBinEdgesUs{10, 50, 100, 500, 1000, 5000, 10000};
+	static constexpr const char* histogramLabels[histogramBins] = {"<10us", "<50us", "<100us", "<500us", "<1ms", "<5ms", "<10ms", ">=10ms"};
+
+	/// @brief resets the statistics and places the first deadline at now
+	void start(double frequencyHz, OverrunPolicy policy);
+
+	/// @brief checks whether the next sample is due. If it is not, the call sleeps for at most maxSleep
+	/// so that the caller can react to other events in the meantime.
+	/// @return true when a sample should be taken now
+	bool isSampleDue();
+
+	std::array<uint64_t, histogramBins> getLatenessHistogram() const;
+	double getMaxLateness() const;
+	uint64_t getSkippedCount() const;
+
+   private:
+	void recordLateness(Clock::duration lateness);
+
+   private:
+	static constexpr Clock::duration spinThreshold = std::chrono::microseconds(1000);
+	static constexpr Clock::duration maxSleep = std::chrono::milliseconds(10);
+
+	Clock::duration period{};
+	Clock::time_point deadline{};
+	OverrunPolicy overrunPolicy = OverrunPolicy::CATCH_UP;
+
+	std::array<std::atomic<uint64_t>, histogramBins> histogram{};
+	std::atomic<int64_t> maxLatenessNs = 0;
+	std::atomic<uint64_t> skipped = 0;
+};
@@ -4,6 +4,7 @@
 #include <memory>
 #include <string>
 
+#include "RecordingTraceProbe.hpp"
 #include "TraceReader.hpp"
 
 TraceDataHandler::TraceDataHandler(PlotGroupHandler* plotGroupHandler, VariableHandler* variableHandler, PlotHandler* plotHandler, PlotHandler* tracePlotHandler, std::atomic<bool>& done, std::mutex* mtx, spdlog::logger* logger) : DataHandlerBase(plotGroupHandler, variableHandler, plotHandler, tracePlotHandler, done, mtx, logger)
@@ -36,6 +37,17 @@ std::vector<double> TraceDataHandler::getDelayed3Timestamps()
 	return delayed3Frames.getVector();
 }
 
+double TraceDataHandler::getLatestTimestamp() const
+{
+	return latestTimestamp;
+}
+
+std::shared_ptr<Plot> TraceDataHandler::getChannelPlot(uint32_t channel) const
+{
+	std::string name = "CH" + std::to_string(channel);
+	return tracePlotHandler->checkIfPlotExists(name) ? tracePlotHandler->getPlot(name) : nullptr;
+}
+
 std::string TraceDataHandler::getLastReaderError() const
 {
 	auto traceReaderMsg = traceReader->getLastErrorMsg();
@@ -54,6 +66,7 @@ int32_t TraceDataHandler::getTriggerChannel() const
 
 void TraceDataHandler::setDebugProbe(std::shared_ptr<ITraceProbe> probe)
 {
+	traceProbe = probe;
 	traceReader->changeDevice(probe);
 }
 
@@ -78,7 +91,10 @@ void TraceDataHandler::setSettings(const Settings& settings)
 	traceReader->setTraceFrequency(settings.tracePrescaler);
 	traceReader->setTraceShouldReset(settings.shouldReset);
 	traceReader->setTraceTimeout(settings.timeout);
-	tracePlotHandler->setMaxPoints(settings.maxPoints);
+	{
+		std::lock_guard<std::mutex> lock(*mtx);
+		tracePlotHandler->setMaxPoints(settings.maxPoints);
+	}
 	this->settings = settings;
 }
 
@@ -115,9 +131,6 @@ double TraceDataHandler::getDoubleValue(const Plot& plot, uint32_t value)
 
 void TraceDataHandler::dataHandler()
 {
-	uint32_t cnt = 0;
-	double time = 0.0;
-
 	while (!done)
 	{
 		if (viewerState == State::RUN)
@@ -129,57 +142,54 @@ void TraceDataHandler::dataHandler()
 				stateChangeOrdered = true;
 			}
 
-			double timestamp;
-			std::array<uint32_t, channels> traces{};
-			if (!traceReader->readTrace(timestamp, traces))
+			TraceReader::TraceEvent event;
+			if (!traceReader->readTrace(event, publishBatchMaxAge))
+			{
+				if (publishBatch.isDue())
+					publishTraces();
 				continue;
+			}
 
-			time += timestamp;
+			const double time = event.timestamp;
+			latestTimestamp = time;
 
-			double oldestTimestamp = (*tracePlotHandler->begin()).get()->getXAxisSeries()->getOldestValue();
 			auto indicators = traceReader->getTraceIndicators();
-
 			errorFrames.handle(time, oldestTimestamp, indicators.errorFramesTotal);
 			delayed3Frames.handle(time, oldestTimestamp, indicators.delayedTimestamp3);
 
-			uint32_t i = 0;
-			for (auto plot : *tracePlotHandler)
+			Channel* channel = event.channel < channels ? &channelMap[event.channel] : nullptr;
+			if (channel != nullptr && channel->plot != nullptr && channel->lastValue != event.value)
 			{
-				if (!plot->getVisibility())
-				{
-					i++;
-					continue;
-				}
+				channel->lastValue = event.value;
 
-				Plot::Series* ser = plot->getSeriesMap().begin()->second.get();
-				double newPoint = getDoubleValue(*plot, traces[i]);
+				double newPoint = getDoubleValue(*channel->plot, event.value);
+				double* values = publishBatch.stage(time);
+				values[0] = event.channel;
+				values[1] = newPoint;
 
-				if (traceTriggered == false && i == static_cast<uint32_t>(settings.triggerChannel) && newPoint > settings.triggerLevel)
+				if (traceTriggered == false && event.channel == settings.triggerChannel && newPoint > settings.triggerLevel)
 				{
 					logger->info("Trigger!");
 					traceTriggered = true;
-					timestamp = 0;
-					cnt = 0;
+					for (auto& triggered : channelMap)
+						triggered.pointsSinceTrigger = 0;
 				}
 
-				csvEntry[ser->var->getName()] = newPoint;
+				csvEntry[channel->series->var->getName()] = newPoint;
+				if (settings.shouldLog)
+					csvStreamer->writeLine(time, csvEntry);
 
-				/* thread-safe part */
-				std::lock_guard<std::mutex> lock(*mtx);
-				plot->addPoint(ser->var->getName(), newPoint);
-				plot->addTimePoint(time);
-				i++;
+				/* the busiest channel decides, the trigger point then stays at the start of its buffer */
+				if (traceTriggered && channel->pointsSinceTrigger++ >= (settings.maxPoints * 0.9))
+				{
+					logger->info("After-trigger trace collcted. Stopping.");
+					viewerState = State::STOP;
+					stateChangeOrdered = true;
+				}
 			}
 
-			if (settings.shouldLog)
-				csvStreamer->writeLine(time, csvEntry);
-
-			if (traceTriggered && cnt++ >= (settings.maxPoints * 0.9))
-			{
-				logger->info("After-trigger trace collcted. Stopping.");
-				viewerState = State::STOP;
-				stateChangeOrdered = true;
-			}
+			if (publishBatch.isDue())
+				publishTraces();
 
 			if (errorFrames.size() > maxAllowedViewportErrors)
 			{
@@ -206,9 +216,17 @@ void TraceDataHandler::dataHandler()
 			{
 				std::array<bool, 32> activeChannels{};
 
-				size_t i = 0;
-				for (auto plot : *tracePlotHandler)
-					activeChannels[i++] = plot->getVisibility();
+				/* only the enabled ports are mapped, the events of the others are dropped without any storage */
+				for (uint32_t i = 0; i < channels; i++)
+				{
+					auto plot = getChannelPlot(i);
+					activeChannels[i] = plot != nullptr && plot->getVisibility();
+					channelMap[i] = Channel{};
+					if (activeChannels[i])
+						channelMap[i] = Channel{plot.get(), plot->getSeriesMap().begin()->second.get()};
+				}
+				latestTimestamp = 0.0;
+				oldestTimestamp = 0.0;
 
 				errorFrames.reset();
 				delayed3Frames.reset();
@@ -216,14 +234,26 @@ void TraceDataHandler::dataHandler()
 
 				prepareCSVFile();
 
-				if (traceReader->startAcqusition(probeSettings, activeChannels))
-					time = 0;
-				else
+				publishBatch.setWidth(2);
+				publishLockStatistics.reset();
+
+				if (settings.shouldRecordCapture && traceProbe)
+					traceReader->changeDevice(std::make_shared<RecordingTraceProbe>(traceProbe, settings.captureFilePath, logger));
+
+				if (!traceReader->startAcqusition(probeSettings, activeChannels))
 					viewerState = State::STOP;
 			}
 			else
 			{
 				traceReader->stopAcqusition();
+				/* drops the recorder, if there was one */
+				if (traceProbe)
+					traceReader->changeDevice(traceProbe);
+				publishTraces();
+
+				auto lockStatistics = publishLockStatistics.getSummary();
+				logger->info("Published in {} batches, lock wait avg {:.1f} us max {:.1f} us, hold avg {:.1f} us max {:.1f} us", lockStatistics.count, lockStatistics.averageWait * 1e6, lockStatistics.maxWait * 1e6, lockStatistics.averageHold * 1e6, lockStatistics.maxHold * 1e6);
+
 				if (settings.shouldLog)
 					csvStreamer->finishLogging();
 				traceTriggered = false;
@@ -234,6 +264,45 @@ void TraceDataHandler::dataHandler()
 	logger->info("Exiting trace plot handler thread");
 }
 
+void TraceDataHandler::publishTraces()
+{
+	if (publishBatch.empty())
+		return;
+
+	/* thread-safe part */
+	TimedLockGuard lock(*mtx, publishLockStatistics);
+
+	for (size_t sample = 0; sample < publishBatch.size(); sample++)
+	{
+		const double* values = publishBatch.getValues(sample);
+		const double timestamp = publishBatch.getTimestamp(sample);
+		Channel& channel = channelMap[static_cast<size_t>(values[0])];
+		if (!channel.plot->getVisibility())
+			continue;
+
+		channel.series->buffer->addPoint(values[1]);
+		channel.series->var->setValue(values[1]);
+		channel.plot->addTimePoint(timestamp);
+
+		CompressedHistory* timeHistory = channel.plot->getTimeHistory();
+		if (timeHistory != nullptr && channel.series->history != nullptr)
+		{
+			channel.series->history->append(values[1]);
+			timeHistory->append(timestamp);
+		}
+	}
+	publishBatch.clear();
+
+	/* the error markers older than every stored change are dropped */
+	oldestTimestamp = latestTimestamp;
+	for (auto& channel : channelMap)
+	{
+		auto time = channel.plot != nullptr ? channel.plot->getXAxisSeries() : nullptr;
+		if (time != nullptr && time->getSize() > 0)
+			oldestTimestamp = std::min(oldestTimestamp, time->getOldestValue());
+	}
+}
+
 void TraceDataHandler::prepareCSVFile()
 {
 	if (!settings.shouldLog)
@@ -241,12 +310,10 @@ void TraceDataHandler::prepareCSVFile()
 
 	std::vector<std::string> headerNames;
 
-	size_t i = 0;
-	for (auto plot : *tracePlotHandler)
+	for (uint32_t i = 0; i < channels; i++)
 	{
-		if (plot->getVisibility())
-			headerNames.push_back(std::string("CH") + std::to_string(i));
-		i++;
+		if (channelMap[i].plot != nullptr)
+			headerNames.push_back(channelMap[i].plot->getName());
 	}
 
 	csvStreamer->prepareFile(settings.logFilePath);
@@ -263,11 +330,12 @@ void TraceDataHandler::initPlots()
 		auto plot = tracePlotHandler->addPlot(name);
 
 		auto newVar = std::make_shared<Variable>(name);
-		newVar->setColor(colors[i]);
+		newVar->setColor(colors[i % (sizeof(colors) / sizeof(colors[0]))]);
 		traceVars[name] = newVar;
 
 		plot->addSeries(newVar.get());
 		plot->setDomain(Plot::Domain::DIGITAL);
 		plot->setAlias("CH" + std::to_string(i));
+		plot->setVisibility(i < defaultVisibleChannels);
 	}
 }
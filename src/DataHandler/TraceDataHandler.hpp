@@ -1,13 +1,17 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <deque>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
 #include "DataHandlerBase.hpp"
 #include "Plot.hpp"
+#include "SampleBatch.hpp"
 #include "StlinkTraceProbe.hpp"
 #include "TraceReader.hpp"
 #include "spdlog/spdlog.h"
@@ -27,6 +31,10 @@ class TraceDataHandler : public DataHandlerBase
 		uint32_t timeout = 2;
 		bool shouldLog = false;
 		std::string logFilePath = "";
+		bool keepCompressedHistory = false;
+		std::string historyDirectory = "";
+		bool shouldRecordCapture = false;
+		std::string captureFilePath = "";
 	} Settings;
 
 	TraceDataHandler(PlotGroupHandler* plotGroupHandler, VariableHandler* variableHandler, PlotHandler* plotHandler, PlotHandler* tracePlotHandler, std::atomic<bool>& done, std::mutex* mtx, spdlog::logger* logger);
@@ -37,6 +45,14 @@ class TraceDataHandler : public DataHandlerBase
 	std::vector<double> getDelayed3Timestamps();
 	std::string getLastReaderError() const;
 
+	/// @brief time of the newest decoded event, the channels hold their last value until then
+	double getLatestTimestamp() const;
+
+	/// @brief plot of an ITM port, the plots are named after their port so their order in the plot handler
+	/// is not the port order
+	/// @return nullptr when there is no plot for the port
+	std::shared_ptr<Plot> getChannelPlot(uint32_t channel) const;
+
 	void setTriggerChannel(int32_t triggerChannel);
 	int32_t getTriggerChannel() const;
 
@@ -54,6 +70,7 @@ class TraceDataHandler : public DataHandlerBase
 
    private:
 	void dataHandler();
+	void publishTraces();
 	void prepareCSVFile();
 
    private:
@@ -100,10 +117,33 @@ class TraceDataHandler : public DataHandlerBase
 	std::string lastErrorMsg{};
 
 	ITraceProbe::TraceProbeSettings probeSettings;
+	/* the selected probe, wrapped in a RecordingTraceProbe for the acquisitions that are recorded */
+	std::shared_ptr<ITraceProbe> traceProbe;
 
 	bool traceTriggered = false;
-	static constexpr uint32_t channels = 10;
+	static constexpr uint32_t channels = TraceReader::channels;
+	/* ports shown when there is no configuration yet */
+	static constexpr uint32_t defaultVisibleChannels = 10;
 	static constexpr size_t maxAllowedViewportErrors = 100;
 
 	std::unordered_map<std::string, double> csvEntry;
+
+	/* each channel is stored as its own series of changes, an event repeating the last value is dropped */
+	struct Channel
+	{
+		Plot* plot = nullptr;
+		Plot::Series* series = nullptr;
+		std::optional<uint32_t> lastValue;
+		uint32_t pointsSinceTrigger = 0;
+	};
+
+	/* set up at the acquisition start, the hidden channels have no plot */
+	std::array<Channel, channels> channelMap{};
+	std::atomic<double> latestTimestamp{0.0};
+	double oldestTimestamp = 0.0;
+
+	/* one sample per stored change - the channel number and the value */
+	static constexpr size_t publishBatchMaxSamples = 1000;
+	static constexpr std::chrono::milliseconds publishBatchMaxAge{1};
+	SampleBatch publishBatch{publishBatchMaxSamples, publishBatchMaxAge};
 };
@@ -6,16 +6,20 @@
 #include <string>
 
 #include "JlinkDebugProbe.hpp"
+#include "RecordingDebugProbe.hpp"
 #include "StlinkDebugProbe.hpp"
 
 ViewerDataHandler::ViewerDataHandler(PlotGroupHandler* plotGroupHandler, VariableHandler* variableHandler, PlotHandler* plotHandler, PlotHandler* tracePlotHandler, std::atomic<bool>& done, std::mutex* mtx, spdlog::logger* logger) : DataHandlerBase(plotGroupHandler, variableHandler, plotHandler, tracePlotHandler, done, mtx, logger)
 {
 	dataHandle = std::thread(&ViewerDataHandler::dataHandler, this);
+	processingHandle = std::thread(&ViewerDataHandler::processingHandler, this);
 }
 ViewerDataHandler::~ViewerDataHandler()
 {
 	if (dataHandle.joinable())
 		dataHandle.join();
+	if (processingHandle.joinable())
+		processingHandle.join();
 }
 
 bool ViewerDataHandler::writeSeriesValue(Variable& var, double value)
@@ -53,42 +57,32 @@ ViewerDataHandler::Settings ViewerDataHandler::getSettings() const
 void ViewerDataHandler::setSettings(const Settings& newSettings)
 {
 	settings = newSettings;
+
+	/* resizing drops the buffers, the publisher must not be in the middle of a batch */
+	std::lock_guard<std::mutex> lock(*mtx);
 	plotHandler->setMaxPoints(settings.maxPoints);
 }
 
-void ViewerDataHandler::updateVariables(double timestamp, const std::unordered_map<uint32_t, double>& values)
+void ViewerDataHandler::updateVariables(double timestamp, const uint32_t* rawValues)
 {
-	/* get raw values and put them into variables based on addresses */
-	for (std::shared_ptr<Variable> var : *variableHandler)
-	{
-		uint32_t address = var->getAddress();
-		if (values.contains(address))
-			var->setRawValue(values.at(address));
-	}
+	acquisitionPlan.updateVariables(rawValues);
 
-	for (std::shared_ptr<Variable> var : *variableHandler)
-	{
-		uint32_t address = var->getAddress();
-		if (values.contains(address))
-			csvEntry[var->getName()] = var->transformToDouble();
-	}
+	if (publishBatch.getWidth() != acquisitionPlan.getDestinationCount())
+		publishBatch.setWidth(acquisitionPlan.getDestinationCount());
 
-	for (auto plot : *plotHandler)
-	{
-		std::lock_guard<std::mutex> lock(*mtx);
-		/* thread-safe part */
-		plot->updateSeries();
-		plot->addTimePoint(timestamp);
-	}
+	acquisitionPlan.stage(publishBatch, timestamp);
+	hasUnpublishedSamples = true;
 
 	if (settings.shouldLog)
-		csvStreamer->writeLine(timestamp, csvEntry);
+	{
+		acquisitionPlan.fillCsvLine(csvLine);
+		csvStreamer->writeLine(timestamp, csvLine);
+	}
 }
 
 void ViewerDataHandler::dataHandler()
 {
 	std::chrono::time_point<std::chrono::steady_clock> start;
-	uint32_t timer = 0;
 	double lastT = 0.0;
 
 	while (!done)
@@ -99,44 +93,51 @@ void ViewerDataHandler::dataHandler()
 
 			if (probeSettings.mode == IDebugProbe::Mode::HSS)
 			{
-				if (!debugProbe->isValid())
+				if (!acquisitionProbe->isValid())
 					setState(State::STOP);
 
-				auto maybeEntry = debugProbe->readSingleEntry();
+				auto maybeEntry = acquisitionProbe->readSingleEntry();
 
 				if (!maybeEntry.has_value())
 					continue;
 
-				auto [timestamp, rawValues] = maybeEntry.value();
+				auto& [timestamp, rawValues] = maybeEntry.value();
 
-				updateVariables(timestamp, rawValues);
+				if (rawValues.size() != acquisitionPlan.getSlotCount())
+					continue;
+
+				auto* frame = frameQueue.claim();
+				if (frame != nullptr)
+				{
+					frame->timestamp = timestamp;
+					std::copy(rawValues.begin(), rawValues.end(), frame->values.begin());
+					frameQueue.publish();
+				}
 
 				/* filter sampling frequency */
 				averageSamplingPeriod = samplingPeriodFilter.filter((period - lastT));
 				lastT = period;
-				timer++;
 			}
 
-			else if (period > ((1.0 / settings.sampleFrequencyHz) * timer))
+			else if (scheduler.isSampleDue())
 			{
-				std::unordered_map<uint32_t, double> rawValues;
+				/* one batch of coalesced block reads per sample */
+				if (!acquisitionProbe->readMemoryBatch(readRequests))
+					setState(State::STOP);
 
-				/* sample by address */
-				for (auto& [address, size] : sampleList)
+				double timestamp = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
+
+				auto* frame = frameQueue.claim();
+				if (frame != nullptr)
 				{
-					uint32_t value = 0;
-					if (debugProbe->readMemory(address, (uint8_t*)&value, size))
-						rawValues[address] = value;
-					else
-						setState(State::STOP);
+					frame->timestamp = timestamp;
+					readPlanner.scatter(frame->values.data());
+					frameQueue.publish();
 				}
-				double timestamp = std::chrono::duration_cast<std::chrono::duration<double>>(std::chrono::steady_clock::now() - start).count();
-				updateVariables(timestamp, rawValues);
 
 				/* filter sampling frequency */
 				averageSamplingPeriod = samplingPeriodFilter.filter((period - lastT));
 				lastT = period;
-				timer++;
 			}
 		}
 		else
@@ -146,21 +147,45 @@ void ViewerDataHandler::dataHandler()
 		{
 			if (viewerState == State::RUN)
 			{
-				createSampleList();
+				acquisitionPlan.compile(*plotGroupHandler->getActiveGroup(), *plotHandler, *variableHandler);
+				readPlanner.plan(acquisitionPlan.getSampleList(), {settings.readMaxGap, settings.readMaxBlockSize});
+				readRequests.clear();
+				for (auto& block : readPlanner.getBlocks())
+					readRequests.push_back({block.address, block.size, readPlanner.getBuffer() + block.bufferOffset});
+
+				logger->info("Sampling {} variables in {} memory blocks", acquisitionPlan.getSlotCount(), readPlanner.getBlocks().size());
 				prepareCSVFile();
 
-				if (debugProbe->startAcqusition(probeSettings, sampleList, settings.sampleFrequencyHz))
+				/* the queue is drained on stop so the processing thread does not touch any frame now */
+				frameQueue.forEachSlot([&](RawFrame& frame)
+									   { frame.values.assign(acquisitionPlan.getSlotCount(), 0); });
+				frameQueue.resetStatistics();
+				publishLockStatistics.reset();
+
+				acquisitionProbe = debugProbe;
+				if (settings.shouldRecordCapture)
+					acquisitionProbe = std::make_shared<RecordingDebugProbe>(debugProbe, settings.captureFilePath, logger);
+
+				if (acquisitionProbe->startAcqusition(probeSettings, acquisitionPlan.getSampleList(), settings.sampleFrequencyHz))
 				{
-					timer = 0;
 					lastT = 0.0;
 					start = std::chrono::steady_clock::now();
+					scheduler.start(settings.sampleFrequencyHz, settings.overrunPolicy);
 				}
 				else
 					viewerState = State::STOP;
 			}
 			else
 			{
-				debugProbe->stopAcqusition();
+				acquisitionProbe->stopAcqusition();
+
+				/* let the processing thread publish the remaining frames before the log is closed */
+				while ((frameQueue.size() > 0 || hasUnpublishedSamples) && !done)
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+				auto lockStatistics = publishLockStatistics.getSummary();
+				logger->info("Published in {} batches, lock wait avg {:.1f} us max {:.1f} us, hold avg {:.1f} us max {:.1f} us", lockStatistics.count, lockStatistics.averageWait * 1e6, lockStatistics.maxWait * 1e6, lockStatistics.averageHold * 1e6, lockStatistics.maxHold * 1e6);
+
 				if (settings.shouldLog)
 					csvStreamer->finishLogging();
 			}
@@ -169,63 +194,30 @@ void ViewerDataHandler::dataHandler()
 	}
 }
 
-void ViewerDataHandler::createSampleList()
+void ViewerDataHandler::processingHandler()
 {
-	sampleList.clear();
-
-	auto checkIfElementExists = [&](std::pair<uint32_t, uint8_t> newElement)
-	{
-		return std::find_if(sampleList.begin(), sampleList.end(), [&newElement](const std::pair<uint32_t, uint8_t>& element)
-							{ return element == newElement; }) != sampleList.end();
-	};
-
-	for (auto& [name, plotElem] : *plotGroupHandler->getActiveGroup())
+	while (!done)
 	{
-		auto plot = plotElem.plot;
-
-		if (!plotElem.visibility)
-			continue;
+		auto* frame = frameQueue.front();
+		/* sleeps until the probe thread publishes a frame, waking up in time to publish a due batch */
+		if (frame == nullptr && frameQueue.waitForData(std::chrono::microseconds(500)))
+			frame = frameQueue.front();
 
-		for (auto& [name, ser] : plot->getSeriesMap())
+		if (frame != nullptr)
 		{
-			if (!ser->visible)
-				continue;
-
-			std::pair<uint32_t, uint8_t> newElement = {ser->var->getAddress(), ser->var->getSize()};
-
-			if (!checkIfElementExists(newElement))
-				sampleList.push_back(newElement);
-
-			Variable* maybeXAxisVariable = plot->getXAxisVariable();
-			if (plot->getType() == Plot::Type::XY && maybeXAxisVariable != nullptr)
-			{
-				newElement = {maybeXAxisVariable->getAddress(), maybeXAxisVariable->getSize()};
-				if (!checkIfElementExists(newElement))
-					sampleList.push_back(newElement);
-			}
+			updateVariables(frame->timestamp, frame->values.data());
+			frameQueue.pop();
 		}
-	}
 
-	/* additionally scan for eventual bases of fractional variables that should be sampled */
-	for (auto variable : *variableHandler)
-	{
-		if (variable->getFractional().baseVariable != nullptr)
+		if (publishBatch.isDue())
 		{
-			auto var = variable->getFractional().baseVariable;
-			std::pair<uint32_t, uint8_t> newElement = {var->getAddress(), var->getSize()};
-
-			if (!checkIfElementExists(newElement))
-				sampleList.push_back(newElement);
+			/* thread-safe part */
+			TimedLockGuard lock(*mtx, publishLockStatistics);
+			acquisitionPlan.publish(publishBatch);
+			publishBatch.clear();
+			hasUnpublishedSamples = false;
 		}
 	}
-
-	/* mark actively sampled varaibles */
-	for (auto variable : *variableHandler)
-	{
-		variable->setIsCurrentlySampled(false);
-		if (std::find(sampleList.begin(), sampleList.end(), std::pair<uint32_t, uint8_t>(variable->getAddress(), variable->getSize())) != sampleList.end())
-			variable->setIsCurrentlySampled(true);
-	}
 }
 
 void ViewerDataHandler::prepareCSVFile()
@@ -233,18 +225,6 @@ void ViewerDataHandler::prepareCSVFile()
 	if (!settings.shouldLog)
 		return;
 
-	std::vector<std::string> headerNames;
-
-	for (auto& [name, plotElem] : *plotGroupHandler->getActiveGroup())
-	{
-		auto plot = plotElem.plot;
-
-		if (!plotElem.visibility)
-			continue;
-
-		for (auto& [name, ser] : plot->getSeriesMap())
-			headerNames.push_back(name);
-	}
 	csvStreamer->prepareFile(settings.logFilePath);
-	csvStreamer->createHeader(headerNames);
+	csvStreamer->createHeader(acquisitionPlan.getCsvHeader());
 }
\ No newline at end of file
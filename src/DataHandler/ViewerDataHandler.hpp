@@ -7,9 +7,14 @@
 #include <string>
 #include <thread>
 
+#include "AcquisitionPlan.hpp"
 #include "DataHandlerBase.hpp"
 #include "IDebugProbe.hpp"
+#include "MemoryReadPlanner.hpp"
 #include "MovingAverage.hpp"
+#include "SampleBatch.hpp"
+#include "SamplingScheduler.hpp"
+#include "SpscRingBuffer.hpp"
 #include "VariableHandler.hpp"
 
 class ViewerDataHandler : public DataHandlerBase
@@ -28,6 +33,14 @@ class ViewerDataHandler : public DataHandlerBase
 		bool shouldLog = false;
 		std::string logFilePath = "";
 		std::string gdbCommand = "gdb";
+		uint32_t readMaxGap = MemoryReadPlanner::Settings{}.maxGap;
+		uint32_t readMaxBlockSize = MemoryReadPlanner::Settings{}.maxBlockSize;
+		SamplingScheduler::OverrunPolicy overrunPolicy = SamplingScheduler::OverrunPolicy::CATCH_UP;
+		bool keepCompressedHistory = false;
+		std::string historyDirectory = "";
+		bool storeRawSamples = false;
+		bool shouldRecordCapture = false;
+		std::string captureFilePath = "";
 	} Settings;
 
 	ViewerDataHandler(PlotGroupHandler* plotGroupHandler, VariableHandler* variableHandler, PlotHandler* plotHandler, PlotHandler* tracePlotHandler, std::atomic<bool>& done, std::mutex* mtx, spdlog::logger* logger);
@@ -51,22 +64,61 @@ class ViewerDataHandler : public DataHandlerBase
 		return 0.0;
 	}
 
-   private:
-	using SampleListType = std::vector<std::pair<uint32_t, uint8_t>>;
+	const SamplingScheduler& getSamplingScheduler() const
+	{
+		return scheduler;
+	}
+
+	size_t getFrameQueueDepth() const
+	{
+		return frameQueue.size();
+	}
+
+	size_t getFrameQueueMaxDepth() const
+	{
+		return frameQueue.getMaxDepth();
+	}
+
+	uint64_t getFrameQueueOverflowCount() const
+	{
+		return frameQueue.getOverflowCount();
+	}
 
-	void updateVariables(double timestamp, const std::unordered_map<uint32_t, double>& values);
+   private:
+	void updateVariables(double timestamp, const uint32_t* rawValues);
+	/* probe I/O thread - reads and timestamps raw frames */
 	void dataHandler();
+	/* processing thread - converts frames, updates plots and logs */
+	void processingHandler();
 	void prepareCSVFile();
-	void createSampleList();
 
    private:
+	struct RawFrame
+	{
+		double timestamp = 0.0;
+		std::vector<uint32_t> values;
+	};
+
 	static constexpr size_t maxVariablesOnSinglePlot = 100;
+	static constexpr size_t frameQueueCapacity = 4096;
+	static constexpr size_t publishBatchMaxSamples = 1000;
+	static constexpr std::chrono::milliseconds publishBatchMaxAge{1};
 	std::shared_ptr<IDebugProbe> debugProbe;
+	/* debugProbe or its recording decorator for the running acquisition */
+	std::shared_ptr<IDebugProbe> acquisitionProbe;
 	IDebugProbe::DebugProbeSettings probeSettings{};
 	MovingAverage samplingPeriodFilter{1000};
 	double averageSamplingPeriod = 0.0;
 	Settings settings{};
-	std::unordered_map<std::string, double> csvEntry;
+	std::vector<double> csvLine;
+
+	AcquisitionPlan acquisitionPlan;
+	MemoryReadPlanner readPlanner;
+	std::vector<IDebugProbe::ReadRequest> readRequests;
+	SamplingScheduler scheduler;
 
-	SampleListType sampleList;
+	SpscRingBuffer<RawFrame> frameQueue{frameQueueCapacity, true};
+	SampleBatch publishBatch{publishBatchMaxSamples, publishBatchMaxAge};
+	std::atomic<bool> hasUnpublishedSamples = false;
+	std::thread processingHandle;
 };
\ No newline at end of file
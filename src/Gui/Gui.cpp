@@ -24,7 +24,7 @@ Gui::Gui(PlotHandler* plotHandler, VariableHandler* variableHandler, ConfigHandl
 {
 	threadHandle = std::thread(&Gui::mainThread, this, projectPath);
 	plotEditWindow = std::make_shared<PlotEditWindow>(plotHandler, plotGroupHandler, variableHandler);
-	plotsTree = std::make_shared<PlotsTree>(viewerDataHandler, plotHandler, plotGroupHandler, variableHandler, plotEditWindow, fileHandler, logger);
+	plotsTree = std::make_shared<PlotsTree>(viewerDataHandler, plotHandler, plotGroupHandler, variableHandler, plotEditWindow, fileHandler, mtx, logger);
 	variableTable = std::make_shared<VariableTableWindow>(viewerDataHandler, plotHandler, variableHandler, &projectElfPath, &projectConfigPath, logger);
 
 	variableHandler->renameCallback = [&](std::string oldName, std::string newName)
@@ -98,11 +98,16 @@ void Gui::mainThread(std::string externalPath)
 
 	jlinkProbe = std::make_shared<JlinkDebugProbe>(logger);
 	stlinkProbe = std::make_shared<StlinkDebugProbe>(logger);
+	simulatedProbe = std::make_shared<SimulatedDebugProbe>(logger);
+	replayProbe = std::make_shared<ReplayDebugProbe>(logger);
+	processProbe = std::make_shared<ProcessDebugProbe>(logger);
+	gdbServerProbe = std::make_shared<GdbServerDebugProbe>(logger);
 	debugProbeDevice = stlinkProbe;
 	viewerDataHandler->setDebugProbe(debugProbeDevice);
 
 	jlinkTraceProbe = std::make_shared<JlinkTraceProbe>(logger);
 	stlinkTraceProbe = std::make_shared<StlinkTraceProbe>(logger);
+	fileTraceProbe = std::make_shared<FileTraceProbe>(logger);
 	traceProbeDevice = stlinkTraceProbe;
 	traceDataHandler->setDebugProbe(traceProbeDevice);
 
@@ -256,8 +261,10 @@ void Gui::drawMenu()
 
 	if (activeView == ActiveViewType::VarViewer)
 	{
-		ImGui::SetCursorPosX((ImGui::GetWindowSize().x - 210 * GuiHelper::contentScale));
+		ImGui::SetCursorPosX((ImGui::GetWindowSize().x - 280 * GuiHelper::contentScale));
 		GuiHelper::drawDescriptionWithNumber("sampling: ", viewerDataHandler->getAverageSamplingFrequency(), " Hz", 2);
+		ImGui::SameLine();
+		drawSamplingLateness();
 	}
 
 	ImGui::EndMainMenuBar();
@@ -265,6 +272,76 @@ void Gui::drawMenu()
 	askShouldSaveOnNew(shouldSaveOnNew);
 }
 
+void Gui::drawSamplingLateness()
+{
+	auto& scheduler = viewerDataHandler->getSamplingScheduler();
+	auto histogram = scheduler.getLatenessHistogram();
+
+	ImGui::TextDisabled("(lateness)");
+	if (!ImGui::IsItemHovered())
+		return;
+
+	std::array<float, SamplingScheduler::histogramBins> bins{};
+	std::copy(histogram.begin(), histogram.end(), bins.begin());
+
+	ImGui::BeginTooltip();
+	ImGui::Text("Sample lateness against the deadline (NORMAL mode)");
+	ImGui::PlotHistogram("##lateness", bins.data(), bins.size(), 0, NULL, 0.0f, FLT_MAX, ImVec2(300 * GuiHelper::contentScale, 80 * GuiHelper::contentScale));
+	for (size_t i = 0; i < histogram.size(); i++)
+		ImGui::Text("%-8s %llu", SamplingScheduler::histogramLabels[i], static_cast<unsigned long long>(histogram[i]));
+	GuiHelper::drawDescriptionWithNumber("max: ", scheduler.getMaxLateness() * 1e6, " us", 1);
+	GuiHelper::drawDescriptionWithNumber("skipped: ", scheduler.getSkippedCount(), "", 0);
+	drawPublishLockStatistics(viewerDataHandler->getPublishLockStatistics());
+	ImGui::Separator();
+	GuiHelper::drawDescriptionWithNumber("frame queue depth: ", viewerDataHandler->getFrameQueueDepth(), "", 0);
+	GuiHelper::drawDescriptionWithNumber("frame queue max depth: ", viewerDataHandler->getFrameQueueMaxDepth(), "", 0);
+	GuiHelper::drawDescriptionWithNumber("frame queue overflows: ", viewerDataHandler->getFrameQueueOverflowCount(), "", 0);
+	ImGui::EndTooltip();
+}
+
+void Gui::drawPublishLockStatistics(const LockStatistics::Summary& lockStatistics)
+{
+	GuiHelper::drawDescriptionWithNumber("plot lock batches:      ", lockStatistics.count, "", 0);
+	GuiHelper::drawDescriptionWithNumber("plot lock wait avg/max: ", lockStatistics.averageWait * 1e6, " us", 1);
+	ImGui::SameLine();
+	GuiHelper::drawDescriptionWithNumber("/", lockStatistics.maxWait * 1e6, " us", 1);
+	GuiHelper::drawDescriptionWithNumber("plot lock hold avg/max: ", lockStatistics.averageHold * 1e6, " us", 1);
+	ImGui::SameLine();
+	GuiHelper::drawDescriptionWithNumber("/", lockStatistics.maxHold * 1e6, " us", 1);
+}
+
+std::shared_ptr<IDebugProbe> Gui::getDebugProbe(uint32_t type)
+{
+	switch (type)
+	{
+		case 1:
+			return jlinkProbe;
+		case 2:
+			return simulatedProbe;
+		case 3:
+			return replayProbe;
+		case 4:
+			return processProbe;
+		case 5:
+			return gdbServerProbe;
+		default:
+			return stlinkProbe;
+	}
+}
+
+std::shared_ptr<ITraceProbe> Gui::getTraceProbe(uint32_t type)
+{
+	switch (type)
+	{
+		case 1:
+			return jlinkTraceProbe;
+		case 2:
+			return fileTraceProbe;
+		default:
+			return stlinkTraceProbe;
+	}
+}
+
 void Gui::drawStartButton(DataHandlerBase* activeDataHandler)
 {
 	bool shouldDisableButton = (!devicesList.empty() && devicesList.front() == noDevices);
@@ -301,8 +378,13 @@ void Gui::drawStartButton(DataHandlerBase* activeDataHandler)
 		if (state == DataHandlerBase::State::STOP)
 		{
 			logger->info("Start clicked!");
+			simulatedProbe->setElfFile(projectElfPath);
 			plotHandler->eraseAllPlotData();
+			auto viewerSettings = viewerDataHandler->getSettings();
+			plotHandler->shareColumns(viewerSettings.keepCompressedHistory, viewerSettings.historyDirectory, viewerSettings.storeRawSamples);
 			tracePlotHandler->eraseAllPlotData();
+			auto traceSettings = traceDataHandler->getSettings();
+			tracePlotHandler->createHistories(traceSettings.keepCompressedHistory, traceSettings.historyDirectory, true);
 			activeDataHandler->setState(DataHandlerBase::State::RUN);
 		}
 		else
@@ -459,17 +541,11 @@ bool Gui::openProject(std::string externalPath)
 		logger->info("Project config path: {}", projectConfigPath);
 		/* TODO refactor */
 		devicesList.clear();
-		if (viewerDataHandler->getProbeSettings().debugProbe == 1)
-			debugProbeDevice = jlinkProbe;
-		else
-			debugProbeDevice = stlinkProbe;
+		debugProbeDevice = getDebugProbe(viewerDataHandler->getProbeSettings().debugProbe);
 
 		viewerDataHandler->setDebugProbe(debugProbeDevice);
 
-		if (traceDataHandler->getProbeSettings().debugProbe == 1)
-			traceProbeDevice = jlinkTraceProbe;
-		else
-			traceProbeDevice = stlinkTraceProbe;
+		traceProbeDevice = getTraceProbe(traceDataHandler->getProbeSettings().debugProbe);
 
 		traceDataHandler->setDebugProbe(traceProbeDevice);
 
@@ -19,10 +19,15 @@
 #include "IFileHandler.hpp"
 #include "ImguiPlugins.hpp"
 #include "JlinkDebugProbe.hpp"
+#include "FileTraceProbe.hpp"
 #include "JlinkTraceProbe.hpp"
 #include "Plot.hpp"
 #include "PlotGroupHandler.hpp"
 #include "Popup.hpp"
+#include "GdbServerDebugProbe.hpp"
+#include "ProcessDebugProbe.hpp"
+#include "ReplayDebugProbe.hpp"
+#include "SimulatedDebugProbe.hpp"
 #include "TraceDataHandler.hpp"
 #include "VariableHandler.hpp"
 #include "ViewerDataHandler.hpp"
@@ -60,12 +65,17 @@ class Gui
 
 	std::shared_ptr<IDebugProbe> stlinkProbe;
 	std::shared_ptr<IDebugProbe> jlinkProbe;
+	std::shared_ptr<SimulatedDebugProbe> simulatedProbe;
+	std::shared_ptr<IDebugProbe> replayProbe;
+	std::shared_ptr<IDebugProbe> processProbe;
+	std::shared_ptr<IDebugProbe> gdbServerProbe;
 	std::shared_ptr<IDebugProbe> debugProbeDevice;
 	std::vector<std::string> devicesList{};
 	const std::string noDevices = "No debug probes found!";
 
 	std::shared_ptr<ITraceProbe> stlinkTraceProbe;
 	std::shared_ptr<ITraceProbe> jlinkTraceProbe;
+	std::shared_ptr<ITraceProbe> fileTraceProbe;
 	std::shared_ptr<ITraceProbe> traceProbeDevice;
 
 	std::atomic<bool>& done;
@@ -83,6 +93,10 @@ class Gui
 
 	std::mutex* mtx;
 
+	/* decimated points of the series being drawn, reused between frames */
+	std::vector<double> decimatedX;
+	std::vector<double> decimatedY;
+
 	spdlog::logger* logger;
 
 	std::shared_ptr<PlotEditWindow> plotEditWindow;
@@ -92,7 +106,11 @@ class Gui
    private:
 	void mainThread(std::string externalPath);
 	void drawMenu();
+	void drawSamplingLateness();
+	void drawPublishLockStatistics(const LockStatistics::Summary& lockStatistics);
 	void drawStartButton(DataHandlerBase* activeDataHandler);
+	std::shared_ptr<IDebugProbe> getDebugProbe(uint32_t type);
+	std::shared_ptr<ITraceProbe> getTraceProbe(uint32_t type);
 	void drawDebugProbes();
 	void drawTraceProbes();
 	void drawUpdateAddressesFromElf();
@@ -101,7 +119,10 @@ class Gui
 
 	template <typename Settings>
 	void drawLoggingSettings(PlotHandler* handler, Settings& settings);
+	template <typename Settings>
+	void drawHistorySettings(Settings& settings);
 	void drawGdbSettings(ViewerDataHandler::Settings& settings);
+	void drawTraceCaptureSettings(TraceDataHandler::Settings& settings);
 
 	void drawAboutWindow();
 	void drawPreferencesWindow();
@@ -131,7 +152,7 @@ class Gui
 	void drawSettingsSwo();
 	void drawIndicatorsSwo();
 	void drawPlotsSwo();
-	void drawPlotCurveSwo(Plot* plot, ScrollingBuffer<double>& time, std::map<std::string, std::shared_ptr<Plot::Series>>& seriesMap, bool first);
+	void drawPlotCurveSwo(Plot* plot, ScrollingBuffer<double>& time, std::map<std::string, std::shared_ptr<Plot::Series>>& seriesMap, bool first, double oldest, double latest);
 	void drawPlotsTreeSwo();
 
 	bool openWebsite(const char* url);
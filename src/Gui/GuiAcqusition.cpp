@@ -33,12 +33,12 @@ void Gui::acqusitionSettingsViewer()
 	settings.sampleFrequencyHz = std::clamp(settings.sampleFrequencyHz, ViewerDataHandler::minSamplinFrequencyHz, ViewerDataHandler::maxSamplinFrequencyHz);
 
 	const uint32_t minPoints = 100;
-	const uint32_t maxPoints = 20000;
+	const uint32_t maxPoints = PlotHandler::maxPointsLimit;
 	GuiHelper::drawTextAlignedToSize("Max points:", alignment);
 	ImGui::SameLine();
 	ImGui::InputScalar("##maxPoints", ImGuiDataType_U32, &settings.maxPoints, NULL, NULL, "%u");
 	ImGui::SameLine();
-	ImGui::HelpMarker("Max points used for a single series after which the oldest points will be overwritten.");
+	ImGui::HelpMarker("Max points used for a single series after which the oldest points will be overwritten. Memory is allocated on start for the sampled series only, changing the value erases the collected data.");
 	settings.maxPoints = std::clamp(settings.maxPoints, minPoints, maxPoints);
 
 	GuiHelper::drawTextAlignedToSize("Max view points:", alignment);
@@ -48,6 +48,37 @@ void Gui::acqusitionSettingsViewer()
 	ImGui::HelpMarker("Max points used for a single series that will be shown in the viewport without scroling.");
 	settings.maxViewportPoints = std::clamp(settings.maxViewportPoints, minPoints, settings.maxPoints);
 
+	GuiHelper::drawTextAlignedToSize("Store raw samples:", alignment);
+	ImGui::SameLine();
+	ImGui::Checkbox("##storeRawSamples", &settings.storeRawSamples);
+	ImGui::SameLine();
+	ImGui::HelpMarker("Store the sampled series in the native width of their variables (1, 2 or 4 bytes instead of 8) and convert them to floating point values only when they are drawn, exported or analyzed. Fractional variables with a base variable are stored as before. Applied on the next start.");
+
+	drawHistorySettings(settings);
+
+	GuiHelper::drawTextAlignedToSize("Read max gap [B]:", alignment);
+	ImGui::SameLine();
+	ImGui::InputScalar("##readMaxGap", ImGuiDataType_U32, &settings.readMaxGap, NULL, NULL, "%u");
+	ImGui::SameLine();
+	ImGui::HelpMarker("Variables closer to each other than this number of bytes are read in a single block (NORMAL mode). Gaps are never bridged in the peripheral memory regions.");
+	settings.readMaxGap = std::clamp(settings.readMaxGap, static_cast<uint32_t>(0), static_cast<uint32_t>(1024));
+
+	GuiHelper::drawTextAlignedToSize("Read max block [B]:", alignment);
+	ImGui::SameLine();
+	ImGui::InputScalar("##readMaxBlockSize", ImGuiDataType_U32, &settings.readMaxBlockSize, NULL, NULL, "%u");
+	ImGui::SameLine();
+	ImGui::HelpMarker("Max size of a single memory block read in NORMAL mode.");
+	settings.readMaxBlockSize = std::clamp(settings.readMaxBlockSize, MemoryReadPlanner::alignment, static_cast<uint32_t>(65536));
+
+	const char* overrunPolicies[] = {"catch up", "skip"};
+	int32_t overrunPolicy = static_cast<int32_t>(settings.overrunPolicy);
+	GuiHelper::drawTextAlignedToSize("On overrun:", alignment);
+	ImGui::SameLine();
+	if (ImGui::Combo("##overrunPolicy", &overrunPolicy, overrunPolicies, IM_ARRAYSIZE(overrunPolicies)))
+		settings.overrunPolicy = static_cast<SamplingScheduler::OverrunPolicy>(overrunPolicy);
+	ImGui::SameLine();
+	ImGui::HelpMarker("What to do when a sample misses its deadline (NORMAL mode). Catch up takes the missed samples back-to-back, skip drops them and waits for the next deadline.");
+
 	drawDebugProbes();
 	drawLoggingSettings(plotHandler, settings);
 	drawGdbSettings(settings);
@@ -70,7 +101,7 @@ void Gui::drawDebugProbes()
 	GuiHelper::drawTextAlignedToSize("Debug probe:", alignment);
 	ImGui::SameLine();
 
-	const char* debugProbes[] = {"STLINK", "JLINK"};
+	const char* debugProbes[] = {"STLINK", "JLINK", "SIMULATED", "REPLAY", "PROCESS", "GDB SERVER"};
 	IDebugProbe::DebugProbeSettings probeSettings = viewerDataHandler->getProbeSettings();
 	int32_t debugProbe = probeSettings.debugProbe;
 
@@ -79,16 +110,8 @@ void Gui::drawDebugProbes()
 		probeSettings.debugProbe = debugProbe;
 		modified = true;
 
-		if (probeSettings.debugProbe == 1)
-		{
-			debugProbeDevice = jlinkProbe;
-			shouldListDevices = true;
-		}
-		else
-		{
-			debugProbeDevice = stlinkProbe;
-			shouldListDevices = true;
-		}
+		debugProbeDevice = getDebugProbe(probeSettings.debugProbe);
+		shouldListDevices = true;
 		SNptr = 0;
 	}
 	GuiHelper::drawTextAlignedToSize("Debug probe S/N:", alignment);
@@ -113,6 +136,12 @@ void Gui::drawDebugProbes()
 		shouldListDevices = false;
 	}
 
+	if (probeSettings.debugProbe == 4)
+	{
+		ImGui::SameLine();
+		ImGui::HelpMarker("Select the local process to sample in the S/N list. The *.elf file has to be the executable of the process (software-in-the-loop build), addresses are relocated automatically. Linux only.");
+	}
+
 	GuiHelper::drawTextAlignedToSize("SWD speed [kHz]:", alignment);
 	ImGui::SameLine();
 
@@ -133,7 +162,57 @@ void Gui::drawDebugProbes()
 			probeSettings.device = debugProbeDevice->getTargetName();
 			modified = true;
 		}
+	}
+
+	if (probeSettings.debugProbe == 2)
+	{
+		GuiHelper::drawTextAlignedToSize("Generators:", alignment);
+		ImGui::SameLine();
+		if (ImGui::InputText("##generators", &probeSettings.simulationGenerators, 0, NULL, NULL))
+			modified = true;
+		ImGui::SameLine();
+		ImGui::HelpMarker("Signal generators driving the simulated memory, separated by ';'. Each one is \"<address> <sine|ramp|counter|noise|step> [amplitude] [period_s] [offset] [u8|i8|u16|i16|u32|i32|f32]\", e.g. \"0x20000000 sine 10 0.5; 0x20000004 counter 1 0.001 u32\". The remaining memory is initialized from the .data section of the *.elf file.");
+
+		GuiHelper::drawTextAlignedToSize("USB latency [us]:", alignment);
+		ImGui::SameLine();
+		if (ImGui::InputScalar("##latency", ImGuiDataType_U32, &probeSettings.simulationLatencyUs, NULL, NULL, "%u"))
+			modified = true;
+
+		GuiHelper::drawTextAlignedToSize("USB bandwidth [kB/s]:", alignment);
+		ImGui::SameLine();
+		if (ImGui::InputScalar("##bandwidth", ImGuiDataType_U32, &probeSettings.simulationBandwidthKBps, NULL, NULL, "%u"))
+			modified = true;
+	}
+
+	if (probeSettings.debugProbe == 5)
+	{
+		GuiHelper::drawTextAlignedToSize("Server address:", alignment);
+		ImGui::SameLine();
+		if (ImGui::InputText("##gdbServer", &probeSettings.gdbServerAddress, 0, NULL, NULL))
+			modified = true;
+		ImGui::SameLine();
+		ImGui::HelpMarker("<host>:<port> of a gdbserver (OpenOCD, pyOCD, QEMU...). The target is not halted nor resumed - the server has to allow memory access while the target runs, e.g. OpenOCD with \"$_TARGETNAME configure -event gdb-attach {}\".");
+	}
+
+	if (probeSettings.debugProbe == 3)
+	{
+		GuiHelper::drawTextAlignedToSize("Capture file:", alignment);
+		ImGui::SameLine();
+		if (ImGui::InputText("##replayFile", &probeSettings.replayFilePath, 0, NULL, NULL))
+			modified = true;
+		ImGui::SameLine();
+		ImGui::HelpMarker("Probe capture recorded with the \"Record probe capture\" option. The mode has to match the recorded one.");
+
+		GuiHelper::drawTextAlignedToSize("Real time:", alignment);
+		ImGui::SameLine();
+		if (ImGui::Checkbox("##replayRealTime", &probeSettings.replayRealTime))
+			modified = true;
+		ImGui::SameLine();
+		ImGui::HelpMarker("Replay at the recorded pace. When unchecked the capture is replayed as fast as possible.");
+	}
 
+	if (probeSettings.debugProbe == 1 || probeSettings.debugProbe == 2 || probeSettings.debugProbe == 3)
+	{
 		GuiHelper::drawTextAlignedToSize("Mode:", alignment);
 		ImGui::SameLine();
 
@@ -191,6 +270,33 @@ void Gui::drawLoggingSettings(PlotHandler* handler, Settings& settings)
 	ImGui::PopID();
 }
 
+template <typename Settings>
+void Gui::drawHistorySettings(Settings& settings)
+{
+	ImGui::PushID("history");
+	GuiHelper::drawTextAlignedToSize("Compressed history:", alignment);
+	ImGui::SameLine();
+	ImGui::Checkbox("##compressedHistory", &settings.keepCompressedHistory);
+	ImGui::SameLine();
+	ImGui::HelpMarker("Keep the complete history of the sampled series compressed, in addition to the max points buffers. Older parts are moved to memory-mapped files in the history directory, so long recordings do not fill the RAM. Once stopped, the plots can be zoomed and panned over the whole history. Applied on the next start.");
+
+	ImGui::BeginDisabled(!settings.keepCompressedHistory);
+	GuiHelper::drawTextAlignedToSize("History directory:", alignment);
+	ImGui::SameLine();
+	ImGui::InputText("##historyDirectory", &settings.historyDirectory, 0, NULL, NULL);
+	ImGui::SameLine();
+	if (ImGui::Button("...", ImVec2(35 * GuiHelper::contentScale, 19 * GuiHelper::contentScale)))
+	{
+		std::string path = fileHandler->openDirectory({"", ""});
+		if (path != "")
+			settings.historyDirectory = path;
+	}
+	ImGui::SameLine();
+	ImGui::HelpMarker("A session directory is created here on each start and removed when its data is erased. The system temporary directory is used when empty.");
+	ImGui::EndDisabled();
+	ImGui::PopID();
+}
+
 void Gui::drawGdbSettings(ViewerDataHandler::Settings& settings)
 {
 	ImGui::PushID("advanced");
@@ -201,6 +307,39 @@ void Gui::drawGdbSettings(ViewerDataHandler::Settings& settings)
 	GuiHelper::drawTextAlignedToSize("GDB command:", alignment);
 	ImGui::SameLine();
 	ImGui::InputText("##gdb", &settings.gdbCommand, 0, NULL, NULL);
+
+	GuiHelper::drawTextAlignedToSize("Record probe capture:", alignment);
+	ImGui::SameLine();
+	ImGui::Checkbox("##recordCapture", &settings.shouldRecordCapture);
+	ImGui::SameLine();
+	ImGui::HelpMarker("Record all data read from the debug probe to a binary capture file that can be replayed later with the REPLAY probe. The file is overwritten on each start.");
+
+	ImGui::BeginDisabled(!settings.shouldRecordCapture);
+	GuiHelper::drawTextAlignedToSize("Capture file:", alignment);
+	ImGui::SameLine();
+	ImGui::InputText("##captureFile", &settings.captureFilePath, 0, NULL, NULL);
+	ImGui::EndDisabled();
+	ImGui::PopID();
+}
+
+void Gui::drawTraceCaptureSettings(TraceDataHandler::Settings& settings)
+{
+	ImGui::PushID("advanced");
+	ImGui::Dummy(ImVec2(-1, 5));
+	GuiHelper::drawCenteredText("Advanced");
+	ImGui::Separator();
+
+	GuiHelper::drawTextAlignedToSize("Record SWO capture:", alignment);
+	ImGui::SameLine();
+	ImGui::Checkbox("##recordCapture", &settings.shouldRecordCapture);
+	ImGui::SameLine();
+	ImGui::HelpMarker("Record the raw SWO stream to a capture file that can be decoded again later with the FILE probe. The file is overwritten on each start.");
+
+	ImGui::BeginDisabled(!settings.shouldRecordCapture);
+	GuiHelper::drawTextAlignedToSize("Capture file:", alignment);
+	ImGui::SameLine();
+	ImGui::InputText("##captureFile", &settings.captureFilePath, 0, NULL, NULL);
+	ImGui::EndDisabled();
 	ImGui::PopID();
 }
 
@@ -217,7 +356,7 @@ void Gui::acqusitionSettingsTrace()
 	ImGui::InputScalar("##maxPoints", ImGuiDataType_U32, &settings.maxPoints, NULL, NULL, "%u");
 	ImGui::SameLine();
 	ImGui::HelpMarker("Max points used for a single series after which the oldest points will be overwritten.");
-	settings.maxPoints = std::clamp(settings.maxPoints, static_cast<uint32_t>(100), static_cast<uint32_t>(20000));
+	settings.maxPoints = std::clamp(settings.maxPoints, static_cast<uint32_t>(100), PlotHandler::maxPointsLimit);
 
 	GuiHelper::drawTextAlignedToSize("Viewport width [%%]:", alignment);
 	ImGui::SameLine();
@@ -233,8 +372,11 @@ void Gui::acqusitionSettingsTrace()
 	ImGui::HelpMarker("Timeout is the period after which trace will be stopped due to no trace data being received.");
 	settings.timeout = std::clamp(settings.timeout, static_cast<uint32_t>(1), static_cast<uint32_t>(999999));
 
+	drawHistorySettings(settings);
+
 	drawTraceProbes();
 	drawLoggingSettings(tracePlotHandler, settings);
+	drawTraceCaptureSettings(settings);
 	traceDataHandler->setSettings(settings);
 }
 
@@ -254,7 +396,7 @@ void Gui::drawTraceProbes()
 	GuiHelper::drawTextAlignedToSize("Debug probe:", alignment);
 	ImGui::SameLine();
 
-	const char* debugProbes[] = {"STLINK", "JLINK"};
+	const char* debugProbes[] = {"STLINK", "JLINK", "FILE"};
 	ITraceProbe::TraceProbeSettings probeSettings = traceDataHandler->getProbeSettings();
 	int32_t debugProbe = probeSettings.debugProbe;
 
@@ -263,16 +405,8 @@ void Gui::drawTraceProbes()
 		probeSettings.debugProbe = debugProbe;
 		modified = true;
 
-		if (probeSettings.debugProbe == 1)
-		{
-			traceProbeDevice = jlinkTraceProbe;
-			shouldListDevices = true;
-		}
-		else
-		{
-			traceProbeDevice = stlinkTraceProbe;
-			shouldListDevices = true;
-		}
+		traceProbeDevice = getTraceProbe(probeSettings.debugProbe);
+		shouldListDevices = true;
 		SNptr = 0;
 	}
 	GuiHelper::drawTextAlignedToSize("Debug probe S/N:", alignment);
@@ -319,6 +453,23 @@ void Gui::drawTraceProbes()
 		}
 	}
 
+	if (probeSettings.debugProbe == 2)
+	{
+		GuiHelper::drawTextAlignedToSize("Capture file:", alignment);
+		ImGui::SameLine();
+		if (ImGui::InputText("##replayFile", &probeSettings.replayFilePath, 0, NULL, NULL))
+			modified = true;
+		ImGui::SameLine();
+		ImGui::HelpMarker("SWO capture recorded with the \"Record SWO capture\" option. The raw bytes are decoded again with the current core frequency and channel settings.");
+
+		GuiHelper::drawTextAlignedToSize("Real time:", alignment);
+		ImGui::SameLine();
+		if (ImGui::Checkbox("##replayRealTime", &probeSettings.replayRealTime))
+			modified = true;
+		ImGui::SameLine();
+		ImGui::HelpMarker("Replay at the recorded pace. When unchecked the capture is decoded as fast as possible.");
+	}
+
 	if (devicesList.empty())
 		devicesList.push_back(noDevices);
 
@@ -92,7 +92,7 @@ void Gui::drawPlotXY(std::shared_ptr<Plot> plot)
 		plot->setIsHovered(ImPlot::IsPlotHovered());
 		dragAndDropPlot(plot);
 
-		/* make thread safe copies of buffers - TODO refactor */
+		/* the lock keeps the time and series snapshots at the same sample, the copies are incremental */
 		mtx->lock();
 		time.copyData();
 		for (auto& [key, serPtr] : seriesMap)
@@ -101,8 +101,8 @@ void Gui::drawPlotXY(std::shared_ptr<Plot> plot)
 				continue;
 			serPtr->buffer->copyData();
 		}
-		uint32_t offset = time.getOffset();
-		uint32_t size = time.getSize();
+		uint32_t offset = time.getCopyOffset();
+		uint32_t size = time.getCopySize();
 		mtx->unlock();
 
 		for (auto& [key, serPtr] : seriesMap)
@@ -161,7 +161,7 @@ void Gui::drawPlotCurve(std::shared_ptr<Plot> plot)
 			handleDragRect(0, plot->stats, plotLimits);
 		}
 
-		/* make thread safe copies of buffers - TODO refactor */
+		/* the lock keeps the time and series snapshots at the same sample, the copies are incremental */
 		mtx->lock();
 		time.copyData();
 		for (auto& [key, serPtr] : seriesMap)
@@ -169,23 +169,34 @@ void Gui::drawPlotCurve(std::shared_ptr<Plot> plot)
 			if (!serPtr->visible)
 				continue;
 			serPtr->buffer->copyData();
+			serPtr->lod.update(*serPtr->buffer);
 		}
-		uint32_t offset = time.getOffset();
-		uint32_t size = time.getSize();
 		mtx->unlock();
 
+		/* about two points per pixel of the visible range are drawn, whatever the number of points */
+		ImPlotRect visibleLimits = ImPlot::GetPlotLimits();
+		uint32_t maxBuckets = static_cast<uint32_t>(ImPlot::GetPlotSize().x);
+
+		/* once stopped, the compressed history is drawn when the view reaches past the oldest buffered point */
+		CompressedHistory* timeHistory = plot->getTimeHistory();
+		bool drawHistory = timeHistory != nullptr && viewerDataHandler->getState() == DataHandlerBase::State::STOP && time.getSize() > 0 && visibleLimits.X.Min < time.getOldestValue();
+
 		for (auto& [key, serPtr] : seriesMap)
 		{
 			if (!serPtr->visible)
 				continue;
 
 			const double timepoint = plot->markerX0.getValue();
-			const double value = *(serPtr->buffer->getFirstElementCopy() + time.getIndexFromvalue(timepoint));
+			const double value = serPtr->buffer->getCopyValue(time.getCopyIndexAt(timepoint));
 			auto name = plot->markerX0.getState() ? key + " = " + std::to_string(value) : key;
 
 			ImPlot::SetNextLineStyle(ImVec4(serPtr->var->getColor().r, serPtr->var->getColor().g, serPtr->var->getColor().b, 1.0f));
 			ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle, 2.0f);
-			ImPlot::PlotLine(name.c_str(), time.getFirstElementCopy(), serPtr->buffer->getFirstElementCopy(), size, ImPlotLineFlags_None, offset, sizeof(double));
+			if (drawHistory && serPtr->history != nullptr)
+				CompressedHistory::decimate(*timeHistory, *serPtr->history, visibleLimits.X.Min, visibleLimits.X.Max, maxBuckets, decimatedX, decimatedY);
+			else
+				serPtr->lod.decimate(time, *serPtr->buffer, visibleLimits.X.Min, visibleLimits.X.Max, maxBuckets, decimatedX, decimatedY);
+			ImPlot::PlotLine(name.c_str(), decimatedX.data(), decimatedY.data(), decimatedX.size(), ImPlotLineFlags_None);
 
 			if (plot->markerX0.getState())
 			{
@@ -194,6 +205,29 @@ void Gui::drawPlotCurve(std::shared_ptr<Plot> plot)
 			}
 		}
 
+		/* frozen overlays are dimmed and decimated again only when the view changes */
+		for (auto& overlay : plot->getOverlays())
+		{
+			for (auto& [key, frozen] : overlay.seriesMap)
+			{
+				auto ser = seriesMap.find(key);
+				if (ser == seriesMap.end() || !ser->second->visible)
+					continue;
+
+				if (frozen.xMin != visibleLimits.X.Min || frozen.xMax != visibleLimits.X.Max || frozen.maxBuckets != maxBuckets)
+				{
+					ScrollingBuffer<double>::Frozen::decimate(overlay.time, frozen.values, visibleLimits.X.Min, visibleLimits.X.Max, maxBuckets, frozen.xs, frozen.ys);
+					frozen.xMin = visibleLimits.X.Min;
+					frozen.xMax = visibleLimits.X.Max;
+					frozen.maxBuckets = maxBuckets;
+				}
+
+				auto name = key + " (" + overlay.name + ")";
+				ImPlot::SetNextLineStyle(ImVec4(ser->second->var->getColor().r, ser->second->var->getColor().g, ser->second->var->getColor().b, 0.4f));
+				ImPlot::PlotLine(name.c_str(), frozen.xs.data(), frozen.ys.data(), frozen.xs.size(), ImPlotLineFlags_None);
+			}
+		}
+
 		ImPlot::EndPlot();
 	}
 }
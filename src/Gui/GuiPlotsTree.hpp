@@ -1,5 +1,7 @@
 #pragma once
 
+#include <fstream>
+#include <mutex>
 #include <optional>
 #include <string>
 
@@ -15,7 +17,7 @@
 class PlotsTree
 {
    public:
-	PlotsTree(ViewerDataHandler* viewerDataHandler, PlotHandler* plotHandler, PlotGroupHandler* plotGroupHandler, VariableHandler* variableHandler, std::shared_ptr<PlotEditWindow> plotEditWindow, IFileHandler* fileHandler, spdlog::logger* logger) : viewerDataHandler(viewerDataHandler), plotHandler(plotHandler), plotGroupHandler(plotGroupHandler), variableHandler(variableHandler), plotEditWindow(plotEditWindow), fileHandler(fileHandler), logger(logger)
+	PlotsTree(ViewerDataHandler* viewerDataHandler, PlotHandler* plotHandler, PlotGroupHandler* plotGroupHandler, VariableHandler* variableHandler, std::shared_ptr<PlotEditWindow> plotEditWindow, IFileHandler* fileHandler, std::mutex* mtx, spdlog::logger* logger) : viewerDataHandler(viewerDataHandler), plotHandler(plotHandler), plotGroupHandler(plotGroupHandler), variableHandler(variableHandler), plotEditWindow(plotEditWindow), fileHandler(fileHandler), mtx(mtx), logger(logger)
 	{
 		groupEditWindow = std::make_unique<GroupEditWindow>(plotGroupHandler);
 	}
@@ -208,6 +210,7 @@ class PlotsTree
 			}
 			ImGui::EndDragDropTarget();
 		}
+		drawFreezeButtons(plt);
 		drawExportPlotToCSVButton(plt);
 		ImGui::PopID();
 		ImGui::EndGroup();
@@ -248,6 +251,41 @@ class PlotsTree
 		groupEditWindow->setShowGroupEditWindowState(true);
 	}
 
+	/* frozen overlays share the chunks of the buffers, freezing is cheap enough to be done while running */
+	void drawFreezeButtons(std::shared_ptr<Plot> plt)
+	{
+		ImGui::BeginDisabled(plt->getType() != Plot::Type::CURVE);
+		float width = (ImGui::GetContentRegionAvail().x - ImGui::GetStyle().ItemSpacing.x) / 2.0f;
+		if (ImGui::Button("Freeze plot", ImVec2(width, 25 * GuiHelper::contentScale)))
+		{
+			std::lock_guard<std::mutex> lock(*mtx);
+			plt->freeze("frozen " + std::to_string(++frozenCount));
+		}
+		ImGui::SameLine();
+
+		auto& overlays = plt->getOverlays();
+		ImGui::BeginDisabled(overlays.empty());
+		if (ImGui::Button(("Remove frozen (" + std::to_string(overlays.size()) + ")").c_str(), ImVec2(width, 25 * GuiHelper::contentScale)))
+			ImGui::OpenPopup("removeFrozen");
+		ImGui::EndDisabled();
+		ImGui::EndDisabled();
+
+		if (ImGui::BeginPopup("removeFrozen"))
+		{
+			std::optional<size_t> overlayToRemove;
+			for (size_t i = 0; i < overlays.size(); i++)
+				if (ImGui::MenuItem(overlays[i].name.c_str()))
+					overlayToRemove = i;
+
+			ImGui::Separator();
+			if (ImGui::MenuItem("All"))
+				overlays.clear();
+			else if (overlayToRemove.has_value())
+				plt->removeOverlay(overlayToRemove.value());
+			ImGui::EndPopup();
+		}
+	}
+
 	void drawExportPlotToCSVButton(std::shared_ptr<Plot> plt)
 	{
 		if (ImGui::Button("Export plot to *.csv", ImVec2(-1, 25 * GuiHelper::contentScale)))
@@ -270,14 +308,20 @@ class PlotsTree
 
 			csvFile << std::endl;
 
-			for (size_t i = 0; i < dataSize; ++i)
+			CompressedHistory* timeHistory = plt->getTimeHistory();
+			if (timeHistory != nullptr && plt->getType() == Plot::Type::CURVE && viewerDataHandler->getState() == DataHandlerBase::State::STOP)
 			{
-				uint32_t offset = plt->getXAxisSeries()->getOffset();
-				uint32_t index = (offset + i < dataSize) ? offset + i : i - (dataSize - offset);
-				csvFile << plt->getXAxisSeries()->getFirstElementCopy()[index] << ",";
+				exportHistory(csvFile, plt, *timeHistory);
+				return;
+			}
+
+			/* live buffers are read, the snapshots of hidden series are not kept up to date */
+			for (uint32_t i = 0; i < dataSize; ++i)
+			{
+				csvFile << plt->getXAxisSeries()->getValue(i) << ",";
 
 				for (auto& [name, ser] : plt->getSeriesMap())
-					csvFile << ser->buffer->getFirstElementCopy()[index] << ",";
+					csvFile << ser->buffer->getValue(i) << ",";
 
 				csvFile << std::endl;
 			}
@@ -287,6 +331,36 @@ class PlotsTree
 	}
 
    private:
+	/* the complete history is written block by block, series without a history of the same length are written as zeros */
+	void exportHistory(std::ofstream& csvFile, std::shared_ptr<Plot> plt, const CompressedHistory& timeHistory)
+	{
+		std::vector<double> timeBlock;
+		std::vector<std::vector<double>> seriesBlocks(plt->getSeriesMap().size());
+
+		for (size_t block = 0; block < timeHistory.getBlockCount(); block++)
+		{
+			timeHistory.readBlock(block, timeBlock);
+
+			size_t column = 0;
+			for (auto& [name, ser] : plt->getSeriesMap())
+			{
+				auto& values = seriesBlocks[column++];
+				if (ser->history != nullptr && ser->history->size() == timeHistory.size())
+					ser->history->readBlock(block, values);
+				else
+					values.assign(timeBlock.size(), 0.0);
+			}
+
+			for (size_t i = 0; i < timeBlock.size(); i++)
+			{
+				csvFile << timeBlock[i] << ",";
+				for (auto& values : seriesBlocks)
+					csvFile << values[i] << ",";
+				csvFile << '\n';
+			}
+		}
+	}
+
 	void drawMenuGroupPopup(const std::string& name, std::function<void()> onNewGroup, std::function<void()> onNewPlot, std::function<void(const std::string&)> onDelete, std::function<void(const std::string&)> onProperties)
 	{
 		ImGui::PushID(name.c_str());
@@ -349,5 +423,7 @@ class PlotsTree
 
 	StatisticsWindow statisticsWindow;
 	IFileHandler* fileHandler;
+	std::mutex* mtx;
 	spdlog::logger* logger;
+	uint32_t frozenCount = 0;
 };
\ No newline at end of file
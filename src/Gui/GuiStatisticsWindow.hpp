@@ -36,7 +36,10 @@ class StatisticsWindow
 			plt->stats.setState(selectRange);
 
 			Statistics::AnalogResults results;
-			Statistics::calculateResults(ser.get(), plt->getXAxisSeries(), plt->stats.getValueX0(), plt->stats.getValueX1(), results);
+			if (plt->getTimeHistory() != nullptr && ser->history != nullptr)
+				Statistics::calculateResults(*plt->getTimeHistory(), *ser->history, plt->stats.getValueX0(), plt->stats.getValueX1(), results);
+			else
+				Statistics::calculateResults(ser.get(), plt->getXAxisSeries(), plt->stats.getValueX0(), plt->stats.getValueX1(), results);
 
 			GuiHelper::drawDescriptionWithNumber("t0:      ", plt->stats.getValueX0());
 			GuiHelper::drawDescriptionWithNumber("t1:      ", plt->stats.getValueX1());
@@ -79,7 +82,10 @@ class StatisticsWindow
 			plt->stats.setState(selectRange);
 
 			Statistics::DigitalResults results;
-			Statistics::calculateResults(ser.get(), plt->getXAxisSeries(), plt->stats.getValueX0(), plt->stats.getValueX1(), results);
+			if (plt->getTimeHistory() != nullptr && ser->history != nullptr)
+				Statistics::calculateResults(*plt->getTimeHistory(), *ser->history, plt->stats.getValueX0(), plt->stats.getValueX1(), results);
+			else
+				Statistics::calculateResults(ser.get(), plt->getXAxisSeries(), plt->stats.getValueX0(), plt->stats.getValueX1(), results);
 
 			GuiHelper::drawDescriptionWithNumber("t0:      ", plt->stats.getValueX0());
 			GuiHelper::drawDescriptionWithNumber("t1:      ", plt->stats.getValueX1());
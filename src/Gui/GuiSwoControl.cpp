@@ -25,11 +25,21 @@ void Gui::drawSettingsSwo()
 	GuiHelper::drawInputText("##prescaler", settings.tracePrescaler, [&](std::string str)
 							 { settings.tracePrescaler = std::stoi(str); });
 
-	const char* triggers[] = {"OFF", "CH0", "CH1", "CH2", "CH3", "CH4", "CH5", "CH6", "CH7", "CH8", "CH9"};
+	static std::vector<std::string> triggerNames;
+	static std::vector<const char*> triggers;
+	if (triggers.empty())
+	{
+		triggerNames.push_back("OFF");
+		for (uint32_t i = 0; i < TraceReader::channels; i++)
+			triggerNames.push_back("CH" + std::to_string(i));
+		for (auto& name : triggerNames)
+			triggers.push_back(name.c_str());
+	}
+
 	int32_t trigerCombo = settings.triggerChannel + 1;
 	ImGui::Text("trigger channel        ");
 	ImGui::SameLine();
-	if (ImGui::Combo("##trigger", &trigerCombo, triggers, IM_ARRAYSIZE(triggers)))
+	if (ImGui::Combo("##trigger", &trigerCombo, triggers.data(), static_cast<int32_t>(triggers.size())))
 		settings.triggerChannel = trigerCombo - 1;
 
 	ImGui::Text("trigger level          ");
@@ -72,6 +82,11 @@ void Gui::drawIndicatorsSwo()
 	GuiHelper::drawDescriptionWithNumber("delayed timestamp 2:    ", indicators.delayedTimestamp2, "", 5, 0, {1, 1, 0, 1});
 	GuiHelper::drawDescriptionWithNumber("delayed timestamp 3:    ", indicators.delayedTimestamp3);
 	GuiHelper::drawDescriptionWithNumber("delayed timestamp 3 in view:    ", indicators.delayedTimestamp3InView, "", 5, 0, {1, 0, 0, 1});
+	GuiHelper::drawDescriptionWithNumber("table overflows:        ", indicators.tableOverflows, "", 5, 0, {1, 0, 0, 1});
+	GuiHelper::drawDescriptionWithNumber("table peak depth:       ", indicators.tableMaxDepth);
+	GuiHelper::drawDescriptionWithNumber("raw bytes dropped:      ", indicators.rawBufferOverflows, "", 5, 0, {1, 0, 0, 1});
+	GuiHelper::drawDescriptionWithNumber("raw buffer peak:        ", indicators.rawBufferMaxDepth / 1024, " KiB");
+	drawPublishLockStatistics(traceDataHandler->getPublishLockStatistics());
 }
 
 void Gui::drawPlotsTreeSwo()
@@ -91,14 +106,17 @@ void Gui::drawPlotsTreeSwo()
 	ImGui::BeginChild("left pane", ImVec2(150 * GuiHelper::contentScale, -1), true);
 
 	auto state = traceDataHandler->getState();
-	int32_t iter = 0;
 
-	for (std::shared_ptr<Plot> plt : *tracePlotHandler)
+	for (uint32_t channel = 0; channel < TraceReader::channels; channel++)
 	{
+		std::shared_ptr<Plot> plt = traceDataHandler->getChannelPlot(channel);
+		if (plt == nullptr)
+			continue;
+
 		std::string name = plt->getName();
 		std::string alias = plt->getAlias();
 
-		plt->trigger.setState(traceDataHandler->getSettings().triggerChannel == iter++);
+		plt->trigger.setState(traceDataHandler->getSettings().triggerChannel == static_cast<int32_t>(channel));
 
 		if (state == DataHandlerBase::State::RUN)
 			ImGui::BeginDisabled();
@@ -1,29 +1,51 @@
 #include <implot.h>
 
+#include <algorithm>
+#include <array>
+
 #include "Gui.hpp"
 
 void Gui::drawPlotsSwo()
 {
 	ImVec2 plotSize(-1, -1);
 
-	float rowRatios[] = {1.2f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+	/* the plots are drawn in port order, the first one is taller as it holds the axis labels */
+	std::array<std::shared_ptr<Plot>, TraceReader::channels> visiblePlots{};
+	std::array<float, TraceReader::channels> rowRatios{};
+	size_t visibleCount = 0;
+	for (uint32_t channel = 0; channel < TraceReader::channels; channel++)
+	{
+		std::shared_ptr<Plot> plt = traceDataHandler->getChannelPlot(channel);
+		if (plt != nullptr && plt->getVisibility())
+		{
+			rowRatios[visibleCount] = visibleCount == 0 ? 1.2f : 1.0f;
+			visiblePlots[visibleCount++] = plt;
+		}
+	}
 
-	if (ImPlot::BeginSubplots("##subplos", tracePlotHandler->getVisiblePlotsCount(), 1, plotSize, ImPlotSubplotFlags_LinkAllX, rowRatios))
+	/* the channels store their changes only, the time range spans all of them */
+	const double latest = traceDataHandler->getLatestTimestamp();
+	double oldest = latest;
+	for (size_t i = 0; i < visibleCount; i++)
+	{
+		if (visiblePlots[i]->getXAxisSeries()->getSize() > 0)
+			oldest = std::min(oldest, visiblePlots[i]->getXAxisSeries()->getOldestValue());
+	}
+
+	if (visibleCount > 0 && ImPlot::BeginSubplots("##subplos", static_cast<int>(visibleCount), 1, plotSize, ImPlotSubplotFlags_LinkAllX, rowRatios.data()))
 	{
 		bool first = true;
-		for (std::shared_ptr<Plot> plt : *tracePlotHandler)
+		for (size_t i = 0; i < visibleCount; i++)
 		{
-			if (!plt->getVisibility())
-				continue;
-
-			drawPlotCurveSwo(plt.get(), *plt->getXAxisSeries(), plt->getSeriesMap(), first);
+			std::shared_ptr<Plot> plt = visiblePlots[i];
+			drawPlotCurveSwo(plt.get(), *plt->getXAxisSeries(), plt->getSeriesMap(), first, oldest, latest);
 			first = false;
 		}
 		ImPlot::EndSubplots();
 	}
 }
 
-void Gui::drawPlotCurveSwo(Plot* plot, ScrollingBuffer<double>& time, std::map<std::string, std::shared_ptr<Plot::Series>>& seriesMap, bool first)
+void Gui::drawPlotCurveSwo(Plot* plot, ScrollingBuffer<double>& time, std::map<std::string, std::shared_ptr<Plot::Series>>& seriesMap, bool first, double oldest, double latest)
 {
 	if (ImPlot::BeginPlot(plot->getName().c_str(), ImVec2(), ImPlotFlags_NoChild | ImPlotFlags_NoTitle))
 	{
@@ -35,10 +57,8 @@ void Gui::drawPlotCurveSwo(Plot* plot, ScrollingBuffer<double>& time, std::map<s
 		if (traceDataHandler->getState() == DataHandlerBase::State::RUN)
 		{
 			auto settings = traceDataHandler->getSettings();
-			const double min = time.getOldestValue();
-			const double max = time.getNewestValue();
-			const double viewportWidth = (max - min) * (settings.maxViewportPointsPercent / 100.0);
-			ImPlot::SetupAxisLimits(ImAxis_X1, max - viewportWidth, max, ImPlotCond_Always);
+			const double viewportWidth = (latest - oldest) * (settings.maxViewportPointsPercent / 100.0);
+			ImPlot::SetupAxisLimits(ImAxis_X1, latest - viewportWidth, latest, ImPlotCond_Always);
 		}
 		else
 			ImPlot::SetupAxis(ImAxis_Y1, NULL, ImPlotAxisFlags_NoTickLabels | ImPlotAxisFlags_NoLabel);
@@ -77,21 +97,40 @@ void Gui::drawPlotCurveSwo(Plot* plot, ScrollingBuffer<double>& time, std::map<s
 
 		plot->setIsHovered(ImPlot::IsPlotHovered());
 
-		/* make thread safe copies of buffers - TODO refactor */
+		/* the lock keeps the time and series snapshots at the same sample, the copies are incremental */
 		mtx->lock();
 		time.copyData();
 		if (ser->visible)
+		{
 			ser->buffer->copyData();
-		uint32_t offset = time.getOffset();
-		uint32_t size = time.getSize();
+			ser->lod.update(*ser->buffer);
+		}
 		mtx->unlock();
 
+		/* about two points per pixel of the visible range are drawn, whatever the number of points */
+		ImPlotRect visibleLimits = ImPlot::GetPlotLimits();
+		uint32_t maxBuckets = static_cast<uint32_t>(ImPlot::GetPlotSize().x);
+
+		/* once stopped, the compressed history is drawn when the view reaches past the oldest buffered point */
+		CompressedHistory* timeHistory = plot->getTimeHistory();
+		if (timeHistory != nullptr && ser->history != nullptr && traceDataHandler->getState() == DataHandlerBase::State::STOP && time.getSize() > 0 && visibleLimits.X.Min < time.getOldestValue())
+			CompressedHistory::decimate(*timeHistory, *ser->history, visibleLimits.X.Min, visibleLimits.X.Max, maxBuckets, decimatedX, decimatedY);
+		else
+			ser->lod.decimate(time, *ser->buffer, visibleLimits.X.Min, visibleLimits.X.Max, maxBuckets, decimatedX, decimatedY);
+
+		/* the last change holds until the newest event of any channel */
+		if (!decimatedX.empty() && latest > decimatedX.back())
+		{
+			decimatedX.push_back(latest);
+			decimatedY.push_back(decimatedY.back());
+		}
+
 		const double timepoint = plot->markerX0.getValue();
-		const double value = *(ser->buffer->getFirstElementCopy() + time.getIndexFromvalue(timepoint));
+		const double value = ser->buffer->getCopyValue(time.getCopyIndexAt(timepoint));
 
 		ImPlot::SetNextLineStyle(ImVec4(ser->var->getColor().r, ser->var->getColor().g, ser->var->getColor().b, 1.0f));
 		ImPlot::SetNextFillStyle(ImVec4(ser->var->getColor().r, ser->var->getColor().g, ser->var->getColor().b, 1.0f), 0.25f);
-		ImPlot::PlotStairs(plot->getAlias().c_str(), time.getFirstElementCopy(), ser->buffer->getFirstElementCopy(), size, ImPlotStairsFlags_Shaded, offset, sizeof(double));
+		ImPlot::PlotStairs(plot->getAlias().c_str(), decimatedX.data(), decimatedY.data(), decimatedX.size(), ImPlotStairsFlags_Shaded);
 
 		if (plot->markerX0.getState())
 		{
@@ -0,0 +1,27 @@
+#ifndef _DEBUGPROBECAPTURE_HPP
+#define _DEBUGPROBECAPTURE_HPP
+
+#include <cstdint>
+
+/* Binary capture file written by RecordingDebugProbe and read by ReplayDebugProbe. All values are
+little endian. The file starts with the magic and the version followed by records, each of them
+starting with a type byte and a double time in seconds since the acquisition start:
+
+START  u8 mode, u32 sampling frequency, u32 count, count x (u32 address, u8 size)
+READ   u32 address, u32 size, u8 success, size x u8 data
+ENTRY  f64 timestamp, u32 count, count x u32 raw value
+*/
+namespace DebugProbeCapture
+{
+static constexpr char magic[8] = {'M', 'C', 'U', 'V', 'C', 'A', 'P', '\0'};
+static constexpr uint32_t version = 1;
+
+enum class RecordType : uint8_t
+{
+	START = 1,
+	READ = 2,
+	ENTRY = 3,
+};
+}  // namespace DebugProbeCapture
+
+#endif
@@ -0,0 +1,477 @@
+#include "GdbServerDebugProbe.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <numeric>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef MSG_NOSIGNAL
+constexpr int sendFlags = MSG_NOSIGNAL;
+#else
+constexpr int sendFlags = 0;
+#endif
+
+void closeSocket(GdbServerDebugProbe::SocketType socketHandle)
+{
+#ifdef _WIN32
+	closesocket(socketHandle);
+#else
+	close(socketHandle);
+#endif
+}
+
+std::string toHex(uint32_t value)
+{
+	char buffer[9];
+	std::snprintf(buffer, sizeof(buffer), "%x", value);
+	return std::string(buffer);
+}
+
+int fromHexDigit(char c)
+{
+	if (c >= '0' && c <= '9')
+		return c - '0';
+	if (c >= 'a' && c <= 'f')
+		return c - 'a' + 10;
+	if (c >= 'A' && c <= 'F')
+		return c - 'A' + 10;
+	return -1;
+}
+}  // namespace
+
+GdbServerDebugProbe::GdbServerDebugProbe(spdlog::logger* logger) : logger(logger)
+{
+#ifdef _WIN32
+	WSADATA data;
+	WSAStartup(MAKEWORD(2, 2), &data);
+#endif
+}
+
+GdbServerDebugProbe::~GdbServerDebugProbe()
+{
+	stopAcqusition();
+#ifdef _WIN32
+	WSACleanup();
+#endif
+}
+
+bool GdbServerDebugProbe::startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
+{
+	(void)addressSizeVector;
+	(void)samplingFreqency;
+
+	stopAcqusition();
+
+	std::lock_guard<std::mutex> lock(mtx);
+	lastErrorMsg = "";
+	readPacketCount = 0;
+
+	if (!connectToServer(probeSettings.gdbServerAddress))
+		return false;
+
+	if (!handshake())
+	{
+		disconnect();
+		return false;
+	}
+
+	isRunning = true;
+	logger->info("Connected to gdbserver {}, no-ack mode {}, max read size {} B", serverAddress, noAckMode, maxReadSize);
+	return true;
+}
+
+bool GdbServerDebugProbe::stopAcqusition()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	isRunning = false;
+	disconnect();
+	return true;
+}
+
+bool GdbServerDebugProbe::isValid() const
+{
+	return isRunning;
+}
+
+std::optional<IDebugProbe::varEntryType> GdbServerDebugProbe::readSingleEntry()
+{
+	return std::nullopt;
+}
+
+bool GdbServerDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	std::vector<ReadRequest> requests{{address, size, buf}};
+	return readMemoryBatch(requests);
+}
+
+bool GdbServerDebugProbe::writeMemory(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	if (!isRunning)
+		return false;
+
+	static constexpr char digits[] = "0123456789abcdef";
+
+	for (uint32_t offset = 0; offset < size; offset += maxReadSize)
+	{
+		uint32_t chunk = std::min<uint32_t>(size - offset, maxReadSize);
+		std::string payload = "M" + toHex(address + offset) + "," + toHex(chunk) + ":";
+		for (uint32_t i = 0; i < chunk; i++)
+		{
+			payload += digits[buf[offset + i] >> 4];
+			payload += digits[buf[offset + i] & 0x0f];
+		}
+
+		auto reply = transaction(payload);
+		if (!reply.has_value() || *reply != "OK")
+		{
+			logger->error("gdbserver write of {} B at 0x{:08x} failed", chunk, address + offset);
+			return false;
+		}
+	}
+	return true;
+}
+
+bool GdbServerDebugProbe::readMemoryBatch(std::vector<ReadRequest>& requests)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	if (!isRunning)
+	{
+		for (auto& request : requests)
+			request.success = false;
+		return false;
+	}
+
+	buildReadPackets(requests);
+
+	for (auto& request : requests)
+		request.success = true;
+
+	if (!exchangeReadPackets())
+		return false;
+
+	return std::all_of(requests.begin(), requests.end(), [](const ReadRequest& request)
+					   { return request.success; });
+}
+
+std::string GdbServerDebugProbe::getLastErrorMsg() const
+{
+	return lastErrorMsg;
+}
+
+std::vector<std::string> GdbServerDebugProbe::getConnectedDevices()
+{
+	return std::vector<std::string>{"GDB SERVER"};
+}
+
+std::string GdbServerDebugProbe::decodePayload(const std::string& payload)
+{
+	std::string result;
+	result.reserve(payload.size());
+
+	for (size_t i = 0; i < payload.size(); i++)
+	{
+		if (payload[i] == '}' && i + 1 < payload.size())
+			result += static_cast<char>(payload[++i] ^ 0x20);
+		/* run length encoding - the previous character is repeated (count - 29) more times */
+		else if (payload[i] == '*' && i + 1 < payload.size() && !result.empty())
+			result.append(static_cast<uint8_t>(payload[++i]) - 29, result.back());
+		else
+			result += payload[i];
+	}
+	return result;
+}
+
+std::string GdbServerDebugProbe::encodePacket(const std::string& payload)
+{
+	uint8_t checksum = std::accumulate(payload.begin(), payload.end(), static_cast<uint8_t>(0), [](uint8_t sum, char c)
+									   { return static_cast<uint8_t>(sum + static_cast<uint8_t>(c)); });
+	char trailer[4];
+	std::snprintf(trailer, sizeof(trailer), "#%02x", checksum);
+	return "$" + payload + trailer;
+}
+
+bool GdbServerDebugProbe::connectToServer(const std::string& address)
+{
+	serverAddress = address;
+
+	auto separator = address.rfind(':');
+	if (separator == std::string::npos)
+	{
+		lastErrorMsg = "Invalid gdbserver address!";
+		logger->error("gdbserver address \"{}\" should be <host>:<port>", address);
+		return false;
+	}
+
+	std::string host = address.substr(0, separator);
+	std::string port = address.substr(separator + 1);
+
+	addrinfo hints{};
+	hints.ai_family = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	addrinfo* results = nullptr;
+
+	if (getaddrinfo(host.c_str(), port.c_str(), &hints, &results) != 0)
+	{
+		lastErrorMsg = "Could not resolve gdbserver address!";
+		logger->error("Could not resolve {}", address);
+		return false;
+	}
+
+	for (addrinfo* info = results; info != nullptr; info = info->ai_next)
+	{
+		socketHandle = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+		if (socketHandle == invalidSocket)
+			continue;
+		if (connect(socketHandle, info->ai_addr, static_cast<int>(info->ai_addrlen)) == 0)
+			break;
+		closeSocket(socketHandle);
+		socketHandle = invalidSocket;
+	}
+	freeaddrinfo(results);
+
+	if (socketHandle == invalidSocket)
+	{
+		lastErrorMsg = "Could not connect to gdbserver!";
+		logger->error("Could not connect to {}", address);
+		return false;
+	}
+
+	/* small request packets must not wait for each other */
+	int noDelay = 1;
+	setsockopt(socketHandle, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&noDelay), sizeof(noDelay));
+
+#ifdef _WIN32
+	DWORD timeout = receiveTimeoutMs;
+#else
+	timeval timeout{receiveTimeoutMs / 1000, (receiveTimeoutMs % 1000) * 1000};
+#endif
+	setsockopt(socketHandle, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+
+	receiveBuffer.clear();
+	noAckMode = false;
+	return true;
+}
+
+void GdbServerDebugProbe::disconnect()
+{
+	if (socketHandle != invalidSocket)
+		closeSocket(socketHandle);
+	socketHandle = invalidSocket;
+}
+
+bool GdbServerDebugProbe::handshake()
+{
+	if (!sendRaw("+"))
+		return false;
+
+	auto supported = transaction("qSupported:swbreak+;hwbreak+");
+	if (!supported.has_value())
+		return false;
+
+	maxReadSize = 256;
+	auto packetSize = supported->find("PacketSize=");
+	if (packetSize != std::string::npos)
+	{
+		/* the reply carries two hex digits per byte and the packet framing */
+		size_t size = std::stoul(supported->substr(packetSize + 11), nullptr, 16);
+		maxReadSize = std::clamp<size_t>((size - 8) / 2, 4, maxReadSizeLimit);
+	}
+
+	if (supported->find("QStartNoAckMode+") != std::string::npos)
+	{
+		auto reply = transaction("QStartNoAckMode");
+		noAckMode = reply.has_value() && *reply == "OK";
+	}
+
+	/* the stop reason query is what every client sends first, some servers expect it */
+	return transaction("?").has_value();
+}
+
+bool GdbServerDebugProbe::sendRaw(const std::string& data)
+{
+	if (send(socketHandle, data.data(), static_cast<int>(data.size()), sendFlags) != static_cast<int>(data.size()))
+	{
+		fail("Connection to gdbserver lost!");
+		return false;
+	}
+	return true;
+}
+
+bool GdbServerDebugProbe::sendPacket(const std::string& payload)
+{
+	return sendRaw(encodePacket(payload));
+}
+
+std::optional<std::string> GdbServerDebugProbe::receivePacket()
+{
+	while (true)
+	{
+		/* acknowledgments and notifications are skipped */
+		size_t start = receiveBuffer.find_first_not_of('+');
+		if (start != std::string::npos && receiveBuffer[start] == '-')
+		{
+			fail("gdbserver rejected a packet!");
+			return std::nullopt;
+		}
+
+		if (start != std::string::npos && (receiveBuffer[start] == '$' || receiveBuffer[start] == '%'))
+		{
+			size_t end = receiveBuffer.find('#', start);
+			if (end != std::string::npos && end + 2 < receiveBuffer.size())
+			{
+				bool isNotification = receiveBuffer[start] == '%';
+				std::string payload = receiveBuffer.substr(start + 1, end - start - 1);
+				receiveBuffer.erase(0, end + 3);
+
+				if (isNotification)
+					continue;
+
+				if (!noAckMode && !sendRaw("+"))
+					return std::nullopt;
+
+				return decodePayload(payload);
+			}
+		}
+		else if (start != std::string::npos)
+		{
+			/* garbage in front of a packet */
+			receiveBuffer.erase(0, receiveBuffer.find_first_of("$%", start));
+			continue;
+		}
+
+		char chunk[4096];
+		int received = recv(socketHandle, chunk, sizeof(chunk), 0);
+		if (received <= 0)
+		{
+			fail(received == 0 ? "gdbserver closed the connection!" : "gdbserver does not respond!");
+			return std::nullopt;
+		}
+		receiveBuffer.append(chunk, received);
+	}
+}
+
+std::optional<std::string> GdbServerDebugProbe::transaction(const std::string& payload)
+{
+	if (!sendPacket(payload))
+		return std::nullopt;
+	return receivePacket();
+}
+
+void GdbServerDebugProbe::buildReadPackets(std::vector<ReadRequest>& requests)
+{
+	batchOrder.resize(requests.size());
+	std::iota(batchOrder.begin(), batchOrder.end(), 0);
+	std::sort(batchOrder.begin(), batchOrder.end(), [&](size_t a, size_t b)
+			  { return requests[a].address < requests[b].address; });
+
+	readPackets.clear();
+
+	/* touching and overlapping requests share packets, packets are limited by the server buffer */
+	for (auto index : batchOrder)
+	{
+		auto& request = requests[index];
+		uint64_t address = request.address;
+		uint32_t remaining = request.size;
+
+		while (remaining > 0)
+		{
+			bool isContinuation = !readPackets.empty() && address <= static_cast<uint64_t>(readPackets.back().address) + readPackets.back().size;
+			bool hasSpace = !readPackets.empty() && readPackets.back().size < maxReadSize;
+
+			if (!isContinuation || (!hasSpace && address == static_cast<uint64_t>(readPackets.back().address) + readPackets.back().size))
+				readPackets.push_back({static_cast<uint32_t>(address), 0, {}});
+
+			auto& packet = readPackets.back();
+			uint64_t packetEnd = static_cast<uint64_t>(packet.address) + packet.size;
+			uint32_t size = 0;
+
+			if (address < packetEnd)
+				size = static_cast<uint32_t>(std::min<uint64_t>(remaining, packetEnd - address));
+			else
+			{
+				size = std::min<uint32_t>(remaining, maxReadSize - packet.size);
+				packet.size += size;
+			}
+
+			packet.segments.push_back({&request, request.size - remaining, static_cast<uint32_t>(address - packet.address), size});
+			address += size;
+			remaining -= size;
+		}
+	}
+}
+
+bool GdbServerDebugProbe::exchangeReadPackets()
+{
+	auto packetPayload = [&](size_t i)
+	{ return encodePacket("m" + toHex(readPackets[i].address) + "," + toHex(readPackets[i].size)); };
+
+	/* the first window goes out in a single send */
+	size_t sent = 0;
+	std::string window;
+	for (; sent < std::min(maxPacketsInFlight, readPackets.size()); sent++)
+		window += packetPayload(sent);
+
+	if (!window.empty() && !sendRaw(window))
+		return false;
+
+	for (size_t i = 0; i < readPackets.size(); i++)
+	{
+		auto reply = receivePacket();
+		if (!reply.has_value())
+			return false;
+
+		if (sent < readPackets.size() && !sendRaw(packetPayload(sent++)))
+			return false;
+
+		readPacketCount++;
+		auto& packet = readPackets[i];
+
+		/* an error reply or a shorter one when part of the range is not accessible */
+		replyData.clear();
+		if (reply->empty() || (*reply)[0] != 'E' || reply->size() != 3)
+		{
+			for (size_t c = 0; c + 1 < reply->size(); c += 2)
+			{
+				int high = fromHexDigit((*reply)[c]);
+				int low = fromHexDigit((*reply)[c + 1]);
+				if (high < 0 || low < 0)
+					break;
+				replyData.push_back(static_cast<uint8_t>((high << 4) | low));
+			}
+		}
+
+		for (auto& segment : packet.segments)
+		{
+			if (segment.packetOffset + segment.size > replyData.size())
+			{
+				segment.request->success = false;
+				continue;
+			}
+			std::memcpy(segment.request->dest + segment.requestOffset, replyData.data() + segment.packetOffset, segment.size);
+		}
+	}
+	return true;
+}
+
+void GdbServerDebugProbe::fail(const std::string& message)
+{
+	lastErrorMsg = message;
+	isRunning = false;
+	logger->error("{} ({})", message, serverAddress);
+	disconnect();
+}
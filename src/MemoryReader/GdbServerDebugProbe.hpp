@@ -0,0 +1,98 @@
+#ifndef _GdbServerDebugProbe_HPP
+#define _GdbServerDebugProbe_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "IDebugProbe.hpp"
+#include "spdlog/spdlog.h"
+
+/// @brief Debug probe talking GDB Remote Serial Protocol over TCP to a gdbserver (OpenOCD, pyOCD, QEMU...).
+/// Reads of a batch are merged into as few 'm' packets as the server packet size allows and up to
+/// maxPacketsInFlight of them are sent before the first reply is awaited. No-ack mode is used when the
+/// server supports it. The run state of the target is not changed - the server has to allow memory
+/// access while the target runs (e.g. OpenOCD must not halt the target on gdb-attach). NORMAL mode only.
+class GdbServerDebugProbe : public IDebugProbe
+{
+   public:
+#ifdef _WIN32
+	using SocketType = uintptr_t;
+#else
+	using SocketType = int;
+#endif
+
+	GdbServerDebugProbe(spdlog::logger* logger);
+	~GdbServerDebugProbe();
+
+	bool startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) override;
+	bool stopAcqusition() override;
+	bool isValid() const override;
+	std::string getTargetName() override { return serverAddress; }
+
+	std::optional<IDebugProbe::varEntryType> readSingleEntry() override;
+
+	bool readMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+	bool writeMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+	bool readMemoryBatch(std::vector<ReadRequest>& requests) override;
+
+	std::string getLastErrorMsg() const override;
+	std::vector<std::string> getConnectedDevices() override;
+
+	/// @brief number of 'm' packets sent since the start, for diagnostics
+	uint64_t getReadPacketCount() const { return readPacketCount; }
+
+	/// @brief decodes the payload of a packet - escapes and run length encoding
+	static std::string decodePayload(const std::string& payload);
+	static std::string encodePacket(const std::string& payload);
+
+   private:
+	/* part of a packet reply that belongs to a request */
+	struct Segment
+	{
+		ReadRequest* request;
+		uint32_t requestOffset;
+		uint32_t packetOffset;
+		uint32_t size;
+	};
+
+	struct ReadPacket
+	{
+		uint32_t address;
+		uint32_t size;
+		std::vector<Segment> segments;
+	};
+
+	bool connectToServer(const std::string& address);
+	void disconnect();
+	bool handshake();
+
+	bool sendRaw(const std::string& data);
+	bool sendPacket(const std::string& payload);
+	std::optional<std::string> receivePacket();
+	std::optional<std::string> transaction(const std::string& payload);
+	void buildReadPackets(std::vector<ReadRequest>& requests);
+	bool exchangeReadPackets();
+	void fail(const std::string& message);
+
+   private:
+	static constexpr size_t maxPacketsInFlight = 8;
+	static constexpr size_t maxReadSizeLimit = 4096;
+	static constexpr int receiveTimeoutMs = 1000;
+	static constexpr SocketType invalidSocket = static_cast<SocketType>(-1);
+
+	SocketType socketHandle = invalidSocket;
+	std::string serverAddress;
+	bool noAckMode = false;
+	size_t maxReadSize = 256;
+	uint64_t readPacketCount = 0;
+
+	std::string receiveBuffer;
+	std::vector<ReadPacket> readPackets;
+	std::vector<size_t> batchOrder;
+	std::vector<uint8_t> replyData;
+
+	spdlog::logger* logger;
+};
+
+#endif
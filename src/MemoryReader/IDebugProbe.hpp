@@ -5,11 +5,10 @@
 #include <cstdint>
 #include <optional>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
-#include "RingBuffer.hpp"
+#include "SpscRingBuffer.hpp"
 
 class IDebugProbe
 {
@@ -27,11 +26,29 @@ class IDebugProbe
 		std::string device = "";
 		Mode mode = Mode::NORMAL;
 		uint32_t speedkHz = 10000;
+		/* simulated probe only */
+		std::string simulationGenerators = "";
+		uint32_t simulationLatencyUs = 200;
+		uint32_t simulationBandwidthKBps = 1000;
+		/* replay probe only */
+		std::string replayFilePath = "";
+		bool replayRealTime = true;
+		/* gdbserver probe only */
+		std::string gdbServerAddress = "localhost:3333";
 
 	} DebugProbeSettings;
 
-	/* timestamp (first) and a map of <address-value> entries (second) only fo HSS mode */
-	using varEntryType = std::pair<double, std::unordered_map<uint32_t, double>>;
+	/* single entry of a scatter-gather read, success is filled by readMemoryBatch */
+	struct ReadRequest
+	{
+		uint32_t address;
+		uint32_t size;
+		uint8_t* dest;
+		bool success = false;
+	};
+
+	/* timestamp (first) and raw values in the order of the addressSizeVector passed to startAcqusition (second) only fo HSS mode */
+	using varEntryType = std::pair<double, std::vector<uint32_t>>;
 
 	virtual ~IDebugProbe() = default;
 	virtual bool startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) = 0;
@@ -46,6 +63,19 @@ class IDebugProbe
 	virtual bool readMemory(uint32_t address, uint8_t* buf, uint32_t size) = 0;
 	virtual bool writeMemory(uint32_t address, uint8_t* buf, uint32_t size) = 0;
 
+	/* NORMAL mode - reads all requests and returns true if every one of them succeeded. Probes
+	should override it with their fastest bulk primitive, the default reads element by element */
+	virtual bool readMemoryBatch(std::vector<ReadRequest>& requests)
+	{
+		bool result = true;
+		for (auto& request : requests)
+		{
+			request.success = readMemory(request.address, request.dest, request.size);
+			result = result && request.success;
+		}
+		return result;
+	}
+
 	virtual std::string getLastErrorMsg() const = 0;
 
 	virtual std::vector<std::string> getConnectedDevices() = 0;
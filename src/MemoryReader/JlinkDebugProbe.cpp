@@ -4,6 +4,7 @@
 #include <spdlog/spdlog.h>
 
 #include <algorithm>
+#include <numeric>
 #include <string>
 
 JlinkDebugProbe::JlinkDebugProbe(spdlog::logger* logger) : logger(logger)
@@ -58,8 +59,7 @@ bool JlinkDebugProbe::startAcqusition(const DebugProbeSettings& probeSettings, s
 		return true;
 	}
 
-	if (varTable.size() > 0)
-		varTable.clear();
+	varTable.clear();
 
 	trackedVarsCount = 0;
 
@@ -72,7 +72,6 @@ bool JlinkDebugProbe::startAcqusition(const DebugProbeSettings& probeSettings, s
 		desc.NumBytes = size;
 		desc.Flags = 0;
 		desc.Dummy = 0;
-		addressSizeMap[address] = size;
 		trackedVarsTotalSize += size;
 	}
 
@@ -152,35 +151,47 @@ std::optional<IDebugProbe::varEntryType> JlinkDebugProbe::readSingleEntry()
 			logger->error(lastErrorMsg);
 			isRunning = false;
 		}
-		return varTable.pop();
+		return popEntry();
 	}
 
 	emptyMessageErrorCnt = 0;
 
 	for (int32_t i = 0; i < readSize; i += trackedVarsTotalSize)
 	{
-		varEntryType entry{};
+		/* the entry is decoded in place into a preallocated slot */
+		varEntryType* entry = varTable.claim();
+		if (entry == nullptr)
+		{
+			lastErrorMsg = "HSS FIFO overflow!";
+			logger->error(lastErrorMsg);
+			isRunning = false;
+			break;
+		}
 
 		/* timestamp */
-		entry.first = (*(uint32_t*)&rawBuffer[i]) * timestampResolution;
+		entry->first = (*(uint32_t*)&rawBuffer[i]) * timestampResolution;
+
+		entry->second.resize(trackedVarsCount);
 
 		int32_t k = i + 4;
 		for (size_t j = 0; j < trackedVarsCount; j++)
 		{
-			uint32_t address = variableDesc[j].Addr;
-			entry.second[address] = *(uint32_t*)&rawBuffer[k];
-			k += addressSizeMap[address];
+			entry->second[j] = *(uint32_t*)&rawBuffer[k];
+			k += variableDesc[j].NumBytes;
 		}
 
-		if (!varTable.push(entry))
-		{
-			lastErrorMsg = "HSS FIFO overflow!";
-			logger->error(lastErrorMsg);
-			isRunning = false;
-		}
+		varTable.publish();
 	}
 
-	return varTable.pop();
+	return popEntry();
+}
+
+std::optional<IDebugProbe::varEntryType> JlinkDebugProbe::popEntry()
+{
+	varEntryType entry;
+	if (!varTable.tryPop(entry))
+		return std::nullopt;
+	return entry;
 }
 
 bool JlinkDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
@@ -189,6 +200,48 @@ bool JlinkDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
 	return (isRunning && JLINKARM_ReadMemEx(address, size, buf, 0) >= 0);
 }
 
+bool JlinkDebugProbe::readMemoryBatch(std::vector<ReadRequest>& requests)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+
+	batchOrder.resize(requests.size());
+	std::iota(batchOrder.begin(), batchOrder.end(), 0);
+	std::sort(batchOrder.begin(), batchOrder.end(), [&](size_t a, size_t b)
+			  { return requests[a].address < requests[b].address; });
+
+	bool result = isRunning;
+	size_t first = 0;
+
+	/* overlapping and touching requests are served by a single ReadMemEx call */
+	while (first < batchOrder.size())
+	{
+		uint32_t start = requests[batchOrder[first]].address;
+		uint64_t end = static_cast<uint64_t>(start) + requests[batchOrder[first]].size;
+		size_t last = first + 1;
+
+		while (last < batchOrder.size() && requests[batchOrder[last]].address <= end)
+		{
+			end = std::max(end, static_cast<uint64_t>(requests[batchOrder[last]].address) + requests[batchOrder[last]].size);
+			last++;
+		}
+
+		batchBuffer.resize(end - start);
+		bool success = isRunning && JLINKARM_ReadMemEx(start, batchBuffer.size(), batchBuffer.data(), 0) >= 0;
+
+		for (size_t i = first; i < last; i++)
+		{
+			auto& request = requests[batchOrder[i]];
+			request.success = success;
+			if (success)
+				std::copy_n(batchBuffer.begin() + (request.address - start), request.size, request.dest);
+		}
+
+		result = result && success;
+		first = last;
+	}
+	return result;
+}
+
 bool JlinkDebugProbe::writeMemory(uint32_t address, uint8_t* buf, uint32_t size)
 {
 	std::lock_guard<std::mutex> lock(mtx);
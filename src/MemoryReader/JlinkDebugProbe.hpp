@@ -3,7 +3,6 @@
 
 #include <mutex>
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "IDebugProbe.hpp"
@@ -23,6 +22,7 @@ class JlinkDebugProbe : public IDebugProbe
 
 	bool readMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
 	bool writeMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+	bool readMemoryBatch(std::vector<ReadRequest>& requests) override;
 
 	std::string getLastErrorMsg() const override;
 	std::vector<std::string> getConnectedDevices() override;
@@ -42,8 +42,13 @@ class JlinkDebugProbe : public IDebugProbe
 	size_t emptyMessageErrorThreshold = 100000;
 	size_t emptyMessageErrorCnt = 0;
 
-	std::unordered_map<uint32_t, uint8_t> addressSizeMap;
-	RingBuffer<varEntryType, fifoSize> varTable;
+	SpscRingBuffer<varEntryType> varTable{fifoSize};
+
+	/* scratch space for merged batch reads */
+	std::vector<size_t> batchOrder;
+	std::vector<uint8_t> batchBuffer;
+
+	std::optional<varEntryType> popEntry();
 
 	spdlog::logger* logger;
 };
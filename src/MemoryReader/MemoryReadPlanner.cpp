@@ -0,0 +1,103 @@
+#include "MemoryReadPlanner.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+
+void MemoryReadPlanner::clear()
+{
+	blocks.clear();
+	locations.clear();
+	buffer.clear();
+}
+
+bool MemoryReadPlanner::isPeripheralAddress(uint32_t address)
+{
+	return (address >= 0x40000000 && address < 0x60000000) || address >= 0xE0000000;
+}
+
+void MemoryReadPlanner::plan(const std::vector<std::pair<uint32_t, uint8_t>>& sampleList, const Settings& settings)
+{
+	clear();
+
+	if (sampleList.empty())
+		return;
+
+	std::vector<size_t> order(sampleList.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+					 { return sampleList[a].first < sampleList[b].first; });
+
+	auto alignDown = [](uint64_t address)
+	{ return address & ~static_cast<uint64_t>(alignment - 1); };
+	auto alignUp = [](uint64_t address)
+	{ return (address + alignment - 1) & ~static_cast<uint64_t>(alignment - 1); };
+
+	/* block index of each sample list entry, the buffer offsets are known once all blocks are closed */
+	std::vector<size_t> blockOfEntry(sampleList.size());
+
+	uint64_t blockStart = 0;
+	uint64_t blockEnd = 0;
+
+	for (size_t i = 0; i < order.size(); i++)
+	{
+		auto [address, size] = sampleList[order[i]];
+		uint64_t start = alignDown(address);
+		uint64_t end = alignUp(static_cast<uint64_t>(address) + size);
+
+		if (i > 0)
+		{
+			uint32_t maxGap = (isPeripheralAddress(address) || isPeripheralAddress(blockStart)) ? 0 : settings.maxGap;
+			bool fitsGap = start <= blockEnd + maxGap;
+			bool fitsSize = std::max(end, blockEnd) - blockStart <= std::max(settings.maxBlockSize, alignment);
+
+			if (fitsGap && fitsSize)
+			{
+				blockEnd = std::max(end, blockEnd);
+				blocks.back().size = static_cast<uint32_t>(blockEnd - blockStart);
+				blockOfEntry[order[i]] = blocks.size() - 1;
+				continue;
+			}
+		}
+
+		blockStart = start;
+		blockEnd = end;
+		blocks.push_back({static_cast<uint32_t>(blockStart), static_cast<uint32_t>(blockEnd - blockStart), 0});
+		blockOfEntry[order[i]] = blocks.size() - 1;
+	}
+
+	uint32_t offset = 0;
+	for (auto& block : blocks)
+	{
+		block.bufferOffset = offset;
+		offset += block.size;
+	}
+	buffer.assign(offset, 0);
+
+	locations.resize(sampleList.size());
+	for (size_t i = 0; i < sampleList.size(); i++)
+	{
+		const auto& block = blocks[blockOfEntry[i]];
+		locations[i] = {block.bufferOffset + (sampleList[i].first - block.address), sampleList[i].second};
+	}
+}
+
+const std::vector<MemoryReadPlanner::Block>& MemoryReadPlanner::getBlocks() const
+{
+	return blocks;
+}
+
+uint8_t* MemoryReadPlanner::getBuffer()
+{
+	return buffer.data();
+}
+
+void MemoryReadPlanner::scatter(uint32_t* rawValues) const
+{
+	for (size_t i = 0; i < locations.size(); i++)
+	{
+		uint32_t value = 0;
+		std::memcpy(&value, &buffer[locations[i].bufferOffset], std::min<uint8_t>(locations[i].size, sizeof(value)));
+		rawValues[i] = value;
+	}
+}
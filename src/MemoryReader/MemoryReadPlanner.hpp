@@ -0,0 +1,61 @@
+#ifndef _MEMORYREADPLANNER_HPP
+#define _MEMORYREADPLANNER_HPP
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/// @brief Coalesces the sampled (address, size) pairs into aligned memory blocks so that a single
+/// bulk read per block replaces a read per variable. Bytes read into the block buffer are then
+/// scattered back to the raw values in the original sample list order.
+class MemoryReadPlanner
+{
+   public:
+	static constexpr uint32_t alignment = 4;
+
+	typedef struct Settings
+	{
+		/* max number of unused bytes between two ranges that still get merged into one block */
+		uint32_t maxGap = 32;
+		/* max size of a single block in bytes */
+		uint32_t maxBlockSize = 1024;
+	} Settings;
+
+	struct Block
+	{
+		uint32_t address;
+		uint32_t size;
+		uint32_t bufferOffset;
+	};
+
+	/// @brief builds blocks for the given sample list
+	/// @param sampleList (address, size) pairs, sizes of up to 4 bytes are supported
+	/// @param settings gap and size limits
+	void plan(const std::vector<std::pair<uint32_t, uint8_t>>& sampleList, const Settings& settings);
+	void clear();
+
+	const std::vector<Block>& getBlocks() const;
+
+	/// @brief buffer the blocks should be read into, each block at its bufferOffset
+	uint8_t* getBuffer();
+
+	/// @brief copies the values from the block buffer to rawValues, indexed as the sample list
+	void scatter(uint32_t* rawValues) const;
+
+   private:
+	/* Cortex-M peripheral and system regions - reads there may have side effects so gaps are never bridged */
+	static bool isPeripheralAddress(uint32_t address);
+
+   private:
+	struct Location
+	{
+		uint32_t bufferOffset;
+		uint8_t size;
+	};
+
+	std::vector<Block> blocks;
+	std::vector<Location> locations;
+	std::vector<uint8_t> buffer;
+};
+
+#endif
@@ -0,0 +1,290 @@
+#include "ProcessDebugProbe.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <elf.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <cerrno>
+#endif
+
+ProcessDebugProbe::ProcessDebugProbe(spdlog::logger* logger) : logger(logger)
+{
+}
+
+bool ProcessDebugProbe::startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
+{
+	(void)addressSizeVector;
+	(void)samplingFreqency;
+
+	std::lock_guard<std::mutex> lock(mtx);
+	lastErrorMsg = "";
+	isRunning = false;
+
+#ifdef __linux__
+	try
+	{
+		pid = std::stoi(probeSettings.serialNumber);
+	}
+	catch (const std::exception&)
+	{
+		lastErrorMsg = "Invalid process ID!";
+		logger->error("Process probe expects a PID, got \"{}\"", probeSettings.serialNumber);
+		return false;
+	}
+
+	auto maybeBias = readLoadBias(pid);
+	if (!maybeBias.has_value())
+	{
+		lastErrorMsg = "Process not found!";
+		logger->error("Could not read the memory map of process {}", pid);
+		return false;
+	}
+	loadBias = maybeBias.value();
+
+	std::ifstream comm("/proc/" + std::to_string(pid) + "/comm");
+	std::getline(comm, processName);
+
+	isRunning = true;
+	logger->info("Process probe attached to {} ({}), load bias 0x{:x}", pid, processName, loadBias);
+	return true;
+#else
+	(void)probeSettings;
+	lastErrorMsg = "Process probe is supported on Linux only!";
+	logger->error(lastErrorMsg);
+	return false;
+#endif
+}
+
+bool ProcessDebugProbe::stopAcqusition()
+{
+	isRunning = false;
+	return true;
+}
+
+bool ProcessDebugProbe::isValid() const
+{
+	return isRunning;
+}
+
+std::string ProcessDebugProbe::getTargetName()
+{
+	return processName;
+}
+
+std::optional<IDebugProbe::varEntryType> ProcessDebugProbe::readSingleEntry()
+{
+	return std::nullopt;
+}
+
+bool ProcessDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	return transfer(address, buf, size, false);
+}
+
+bool ProcessDebugProbe::writeMemory(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	return transfer(address, buf, size, true);
+}
+
+bool ProcessDebugProbe::readMemoryBatch(std::vector<ReadRequest>& requests)
+{
+#ifdef __linux__
+	if (!isRunning)
+		return false;
+
+	std::array<iovec, maxSegments> local;
+	std::array<iovec, maxSegments> remote;
+	bool result = true;
+
+	for (size_t first = 0; first < requests.size(); first += maxSegments)
+	{
+		size_t count = std::min(maxSegments, requests.size() - first);
+		size_t expected = 0;
+
+		for (size_t i = 0; i < count; i++)
+		{
+			auto& request = requests[first + i];
+			local[i] = {request.dest, request.size};
+			remote[i] = {reinterpret_cast<void*>(loadBias + request.address), request.size};
+			expected += request.size;
+		}
+
+		ssize_t transferred = process_vm_readv(pid, local.data(), count, remote.data(), count, 0);
+
+		if (transferred < 0)
+			setError("read", errno);
+
+		/* a partial transfer stops at the first request that could not be read */
+		size_t remaining = std::max<ssize_t>(transferred, 0);
+		for (size_t i = 0; i < count; i++)
+		{
+			auto& request = requests[first + i];
+			request.success = remaining >= request.size;
+			remaining -= std::min<size_t>(remaining, request.size);
+		}
+
+		result = result && static_cast<size_t>(transferred) == expected;
+	}
+	return result;
+#else
+	(void)requests;
+	return false;
+#endif
+}
+
+std::string ProcessDebugProbe::getLastErrorMsg() const
+{
+	return lastErrorMsg;
+}
+
+std::vector<std::string> ProcessDebugProbe::getConnectedDevices()
+{
+	std::vector<std::pair<int, std::string>> processes;
+
+#ifdef __linux__
+	std::error_code error;
+	for (auto& entry : std::filesystem::directory_iterator("/proc", error))
+	{
+		const auto name = entry.path().filename().string();
+		if (!std::all_of(name.begin(), name.end(), ::isdigit))
+			continue;
+
+		int processId = std::stoi(name);
+		struct stat info;
+		if (processId == getpid() || stat(entry.path().c_str(), &info) != 0 || info.st_uid != getuid())
+			continue;
+
+		std::string comm;
+		std::ifstream commFile(entry.path() / "comm");
+		std::getline(commFile, comm);
+		processes.push_back({processId, comm});
+	}
+#endif
+
+	std::sort(processes.begin(), processes.end(), [](const auto& a, const auto& b)
+			  { return a.first > b.first; });
+
+	std::vector<std::string> result;
+	for (auto& [processId, comm] : processes)
+		result.push_back(std::to_string(processId) + " " + comm);
+	return result;
+}
+
+std::optional<uint64_t> ProcessDebugProbe::readLoadBias(int pid)
+{
+#ifdef __linux__
+	const std::string procPath = "/proc/" + std::to_string(pid);
+
+	std::error_code error;
+	const std::string exePath = std::filesystem::read_symlink(procPath + "/exe", error).string();
+	if (error)
+		return std::nullopt;
+
+	/* start of the mapping holding the beginning of the executable file */
+	std::ifstream maps(procPath + "/maps");
+	std::string line;
+	std::optional<uint64_t> mappedBase;
+
+	while (std::getline(maps, line))
+	{
+		std::istringstream fields(line);
+		std::string range, permissions, offset, device, inode;
+		fields >> range >> permissions >> offset >> device >> inode;
+
+		std::string path;
+		std::getline(fields >> std::ws, path);
+
+		if (path == exePath && std::stoull(offset, nullptr, 16) == 0)
+		{
+			mappedBase = std::stoull(range.substr(0, range.find('-')), nullptr, 16);
+			break;
+		}
+	}
+
+	if (!mappedBase.has_value())
+		return std::nullopt;
+
+	/* link time address of the same file offset - the first PT_LOAD segment rounded down to a page */
+	std::ifstream exe(procPath + "/exe", std::ios::binary);
+	unsigned char ident[EI_NIDENT]{};
+	if (!exe.read(reinterpret_cast<char*>(ident), EI_NIDENT) || std::memcmp(ident, ELFMAG, SELFMAG) != 0)
+		return std::nullopt;
+
+	auto firstLoadAddress = [&]<typename Ehdr, typename Phdr>() -> std::optional<uint64_t>
+	{
+		Ehdr header{};
+		exe.seekg(0);
+		if (!exe.read(reinterpret_cast<char*>(&header), sizeof(header)))
+			return std::nullopt;
+
+		for (size_t i = 0; i < header.e_phnum; i++)
+		{
+			Phdr segment{};
+			exe.seekg(header.e_phoff + i * header.e_phentsize);
+			if (!exe.read(reinterpret_cast<char*>(&segment), sizeof(segment)))
+				return std::nullopt;
+			if (segment.p_type == PT_LOAD)
+				return segment.p_vaddr - segment.p_offset;
+		}
+		return std::nullopt;
+	};
+
+	auto linkAddress = ident[EI_CLASS] == ELFCLASS64 ? firstLoadAddress.operator()<Elf64_Ehdr, Elf64_Phdr>() : firstLoadAddress.operator()<Elf32_Ehdr, Elf32_Phdr>();
+	if (!linkAddress.has_value())
+		return std::nullopt;
+
+	const uint64_t pageSize = sysconf(_SC_PAGESIZE);
+	return mappedBase.value() - (linkAddress.value() & ~(pageSize - 1));
+#else
+	(void)pid;
+	return std::nullopt;
+#endif
+}
+
+bool ProcessDebugProbe::transfer(uint32_t address, uint8_t* buf, uint32_t size, bool write)
+{
+#ifdef __linux__
+	if (!isRunning)
+		return false;
+
+	iovec local{buf, size};
+	iovec remote{reinterpret_cast<void*>(loadBias + address), size};
+
+	ssize_t transferred = write ? process_vm_writev(pid, &local, 1, &remote, 1, 0) : process_vm_readv(pid, &local, 1, &remote, 1, 0);
+	if (transferred < 0)
+		setError(write ? "write" : "read", errno);
+
+	return transferred == static_cast<ssize_t>(size);
+#else
+	(void)address;
+	(void)buf;
+	(void)size;
+	(void)write;
+	return false;
+#endif
+}
+
+void ProcessDebugProbe::setError(const std::string& operation, int error)
+{
+#ifdef __linux__
+	if (error == ESRCH)
+	{
+		lastErrorMsg = "Process exited!";
+		isRunning = false;
+	}
+	else if (error == EPERM)
+		lastErrorMsg = "Permission denied, check /proc/sys/kernel/yama/ptrace_scope!";
+	else
+		lastErrorMsg = "Memory " + operation + " failed!";
+#endif
+	logger->error("Process {} memory {} failed: {}", pid, operation, std::strerror(error));
+}
@@ -0,0 +1,55 @@
+#ifndef _ProcessDebugProbe_HPP
+#define _ProcessDebugProbe_HPP
+
+#include <string>
+#include <vector>
+
+#include "IDebugProbe.hpp"
+#include "spdlog/spdlog.h"
+
+/// @brief Debug probe sampling a local Linux process (e.g. a software-in-the-loop build of the firmware)
+/// with process_vm_readv/process_vm_writev. The process is selected by its PID in place of the probe
+/// serial number. Addresses from the *.elf file are shifted by the load bias of the main executable
+/// so that position independent executables work with ASLR. NORMAL mode only, not supported on other
+/// platforms.
+class ProcessDebugProbe : public IDebugProbe
+{
+   public:
+	ProcessDebugProbe(spdlog::logger* logger);
+
+	bool startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) override;
+	bool stopAcqusition() override;
+	bool isValid() const override;
+	std::string getTargetName() override;
+
+	std::optional<IDebugProbe::varEntryType> readSingleEntry() override;
+
+	bool readMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+	bool writeMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+	/* the whole batch is a single syscall */
+	bool readMemoryBatch(std::vector<ReadRequest>& requests) override;
+
+	std::string getLastErrorMsg() const override;
+	/* "<pid> <name>" of the processes owned by the current user, newest first */
+	std::vector<std::string> getConnectedDevices() override;
+
+	/// @brief difference between the run time and the link time addresses of the main executable of a process
+	static std::optional<uint64_t> readLoadBias(int pid);
+
+	uint64_t getLoadBias() const { return loadBias; }
+
+   private:
+	bool transfer(uint32_t address, uint8_t* buf, uint32_t size, bool write);
+	void setError(const std::string& operation, int error);
+
+   private:
+	static constexpr size_t maxSegments = 1024; /* IOV_MAX */
+
+	int pid = 0;
+	std::string processName;
+	uint64_t loadBias = 0;
+
+	spdlog::logger* logger;
+};
+
+#endif
@@ -0,0 +1,159 @@
+#include "RecordingDebugProbe.hpp"
+
+RecordingDebugProbe::RecordingDebugProbe(std::shared_ptr<IDebugProbe> probe, const std::string& filePath, spdlog::logger* logger) : probe(probe), filePath(filePath), logger(logger)
+{
+	buffer1.reserve(bufferFlushSize);
+	buffer2.reserve(bufferFlushSize);
+}
+
+RecordingDebugProbe::~RecordingDebugProbe()
+{
+	stopAcqusition();
+}
+
+bool RecordingDebugProbe::startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
+{
+	if (!probe->startAcqusition(probeSettings, addressSizeVector, samplingFreqency))
+		return false;
+
+	file.open(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		logger->error("Failed to open capture file: {}", filePath);
+		probe->stopAcqusition();
+		return false;
+	}
+
+	start = std::chrono::steady_clock::now();
+	currentBuffer->clear();
+	currentBuffer->insert(currentBuffer->end(), std::begin(DebugProbeCapture::magic), std::end(DebugProbeCapture::magic));
+	append(DebugProbeCapture::version);
+
+	beginRecord(DebugProbeCapture::RecordType::START);
+	append(static_cast<uint8_t>(probeSettings.mode));
+	append(samplingFreqency);
+	append(static_cast<uint32_t>(addressSizeVector.size()));
+	for (auto& [address, size] : addressSizeVector)
+	{
+		append(address);
+		append(size);
+	}
+
+	isRunning = true;
+	logger->info("Recording probe capture to {}", filePath);
+	return true;
+}
+
+bool RecordingDebugProbe::stopAcqusition()
+{
+	bool result = probe->stopAcqusition();
+
+	if (isRunning)
+	{
+		isRunning = false;
+		flush();
+		saveTask.wait();
+		file.close();
+		logger->info("Probe capture saved to {}", filePath);
+	}
+	return result;
+}
+
+bool RecordingDebugProbe::isValid() const
+{
+	return probe->isValid();
+}
+
+std::string RecordingDebugProbe::getTargetName()
+{
+	return probe->getTargetName();
+}
+
+std::optional<IDebugProbe::varEntryType> RecordingDebugProbe::readSingleEntry()
+{
+	auto maybeEntry = probe->readSingleEntry();
+	if (!maybeEntry.has_value() || !isRunning)
+		return maybeEntry;
+
+	beginRecord(DebugProbeCapture::RecordType::ENTRY);
+	append(maybeEntry->first);
+	append(static_cast<uint32_t>(maybeEntry->second.size()));
+	for (auto value : maybeEntry->second)
+		append(value);
+	flushIfFull();
+
+	return maybeEntry;
+}
+
+bool RecordingDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	bool result = probe->readMemory(address, buf, size);
+	if (isRunning)
+	{
+		recordRead(address, buf, size, result);
+		flushIfFull();
+	}
+	return result;
+}
+
+bool RecordingDebugProbe::writeMemory(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	return probe->writeMemory(address, buf, size);
+}
+
+bool RecordingDebugProbe::readMemoryBatch(std::vector<ReadRequest>& requests)
+{
+	bool result = probe->readMemoryBatch(requests);
+	if (isRunning)
+	{
+		for (auto& request : requests)
+			recordRead(request.address, request.dest, request.size, request.success);
+		flushIfFull();
+	}
+	return result;
+}
+
+std::string RecordingDebugProbe::getLastErrorMsg() const
+{
+	return probe->getLastErrorMsg();
+}
+
+std::vector<std::string> RecordingDebugProbe::getConnectedDevices()
+{
+	return probe->getConnectedDevices();
+}
+
+void RecordingDebugProbe::beginRecord(DebugProbeCapture::RecordType type)
+{
+	append(type);
+	append(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+
+void RecordingDebugProbe::recordRead(uint32_t address, const uint8_t* buf, uint32_t size, bool success)
+{
+	beginRecord(DebugProbeCapture::RecordType::READ);
+	append(address);
+	append(size);
+	append(static_cast<uint8_t>(success));
+	currentBuffer->insert(currentBuffer->end(), buf, buf + size);
+}
+
+void RecordingDebugProbe::flushIfFull()
+{
+	if (currentBuffer->size() >= bufferFlushSize)
+		flush();
+}
+
+void RecordingDebugProbe::flush()
+{
+	/* the previous write has to finish before its buffer is reused */
+	if (saveTask.valid())
+		saveTask.wait();
+
+	auto* fullBuffer = currentBuffer;
+	currentBuffer = currentBuffer == &buffer1 ? &buffer2 : &buffer1;
+	currentBuffer->clear();
+
+	saveTask = std::async(std::launch::async, [this, fullBuffer]()
+						  { file.write(reinterpret_cast<const char*>(fullBuffer->data()), fullBuffer->size()); });
+}
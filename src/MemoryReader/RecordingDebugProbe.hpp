@@ -0,0 +1,66 @@
+#ifndef _RecordingDebugProbe_HPP
+#define _RecordingDebugProbe_HPP
+
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "DebugProbeCapture.hpp"
+#include "IDebugProbe.hpp"
+#include "spdlog/spdlog.h"
+
+/// @brief Decorator that forwards all calls to the wrapped probe and records the results of every read
+/// (NORMAL mode) and every HSS entry, together with their time, to a binary capture file that can be
+/// played back with ReplayDebugProbe. The file is written on a background task.
+class RecordingDebugProbe : public IDebugProbe
+{
+   public:
+	RecordingDebugProbe(std::shared_ptr<IDebugProbe> probe, const std::string& filePath, spdlog::logger* logger);
+	~RecordingDebugProbe();
+
+	bool startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) override;
+	bool stopAcqusition() override;
+	bool isValid() const override;
+	std::string getTargetName() override;
+
+	std::optional<IDebugProbe::varEntryType> readSingleEntry() override;
+
+	bool readMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+	bool writeMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+	bool readMemoryBatch(std::vector<ReadRequest>& requests) override;
+
+	std::string getLastErrorMsg() const override;
+	std::vector<std::string> getConnectedDevices() override;
+
+   private:
+	template <typename T>
+	void append(const T& value)
+	{
+		auto bytes = reinterpret_cast<const uint8_t*>(&value);
+		currentBuffer->insert(currentBuffer->end(), bytes, bytes + sizeof(T));
+	}
+
+	void beginRecord(DebugProbeCapture::RecordType type);
+	void recordRead(uint32_t address, const uint8_t* buf, uint32_t size, bool success);
+	void flushIfFull();
+	void flush();
+
+   private:
+	static constexpr size_t bufferFlushSize = 1024 * 1024;
+
+	std::shared_ptr<IDebugProbe> probe;
+	std::string filePath;
+	spdlog::logger* logger;
+
+	std::ofstream file;
+	std::vector<uint8_t> buffer1;
+	std::vector<uint8_t> buffer2;
+	std::vector<uint8_t>* currentBuffer = &buffer1;
+	std::future<void> saveTask{};
+	std::chrono::steady_clock::time_point start;
+};
+
+#endif
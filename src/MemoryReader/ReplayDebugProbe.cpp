@@ -0,0 +1,226 @@
+#include "ReplayDebugProbe.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+ReplayDebugProbe::ReplayDebugProbe(spdlog::logger* logger) : logger(logger)
+{
+}
+
+ReplayDebugProbe::~ReplayDebugProbe()
+{
+	stopAcqusition();
+}
+
+bool ReplayDebugProbe::startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
+{
+	stopAcqusition();
+
+	std::lock_guard<std::mutex> lock(mtx);
+	lastErrorMsg = "";
+	skippedRecords = 0;
+	hasPendingEntry = false;
+
+	file.open(probeSettings.replayFilePath, std::ios::in | std::ios::binary);
+	if (!file.is_open())
+	{
+		lastErrorMsg = "Could not open capture file!";
+		logger->error("Failed to open capture file: {}", probeSettings.replayFilePath);
+		return false;
+	}
+
+	if (!readHeader(probeSettings.mode, addressSizeVector))
+	{
+		file.close();
+		return false;
+	}
+
+	realTime = probeSettings.replayRealTime;
+	start = std::chrono::steady_clock::now();
+	isRunning = true;
+
+	logger->info("Replaying capture {} {}", probeSettings.replayFilePath, realTime ? "in real time" : "as fast as possible");
+	return true;
+}
+
+bool ReplayDebugProbe::stopAcqusition()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	isRunning = false;
+	if (file.is_open())
+		file.close();
+	if (skippedRecords > 0)
+		logger->warn("Replay skipped {} records not matching the requested reads", skippedRecords);
+	skippedRecords = 0;
+	return true;
+}
+
+bool ReplayDebugProbe::isValid() const
+{
+	return isRunning;
+}
+
+std::optional<IDebugProbe::varEntryType> ReplayDebugProbe::readSingleEntry()
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	if (!isRunning)
+		return std::nullopt;
+
+	/* the pending entry is kept until its time comes */
+	while (!hasPendingEntry)
+	{
+		if (!readRecord())
+		{
+			endOfCapture();
+			return std::nullopt;
+		}
+		hasPendingEntry = record.type == DebugProbeCapture::RecordType::ENTRY;
+	}
+
+	if (realTime && std::chrono::steady_clock::now() - start < std::chrono::duration<double>(record.time))
+		return std::nullopt;
+
+	hasPendingEntry = false;
+	return record.entry;
+}
+
+bool ReplayDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	if (!isRunning)
+		return false;
+
+	while (true)
+	{
+		if (!readRecord())
+		{
+			endOfCapture();
+			return false;
+		}
+
+		if (record.type == DebugProbeCapture::RecordType::READ && record.address == address && record.data.size() == size)
+			break;
+
+		skippedRecords++;
+	}
+
+	waitForRecordTime();
+	std::memcpy(buf, record.data.data(), size);
+	return record.success;
+}
+
+bool ReplayDebugProbe::writeMemory(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	(void)buf;
+	logger->warn("Replay probe ignores write of {} bytes to 0x{:08x}", size, address);
+	return false;
+}
+
+std::string ReplayDebugProbe::getLastErrorMsg() const
+{
+	return lastErrorMsg;
+}
+
+std::vector<std::string> ReplayDebugProbe::getConnectedDevices()
+{
+	return std::vector<std::string>{"REPLAY"};
+}
+
+bool ReplayDebugProbe::readHeader(Mode mode, const std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector)
+{
+	char magic[sizeof(DebugProbeCapture::magic)]{};
+	uint32_t version = 0;
+	file.read(magic, sizeof(magic));
+
+	if (!file || std::memcmp(magic, DebugProbeCapture::magic, sizeof(magic)) != 0 || !read(version) || version != DebugProbeCapture::version)
+	{
+		lastErrorMsg = "Invalid capture file!";
+		logger->error("Capture file has no valid header");
+		return false;
+	}
+
+	uint8_t recordedMode = 0;
+	uint32_t recordedFrequency = 0;
+	uint32_t count = 0;
+	if (!readRecord() || record.type != DebugProbeCapture::RecordType::START || !read(recordedMode) || !read(recordedFrequency) || !read(count))
+	{
+		lastErrorMsg = "Invalid capture file!";
+		logger->error("Capture file has no start record");
+		return false;
+	}
+
+	std::vector<std::pair<uint32_t, uint8_t>> recordedVariables(count);
+	for (auto& [address, size] : recordedVariables)
+	{
+		if (!read(address) || !read(size))
+		{
+			lastErrorMsg = "Invalid capture file!";
+			return false;
+		}
+	}
+
+	if (recordedMode != mode)
+	{
+		lastErrorMsg = "Capture was recorded in a different mode!";
+		logger->error("Capture recorded in mode {} cannot be replayed in mode {}", recordedMode, static_cast<uint8_t>(mode));
+		return false;
+	}
+
+	/* NORMAL reads are matched record by record, HSS entries have to keep their layout */
+	if (mode == Mode::HSS && recordedVariables != addressSizeVector)
+	{
+		lastErrorMsg = "Captured variables differ from the sampled ones!";
+		logger->error("HSS capture contains {} variables, {} requested", recordedVariables.size(), addressSizeVector.size());
+		return false;
+	}
+
+	logger->info("Capture recorded {} variables at {} Hz", recordedVariables.size(), recordedFrequency);
+	return true;
+}
+
+bool ReplayDebugProbe::readRecord()
+{
+	if (!read(record.type) || !read(record.time))
+		return false;
+
+	switch (record.type)
+	{
+		case DebugProbeCapture::RecordType::START:
+			/* payload is parsed by readHeader */
+			return true;
+		case DebugProbeCapture::RecordType::READ:
+		{
+			uint32_t size = 0;
+			uint8_t success = 0;
+			if (!read(record.address) || !read(size) || !read(success))
+				return false;
+			record.success = success != 0;
+			record.data.resize(size);
+			return static_cast<bool>(file.read(reinterpret_cast<char*>(record.data.data()), size));
+		}
+		case DebugProbeCapture::RecordType::ENTRY:
+		{
+			uint32_t count = 0;
+			if (!read(record.entry.first) || !read(count))
+				return false;
+			record.entry.second.resize(count);
+			return static_cast<bool>(file.read(reinterpret_cast<char*>(record.entry.second.data()), count * sizeof(uint32_t)));
+		}
+	}
+	logger->error("Unknown capture record type {}", static_cast<uint8_t>(record.type));
+	return false;
+}
+
+void ReplayDebugProbe::waitForRecordTime() const
+{
+	if (realTime)
+		std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(record.time)));
+}
+
+void ReplayDebugProbe::endOfCapture()
+{
+	isRunning = false;
+	lastErrorMsg = "End of capture";
+	logger->info("Replay reached the end of the capture");
+}
@@ -0,0 +1,72 @@
+#ifndef _ReplayDebugProbe_HPP
+#define _ReplayDebugProbe_HPP
+
+#include <chrono>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "DebugProbeCapture.hpp"
+#include "IDebugProbe.hpp"
+#include "spdlog/spdlog.h"
+
+/// @brief Debug probe playing back a capture written by RecordingDebugProbe. Reads are answered with the
+/// recorded data of the next matching READ record and HSS entries are returned in the recorded order,
+/// either at the original pace or as fast as possible. The acquisition ends with the capture.
+class ReplayDebugProbe : public IDebugProbe
+{
+   public:
+	ReplayDebugProbe(spdlog::logger* logger);
+	~ReplayDebugProbe();
+
+	bool startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) override;
+	bool stopAcqusition() override;
+	bool isValid() const override;
+	std::string getTargetName() override { return std::string("Replayed capture"); }
+
+	std::optional<IDebugProbe::varEntryType> readSingleEntry() override;
+
+	bool readMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+	bool writeMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+
+	std::string getLastErrorMsg() const override;
+	std::vector<std::string> getConnectedDevices() override;
+
+	/// @brief number of recorded records skipped because they did not match the requested reads
+	uint64_t getSkippedRecordCount() const { return skippedRecords; }
+
+   private:
+	struct Record
+	{
+		DebugProbeCapture::RecordType type = DebugProbeCapture::RecordType::START;
+		double time = 0.0;
+		uint32_t address = 0;
+		bool success = false;
+		std::vector<uint8_t> data;
+		varEntryType entry;
+	};
+
+	template <typename T>
+	bool read(T& value)
+	{
+		return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+
+	bool readHeader(Mode mode, const std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector);
+	bool readRecord();
+	void waitForRecordTime() const;
+	void endOfCapture();
+
+   private:
+	std::ifstream file;
+	Record record;
+	bool hasPendingEntry = false;
+	bool realTime = true;
+	std::chrono::steady_clock::time_point start;
+	uint64_t skippedRecords = 0;
+
+	spdlog::logger* logger;
+};
+
+#endif
@@ -0,0 +1,373 @@
+#include "SimulatedDebugProbe.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+SimulatedDebugProbe::SimulatedDebugProbe(spdlog::logger* logger) : logger(logger)
+{
+}
+
+SimulatedDebugProbe::~SimulatedDebugProbe()
+{
+	stopAcqusition();
+}
+
+bool SimulatedDebugProbe::startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency)
+{
+	stopAcqusition();
+
+	std::lock_guard<std::mutex> lock(mtx);
+	pages.clear();
+
+	if (!elfPath.empty() && !loadElfDataSection(elfPath))
+		logger->warn("Simulated probe could not load .data section of {}", elfPath);
+
+	generators = parseGenerators(probeSettings.simulationGenerators);
+	transactionLatency = std::chrono::microseconds(probeSettings.simulationLatencyUs);
+	bytesPerSecond = std::max(probeSettings.simulationBandwidthKBps, 1u) * 1000.0;
+	start = std::chrono::steady_clock::now();
+	lastErrorMsg = "";
+	isRunning = true;
+
+	logger->info("Simulated probe started with {} generators, latency {} us, bandwidth {} kB/s", generators.size(), probeSettings.simulationLatencyUs, probeSettings.simulationBandwidthKBps);
+
+	if (probeSettings.mode == Mode::HSS)
+	{
+		hssVariables = addressSizeVector;
+		varTable.clear();
+
+		/* the link bandwidth limits the reachable sampling rate */
+		uint32_t bytesPerSample = timestampSize;
+		for (auto& [address, size] : hssVariables)
+			bytesPerSample += size;
+
+		hssSamplingPeriod = std::max(1.0 / std::max(samplingFreqency, 1u), bytesPerSample / bytesPerSecond);
+		hssHandle = std::thread(&SimulatedDebugProbe::hssThread, this);
+	}
+	return true;
+}
+
+bool SimulatedDebugProbe::stopAcqusition()
+{
+	isRunning = false;
+	if (hssHandle.joinable())
+		hssHandle.join();
+	return true;
+}
+
+bool SimulatedDebugProbe::isValid() const
+{
+	return isRunning;
+}
+
+std::optional<IDebugProbe::varEntryType> SimulatedDebugProbe::readSingleEntry()
+{
+	varEntryType entry;
+	if (!varTable.tryPop(entry))
+		return std::nullopt;
+	return entry;
+}
+
+bool SimulatedDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	if (!isRunning)
+		return false;
+
+	waitForTransfer(size);
+
+	std::lock_guard<std::mutex> lock(mtx);
+	updateGenerators(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	readImage(address, buf, size);
+	return true;
+}
+
+bool SimulatedDebugProbe::readMemoryBatch(std::vector<ReadRequest>& requests)
+{
+	if (!isRunning)
+	{
+		for (auto& request : requests)
+			request.success = false;
+		return false;
+	}
+
+	/* the whole batch is a single transaction */
+	uint32_t bytes = 0;
+	for (auto& request : requests)
+		bytes += request.size;
+	waitForTransfer(bytes);
+
+	std::lock_guard<std::mutex> lock(mtx);
+	updateGenerators(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+	for (auto& request : requests)
+	{
+		readImage(request.address, request.dest, request.size);
+		request.success = true;
+	}
+	return true;
+}
+
+bool SimulatedDebugProbe::writeMemory(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	if (!isRunning)
+		return false;
+
+	waitForTransfer(size);
+
+	std::lock_guard<std::mutex> lock(mtx);
+	writeImage(address, buf, size);
+	return true;
+}
+
+std::string SimulatedDebugProbe::getLastErrorMsg() const
+{
+	return lastErrorMsg;
+}
+
+std::vector<std::string> SimulatedDebugProbe::getConnectedDevices()
+{
+	return std::vector<std::string>{"SIMULATED"};
+}
+
+void SimulatedDebugProbe::setElfFile(const std::string& path)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	elfPath = path;
+}
+
+std::vector<SimulatedDebugProbe::Generator> SimulatedDebugProbe::parseGenerators(const std::string& description)
+{
+	static const std::unordered_map<std::string, Generator::Type> types{{"sine", Generator::Type::SINE}, {"ramp", Generator::Type::RAMP}, {"counter", Generator::Type::COUNTER}, {"noise", Generator::Type::NOISE}, {"step", Generator::Type::STEP}};
+	static const std::unordered_map<std::string, Generator::Encoding> encodings{{"u8", Generator::Encoding::U8}, {"i8", Generator::Encoding::I8}, {"u16", Generator::Encoding::U16}, {"i16", Generator::Encoding::I16}, {"u32", Generator::Encoding::U32}, {"i32", Generator::Encoding::I32}, {"f32", Generator::Encoding::F32}};
+
+	std::vector<Generator> result;
+	std::stringstream entries(description);
+	std::string entry;
+
+	while (std::getline(entries, entry, ';'))
+	{
+		std::istringstream fields(entry);
+		std::vector<std::string> tokens{std::istream_iterator<std::string>(fields), std::istream_iterator<std::string>()};
+
+		if (tokens.size() < 2 || !types.contains(tokens[1]))
+			continue;
+
+		Generator generator{};
+		try
+		{
+			generator.address = static_cast<uint32_t>(std::stoul(tokens[0], nullptr, 0));
+			generator.type = types.at(tokens[1]);
+
+			size_t numbers = 0;
+			for (size_t i = 2; i < tokens.size(); i++)
+			{
+				if (encodings.contains(tokens[i]))
+				{
+					generator.encoding = encodings.at(tokens[i]);
+					continue;
+				}
+
+				double number = std::stod(tokens[i]);
+				if (numbers == 0)
+					generator.amplitude = number;
+				else if (numbers == 1)
+					generator.periodS = number;
+				else if (numbers == 2)
+					generator.offset = number;
+				numbers++;
+			}
+		}
+		catch (const std::exception&)
+		{
+			continue;
+		}
+
+		if (generator.periodS <= 0.0)
+			generator.periodS = 1.0;
+
+		result.push_back(generator);
+	}
+	return result;
+}
+
+bool SimulatedDebugProbe::loadElfDataSection(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+
+	std::vector<uint8_t> elf{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+	auto read16 = [&](size_t offset)
+	{ uint16_t value = 0; std::memcpy(&value, &elf[offset], sizeof(value)); return value; };
+	auto read32 = [&](size_t offset)
+	{ uint32_t value = 0; std::memcpy(&value, &elf[offset], sizeof(value)); return value; };
+
+	constexpr size_t headerSize = 52;
+	constexpr size_t sectionHeaderSize = 40;
+
+	/* ELF32, little endian */
+	if (elf.size() < headerSize || std::memcmp(elf.data(), "\x7f" "ELF", 4) != 0 || elf[4] != 1 || elf[5] != 1)
+		return false;
+
+	uint32_t sectionsOffset = read32(32);
+	uint16_t sectionsCount = read16(48);
+	uint16_t namesIndex = read16(50);
+
+	if (sectionsOffset + static_cast<size_t>(sectionsCount) * sectionHeaderSize > elf.size() || namesIndex >= sectionsCount)
+		return false;
+
+	auto section = [&](size_t index)
+	{ return sectionsOffset + index * sectionHeaderSize; };
+
+	uint32_t namesOffset = read32(section(namesIndex) + 16);
+
+	for (size_t i = 0; i < sectionsCount; i++)
+	{
+		size_t nameOffset = namesOffset + read32(section(i));
+		if (nameOffset >= elf.size() || std::strncmp(reinterpret_cast<const char*>(&elf[nameOffset]), ".data", elf.size() - nameOffset) != 0)
+			continue;
+
+		uint32_t address = read32(section(i) + 12);
+		uint32_t offset = read32(section(i) + 16);
+		uint32_t size = read32(section(i) + 20);
+
+		if (static_cast<size_t>(offset) + size > elf.size())
+			return false;
+
+		writeImage(address, &elf[offset], size);
+		logger->info("Simulated probe loaded {} bytes of .data at 0x{:08x}", size, address);
+		return true;
+	}
+	return false;
+}
+
+void SimulatedDebugProbe::writeImage(uint32_t address, const uint8_t* buf, uint32_t size)
+{
+	for (uint32_t i = 0; i < size; i++)
+	{
+		uint32_t byteAddress = address + i;
+		pages[byteAddress / pageSize][byteAddress % pageSize] = buf[i];
+	}
+}
+
+void SimulatedDebugProbe::readImage(uint32_t address, uint8_t* buf, uint32_t size) const
+{
+	for (uint32_t i = 0; i < size; i++)
+	{
+		uint32_t byteAddress = address + i;
+		auto page = pages.find(byteAddress / pageSize);
+		buf[i] = page == pages.end() ? 0 : page->second[byteAddress % pageSize];
+	}
+}
+
+void SimulatedDebugProbe::updateGenerators(double time)
+{
+	constexpr double pi = 3.14159265358979323846;
+	std::uniform_real_distribution<double> noise(-1.0, 1.0);
+
+	for (auto& generator : generators)
+	{
+		double phase = std::fmod(time, generator.periodS) / generator.periodS;
+		double value = generator.offset;
+
+		switch (generator.type)
+		{
+			case Generator::Type::SINE:
+				value += generator.amplitude * std::sin(2.0 * pi * phase);
+				break;
+			case Generator::Type::RAMP:
+				value += generator.amplitude * phase;
+				break;
+			case Generator::Type::COUNTER:
+				value += generator.amplitude * std::floor(time / generator.periodS);
+				break;
+			case Generator::Type::NOISE:
+				value += generator.amplitude * noise(randomGenerator);
+				break;
+			case Generator::Type::STEP:
+				value += phase < 0.5 ? 0.0 : generator.amplitude;
+				break;
+		}
+
+		uint8_t bytes[4]{};
+		uint32_t size = 4;
+		int64_t integer = static_cast<int64_t>(std::llround(value));
+
+		switch (generator.encoding)
+		{
+			case Generator::Encoding::U8:
+			case Generator::Encoding::I8:
+				size = 1;
+				bytes[0] = static_cast<uint8_t>(integer);
+				break;
+			case Generator::Encoding::U16:
+			case Generator::Encoding::I16:
+			{
+				size = 2;
+				uint16_t raw = static_cast<uint16_t>(integer);
+				std::memcpy(bytes, &raw, size);
+				break;
+			}
+			case Generator::Encoding::U32:
+			case Generator::Encoding::I32:
+			{
+				uint32_t raw = static_cast<uint32_t>(integer);
+				std::memcpy(bytes, &raw, size);
+				break;
+			}
+			case Generator::Encoding::F32:
+			{
+				float raw = static_cast<float>(value);
+				std::memcpy(bytes, &raw, size);
+				break;
+			}
+		}
+		writeImage(generator.address, bytes, size);
+	}
+}
+
+void SimulatedDebugProbe::waitForTransfer(uint32_t bytes) const
+{
+	auto transferTime = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(bytes / bytesPerSecond));
+	std::this_thread::sleep_until(std::chrono::steady_clock::now() + transactionLatency + transferTime);
+}
+
+void SimulatedDebugProbe::hssThread()
+{
+	double nextSample = 0.0;
+	auto transferDeadline = std::chrono::steady_clock::now();
+
+	/* the probe samples autonomously, the samples arrive in bursts once per USB transaction */
+	while (isRunning)
+	{
+		transferDeadline += std::max(transactionLatency, std::chrono::steady_clock::duration(std::chrono::microseconds(100)));
+		std::this_thread::sleep_until(transferDeadline);
+
+		double now = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		std::lock_guard<std::mutex> lock(mtx);
+		for (; nextSample <= now; nextSample += hssSamplingPeriod)
+		{
+			updateGenerators(nextSample);
+
+			/* drop the backlog when the reader does not keep up */
+			varEntryType* entry = varTable.claim();
+			if (entry == nullptr)
+			{
+				nextSample = now;
+				break;
+			}
+
+			entry->first = nextSample;
+			entry->second.assign(hssVariables.size(), 0);
+			for (size_t i = 0; i < hssVariables.size(); i++)
+				readImage(hssVariables[i].first, reinterpret_cast<uint8_t*>(&entry->second[i]), hssVariables[i].second);
+			varTable.publish();
+		}
+	}
+}
@@ -0,0 +1,111 @@
+#ifndef _SimulatedDebugProbe_HPP
+#define _SimulatedDebugProbe_HPP
+
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "IDebugProbe.hpp"
+#include "spdlog/spdlog.h"
+
+/// @brief Debug probe serving a virtual target memory image, for benchmarking and testing without hardware.
+/// The image is optionally initialized from the .data section of the project *.elf file and selected
+/// addresses are driven by signal generators. Every transaction is delayed according to a simple USB
+/// link model (fixed latency plus transfer time at a given bandwidth), both in NORMAL and HSS mode.
+class SimulatedDebugProbe : public IDebugProbe
+{
+   public:
+	struct Generator
+	{
+		enum class Type : uint8_t
+		{
+			SINE = 0,
+			RAMP = 1,	 /* sawtooth from offset to offset + amplitude */
+			COUNTER = 2, /* increments by amplitude every period */
+			NOISE = 3,	 /* uniform in offset +/- amplitude */
+			STEP = 4,	 /* square wave between offset and offset + amplitude */
+		};
+
+		enum class Encoding : uint8_t
+		{
+			U8 = 0,
+			I8 = 1,
+			U16 = 2,
+			I16 = 3,
+			U32 = 4,
+			I32 = 5,
+			F32 = 6,
+		};
+
+		uint32_t address = 0;
+		Type type = Type::SINE;
+		Encoding encoding = Encoding::F32;
+		double amplitude = 1.0;
+		double periodS = 1.0;
+		double offset = 0.0;
+	};
+
+	SimulatedDebugProbe(spdlog::logger* logger);
+	~SimulatedDebugProbe();
+
+	bool startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) override;
+	bool stopAcqusition() override;
+	bool isValid() const override;
+	std::string getTargetName() override { return std::string("Simulated target"); }
+
+	std::optional<IDebugProbe::varEntryType> readSingleEntry() override;
+
+	bool readMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+	bool writeMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+	bool readMemoryBatch(std::vector<ReadRequest>& requests) override;
+
+	std::string getLastErrorMsg() const override;
+	std::vector<std::string> getConnectedDevices() override;
+
+	/// @brief *.elf file whose .data section initializes the memory image on the next start
+	void setElfFile(const std::string& path);
+
+	/// @brief parses a ';' separated list of "<address> <sine|ramp|counter|noise|step> [amplitude] [period_s] [offset] [u8|i8|u16|i16|u32|i32|f32]"
+	static std::vector<Generator> parseGenerators(const std::string& description);
+
+	/// @brief loads the .data section of an ELF32 little-endian file into the memory image
+	bool loadElfDataSection(const std::string& path);
+
+	/// @brief direct access to the memory image, without the link model
+	void writeImage(uint32_t address, const uint8_t* buf, uint32_t size);
+	void readImage(uint32_t address, uint8_t* buf, uint32_t size) const;
+
+   private:
+	void updateGenerators(double time);
+	void waitForTransfer(uint32_t bytes) const;
+	void hssThread();
+
+   private:
+	static constexpr uint32_t pageSize = 4096;
+	static constexpr size_t fifoSize = 2000;
+	static constexpr uint32_t timestampSize = 8;
+
+	std::unordered_map<uint32_t, std::array<uint8_t, pageSize>> pages;
+	std::vector<Generator> generators;
+	std::mt19937 randomGenerator{1234};
+
+	std::string elfPath;
+	std::chrono::steady_clock::duration transactionLatency{};
+	double bytesPerSecond = 0.0;
+	std::chrono::steady_clock::time_point start;
+
+	std::vector<std::pair<uint32_t, uint8_t>> hssVariables;
+	double hssSamplingPeriod = 0.0;
+	std::thread hssHandle;
+	SpscRingBuffer<varEntryType> varTable{fifoSize};
+
+	spdlog::logger* logger;
+};
+
+#endif
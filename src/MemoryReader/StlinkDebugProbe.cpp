@@ -60,6 +60,10 @@ bool StlinkDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
 	if (!isRunning)
 		return false;
 
+	/* bulk reads (coalesced blocks) go through the mem32 USB transfer */
+	if (size > 4)
+		return readMem32(address, buf, size);
+
 	uint32_t valueRaw = 0;
 	uint8_t shouldShift = address % 4;
 
@@ -100,6 +104,39 @@ bool StlinkDebugProbe::readMemory(uint32_t address, uint8_t* buf, uint32_t size)
 	}
 	return result;
 }
+bool StlinkDebugProbe::readMemoryBatch(std::vector<ReadRequest>& requests)
+{
+	std::lock_guard<std::mutex> lock(mtx);
+	bool result = isRunning;
+
+	for (auto& request : requests)
+	{
+		request.success = isRunning && readMem32(request.address, request.dest, request.size);
+		result = result && request.success;
+	}
+	return result;
+}
+
+bool StlinkDebugProbe::readMem32(uint32_t address, uint8_t* buf, uint32_t size)
+{
+	/* mem32 transfers need an aligned address and length - the covering words are read and the requested bytes cut out of q_buf */
+	for (uint32_t offset = 0; offset < size;)
+	{
+		uint32_t chunkAddress = address + offset;
+		uint32_t chunkSize = std::min(size - offset, maxMem32ReadSize - 4);
+		uint32_t alignedStart = chunkAddress & ~3u;
+		uint32_t alignedEnd = (chunkAddress + chunkSize + 3) & ~3u;
+
+		if (stlink_read_mem32(sl, alignedStart, static_cast<uint16_t>(alignedEnd - alignedStart)) != 0)
+			return false;
+
+		uint8_t* chunkBegin = sl->q_buf + (chunkAddress - alignedStart);
+		std::copy(chunkBegin, chunkBegin + chunkSize, buf + offset);
+		offset += chunkSize;
+	}
+	return true;
+}
+
 bool StlinkDebugProbe::writeMemory(uint32_t address, uint8_t* buf, uint32_t size)
 {
 	std::lock_guard<std::mutex> lock(mtx);
@@ -22,11 +22,17 @@ class StlinkDebugProbe : public IDebugProbe
 	std::optional<IDebugProbe::varEntryType> readSingleEntry() override;
 	bool readMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
 	bool writeMemory(uint32_t address, uint8_t* buf, uint32_t size) override;
+	bool readMemoryBatch(std::vector<ReadRequest>& requests) override;
 
 	std::string getLastErrorMsg() const override;
 	std::vector<std::string> getConnectedDevices() override;
 
    private:
+	bool readMem32(uint32_t address, uint8_t* buf, uint32_t size);
+
+   private:
+	/* max single mem32 transfer supported by the ST-Link firmware */
+	static constexpr uint32_t maxMem32ReadSize = 6144;
 	stlink_t* sl = nullptr;
 	spdlog::logger* logger;
 };
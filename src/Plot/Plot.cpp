@@ -12,7 +12,8 @@
 
 Plot::Plot(const std::string& name) : name(name)
 {
-	xAxisSeries.buffer = std::make_unique<ScrollingBuffer<double>>();
+	time = std::make_shared<ScrollingBuffer<double>>();
+	xAxisSeries.buffer = std::make_shared<ScrollingBuffer<double>>();
 }
 
 void Plot::setName(const std::string& newName)
@@ -44,7 +45,7 @@ bool Plot::addSeries(Variable* var)
 {
 	std::string name = var->getName();
 	seriesMap[name] = std::make_shared<Series>();
-	seriesMap[name]->buffer = std::make_unique<ScrollingBuffer<double>>();
+	seriesMap[name]->buffer = std::make_shared<ScrollingBuffer<double>>();
 	seriesMap[name]->var = var;
 	return true;
 }
@@ -66,7 +67,54 @@ ScrollingBuffer<double>* Plot::getXAxisSeries()
 		if (xAxisSeries.var != nullptr)
 			return xAxisSeries.buffer.get();
 	}
-	return &time;
+	return time.get();
+}
+
+ScrollingBuffer<double>* Plot::getTimeSeries()
+{
+	return time.get();
+}
+
+void Plot::setTimeSeries(std::shared_ptr<ScrollingBuffer<double>> column, std::shared_ptr<CompressedHistory> history)
+{
+	time = column;
+	timeHistory = history;
+}
+
+void Plot::setTimeHistory(std::shared_ptr<CompressedHistory> history)
+{
+	timeHistory = history;
+}
+
+CompressedHistory* Plot::getTimeHistory()
+{
+	return timeHistory.get();
+}
+
+Plot::Series* Plot::getXAxisVariableSeries()
+{
+	return &xAxisSeries;
+}
+
+void Plot::freeze(const std::string& overlayName)
+{
+	Overlay overlay;
+	overlay.name = overlayName;
+	overlay.time = time->freeze();
+	for (auto& [name, ser] : seriesMap)
+		overlay.seriesMap[name].values = ser->buffer->freeze();
+	overlays.push_back(std::move(overlay));
+}
+
+std::vector<Plot::Overlay>& Plot::getOverlays()
+{
+	return overlays;
+}
+
+void Plot::removeOverlay(size_t index)
+{
+	if (index < overlays.size())
+		overlays.erase(overlays.begin() + index);
 }
 
 bool Plot::removeSeries(const std::string& name)
@@ -135,13 +183,13 @@ void Plot::updateSeries()
 
 bool Plot::addTimePoint(double t)
 {
-	time.addPoint(t);
+	time->addPoint(t);
 	return true;
 }
 
 void Plot::erase()
 {
-	time.erase();
+	time->erase();
 	xAxisSeries.buffer->erase();
 
 	for (auto& [name, ser] : seriesMap)
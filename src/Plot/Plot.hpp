@@ -9,6 +9,8 @@
 #include <thread>
 #include <vector>
 
+#include "CompressedHistory.hpp"
+#include "MinMaxPyramid.hpp"
 #include "ScrollingBuffer.hpp"
 #include "Variable.hpp"
 
@@ -25,7 +27,12 @@ class Plot
 	{
 		Variable* var = nullptr;
 		displayFormat format = displayFormat::DEC;
-		std::unique_ptr<ScrollingBuffer<double>> buffer;
+		/* owned by the series or shared with other plots through a sample store column */
+		std::shared_ptr<ScrollingBuffer<double>> buffer;
+		/* complete history of the column, only when bound to a sample store keeping one */
+		std::shared_ptr<CompressedHistory> history;
+		/* level of detail pyramid of the buffer snapshot, maintained by the GUI */
+		MinMaxPyramid<double> lod;
 		bool visible = true;
 
 		void addPointFromVar() { buffer->addPoint(var->getValue()); }
@@ -96,6 +103,25 @@ class Plot
 		double value;
 	};
 
+	/// @brief points of the plot frozen at some moment, drawn over the live series for comparison
+	struct Overlay
+	{
+		struct Series
+		{
+			ScrollingBuffer<double>::Frozen values;
+			/* decimated points of the last drawn view, maintained by the GUI */
+			std::vector<double> xs;
+			std::vector<double> ys;
+			double xMin = 0.0;
+			double xMax = 0.0;
+			uint32_t maxBuckets = 0;
+		};
+
+		std::string name;
+		ScrollingBuffer<double>::Frozen time;
+		std::map<std::string, Series> seriesMap;
+	};
+
 	Marker markerX0{};
 	Marker markerX1{};
 	Marker trigger{};
@@ -112,6 +138,17 @@ class Plot
 	std::shared_ptr<Plot::Series> getSeries(const std::string& name);
 	std::map<std::string, std::shared_ptr<Plot::Series>>& getSeriesMap();
 	ScrollingBuffer<double>* getXAxisSeries();
+	ScrollingBuffer<double>* getTimeSeries();
+	/// @brief replaces the time buffer, used to share a single time column between plots
+	void setTimeSeries(std::shared_ptr<ScrollingBuffer<double>> column, std::shared_ptr<CompressedHistory> history = nullptr);
+	void setTimeHistory(std::shared_ptr<CompressedHistory> history);
+	CompressedHistory* getTimeHistory();
+	Series* getXAxisVariableSeries();
+	/// @brief adds an overlay sharing the current points of the time and series buffers, without copying
+	/// them - has to be called with the acquisition stopped or under its lock
+	void freeze(const std::string& overlayName);
+	std::vector<Overlay>& getOverlays();
+	void removeOverlay(size_t index);
 	bool removeSeries(const std::string& name);
 	bool removeAllVariables();
 	void renameSeries(const std::string& oldName, const std::string newName);
@@ -151,8 +188,10 @@ class Plot
 	std::string name;
 	std::string alias;
 	std::map<std::string, std::shared_ptr<Series>> seriesMap;
-	ScrollingBuffer<double> time;
+	std::shared_ptr<ScrollingBuffer<double>> time;
+	std::shared_ptr<CompressedHistory> timeHistory;
 	Series xAxisSeries;
+	std::vector<Overlay> overlays;
 	bool visibility = true;
 	Type type = Type::CURVE;
 	Domain domain = Domain::ANALOG;
@@ -47,9 +47,87 @@ bool PlotHandler::eraseAllPlotData()
 		if (plot.second != nullptr)
 			plot.second->erase();
 
+	/* buffers are allocated again from the pool and the fresh arena once they receive points, the chunks
+	of the previous acquisition are reused unless a frozen view still holds them */
+	for (auto& [name, plt] : plotsMap)
+	{
+		if (plt == nullptr)
+			continue;
+
+		for (auto& [serName, ser] : plt->getSeriesMap())
+		{
+			ser->buffer->release();
+			ser->buffer->setArena(&arena);
+			ser->buffer->setChunkPool(chunkPool);
+		}
+		for (auto buffer : {plt->getTimeSeries(), plt->getXAxisVariableSeries()->buffer.get()})
+		{
+			buffer->release();
+			buffer->setArena(&arena);
+			buffer->setChunkPool(chunkPool);
+		}
+	}
+	arena.reset();
+
 	return true;
 }
 
+void PlotHandler::shareColumns(bool keepHistory, const std::string& spillDirectory, bool storeRawSamples)
+{
+	store.clear();
+	store.setArena(&arena);
+	store.setPackingEnabled(storeRawSamples);
+	store.setChunkPool(chunkPool);
+	store.setHistoryEnabled(keepHistory);
+	store.setSpillDirectory(keepHistory ? SpillDirectory::create(spillDirectory) : nullptr);
+
+	for (auto& [name, plt] : plotsMap)
+	{
+		if (plt == nullptr)
+			continue;
+
+		plt->setTimeSeries(store.getTimeColumn(), store.getTimeHistory());
+		for (auto& [serName, ser] : plt->getSeriesMap())
+		{
+			ser->buffer = store.getColumn(ser->var);
+			ser->history = store.getHistory(ser->var);
+		}
+
+		auto xAxisSeries = plt->getXAxisVariableSeries();
+		if (xAxisSeries->var != nullptr)
+		{
+			xAxisSeries->buffer = store.getColumn(xAxisSeries->var);
+			xAxisSeries->history = store.getHistory(xAxisSeries->var);
+		}
+	}
+}
+
+void PlotHandler::createHistories(bool keepHistory, const std::string& spillDirectory, bool visibleOnly)
+{
+	std::shared_ptr<SpillDirectory> directory = keepHistory ? SpillDirectory::create(spillDirectory) : nullptr;
+	uint32_t index = 0;
+
+	auto makeHistory = [&](bool keep, CompressedHistory::Encoding encoding) -> std::shared_ptr<CompressedHistory>
+	{
+		if (!keep)
+			return nullptr;
+		auto history = std::make_shared<CompressedHistory>(encoding);
+		history->setSpill(directory, "history" + std::to_string(index++));
+		return history;
+	};
+
+	for (auto& [name, plt] : plotsMap)
+	{
+		if (plt == nullptr)
+			continue;
+
+		bool keep = keepHistory && (!visibleOnly || plt->getVisibility());
+		plt->setTimeHistory(makeHistory(keep, CompressedHistory::Encoding::DELTA_OF_DELTA));
+		for (auto& [serName, ser] : plt->getSeriesMap())
+			ser->history = makeHistory(keep, CompressedHistory::Encoding::XOR);
+	}
+}
+
 uint32_t PlotHandler::getVisiblePlotsCount() const
 {
 	return std::count_if(plotsMap.begin(), plotsMap.end(), [](const auto& pair)
@@ -71,11 +149,14 @@ void PlotHandler::setMaxPoints(uint32_t maxPoints)
 	if (maxPoints == 0)
 		return;
 
+	store.setMaxPoints(maxPoints);
+
 	for (auto& [name, plt] : plotsMap)
 	{
 		for (auto& [serName, ser] : plt->getSeriesMap())
 			ser->buffer->setMaxSize(maxPoints);
-		plt->getXAxisSeries()->setMaxSize(maxPoints);
+		plt->getTimeSeries()->setMaxSize(maxPoints);
+		plt->getXAxisVariableSeries()->buffer->setMaxSize(maxPoints);
 	}
 }
 
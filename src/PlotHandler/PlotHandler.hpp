@@ -3,24 +3,46 @@
 #include <chrono>
 #include <map>
 #include <mutex>
+#include <string>
 #include <thread>
 
+#include "BufferArena.hpp"
+#include "ChunkPool.hpp"
 #include "Plot.hpp"
+#include "SampleStore.hpp"
 #include "ScrollingBuffer.hpp"
 
 class PlotHandler
 {
    public:
+	static constexpr uint32_t maxPointsLimit = 10000000;
+
 	std::shared_ptr<Plot> addPlot(const std::string& name);
 	bool removePlot(const std::string& name);
 	bool renamePlot(const std::string& oldName, const std::string& newName);
 	bool removeAllPlots();
 	std::shared_ptr<Plot> getPlot(std::string name);
+	/// @brief erases all points and frees the buffers of the previous acquisition in bulk
 	bool eraseAllPlotData();
 	uint32_t getVisiblePlotsCount() const;
 	uint32_t getPlotsCount() const;
 	bool checkIfPlotExists(const std::string& name) const;
 	void setMaxPoints(uint32_t maxPoints);
+	const BufferArena& getArena() const { return arena; }
+	const ChunkPool<double>& getChunkPool() const { return *chunkPool; }
+
+	/// @brief binds the time and series buffers of all plots to fresh columns of the sample store, so that
+	/// a variable shown in several plots is stored and appended once - called after eraseAllPlotData
+	/// @param keepHistory columns additionally keep their complete compressed history
+	/// @param spillDirectory where the session directory of the history segment files is created, empty for the system temporary directory
+	/// @param storeRawSamples variable columns keep the raw words in their native width, decoded when read
+	void shareColumns(bool keepHistory = false, const std::string& spillDirectory = "", bool storeRawSamples = false);
+
+	/// @brief gives the time and series buffers of all plots, which are not shared, their own fresh compressed
+	/// histories or drops them - called after eraseAllPlotData
+	/// @param visibleOnly hidden plots get no history, for the handlers that do not feed them
+	void createHistories(bool keepHistory, const std::string& spillDirectory = "", bool visibleOnly = false);
+	const SampleStore& getSampleStore() const { return store; }
 
 	class iterator
 	{
@@ -41,5 +63,10 @@ class PlotHandler
 	iterator end();
 
    protected:
+	/* declared first so that it outlives the buffers */
+	BufferArena arena;
+	/* the ring buffers are built from its chunks, frozen views keep theirs alive across acquisitions */
+	std::shared_ptr<ChunkPool<double>> chunkPool = std::make_shared<ChunkPool<double>>();
+	SampleStore store;
 	std::map<std::string, std::shared_ptr<Plot>> plotsMap;
 };
@@ -0,0 +1,100 @@
+#include "SampleStore.hpp"
+
+#include "SampleDecoder.hpp"
+
+SampleStore::Column SampleStore::getTimeColumn()
+{
+	if (time.column == nullptr)
+		time = makeEntry(CompressedHistory::Encoding::DELTA_OF_DELTA, "time");
+	return time.column;
+}
+
+SampleStore::Column SampleStore::getColumn(Variable* var)
+{
+	auto& entry = columns[var];
+	if (entry.column == nullptr)
+	{
+		entry = makeEntry(CompressedHistory::Encoding::XOR, "column" + std::to_string(columns.size()));
+		/* variables that cannot be decoded later keep plain columns */
+		if (packingEnabled)
+			entry.column->setCodec(SampleDecoder::create(*var));
+	}
+	return entry.column;
+}
+
+SampleStore::History SampleStore::getTimeHistory()
+{
+	getTimeColumn();
+	return time.history;
+}
+
+SampleStore::History SampleStore::getHistory(Variable* var)
+{
+	getColumn(var);
+	return columns[var].history;
+}
+
+void SampleStore::setHistoryEnabled(bool enabled)
+{
+	historyEnabled = enabled;
+}
+
+void SampleStore::setPackingEnabled(bool enabled)
+{
+	packingEnabled = enabled;
+}
+
+void SampleStore::setSpillDirectory(std::shared_ptr<SpillDirectory> directory)
+{
+	spillDirectory = std::move(directory);
+}
+
+void SampleStore::clear()
+{
+	time = Entry{};
+	columns.clear();
+}
+
+size_t SampleStore::getColumnCount() const
+{
+	return columns.size();
+}
+
+void SampleStore::setMaxPoints(uint32_t newMaxPoints)
+{
+	if (newMaxPoints == 0)
+		return;
+
+	maxPoints = newMaxPoints;
+
+	if (time.column != nullptr)
+		time.column->setMaxSize(maxPoints);
+	for (auto& [var, entry] : columns)
+		entry.column->setMaxSize(maxPoints);
+}
+
+void SampleStore::setArena(BufferArena* newArena)
+{
+	arena = newArena;
+}
+
+void SampleStore::setChunkPool(std::shared_ptr<ChunkPool<double>> newPool)
+{
+	chunkPool = std::move(newPool);
+}
+
+SampleStore::Entry SampleStore::makeEntry(CompressedHistory::Encoding encoding, const std::string& name)
+{
+	Entry entry;
+	entry.column = std::make_shared<ScrollingBuffer<double>>();
+	entry.column->setMaxSize(maxPoints);
+	entry.column->setArena(arena);
+	entry.column->setChunkPool(chunkPool);
+
+	if (historyEnabled)
+	{
+		entry.history = std::make_shared<CompressedHistory>(encoding);
+		entry.history->setSpill(spillDirectory, name);
+	}
+	return entry;
+}
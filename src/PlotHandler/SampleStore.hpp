@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "BufferArena.hpp"
+#include "ChunkPool.hpp"
+#include "CompressedHistory.hpp"
+#include "ScrollingBuffer.hpp"
+#include "Variable.hpp"
+
+/// @brief Columnar storage of an acquisition - a single time column and one column per variable.
+/// Plots and series reference the columns instead of owning buffers, so a variable shown in several
+/// plots is stored and appended once and all plots share the same timestamps. Optionally every column
+/// also keeps its complete compressed history next to the ring buffer of the newest points, and the
+/// variable columns can be packed to the native width of the variables.
+class SampleStore
+{
+   public:
+	using Column = std::shared_ptr<ScrollingBuffer<double>>;
+	using History = std::shared_ptr<CompressedHistory>;
+
+	/// @brief time column shared by all plots bound to the store
+	Column getTimeColumn();
+
+	/// @brief column of the variable, created on the first request
+	Column getColumn(Variable* var);
+
+	/// @brief compressed histories of the columns, nullptr unless enabled when the columns were created
+	History getTimeHistory();
+	History getHistory(Variable* var);
+
+	void setHistoryEnabled(bool enabled);
+
+	/// @brief the variable columns created from now on store the raw words in their native width and are
+	/// decoded by the readers, see SampleDecoder
+	void setPackingEnabled(bool enabled);
+
+	/// @brief directory the histories created from now on spill their sealed segments to, nullptr keeps them in RAM
+	void setSpillDirectory(std::shared_ptr<SpillDirectory> directory);
+
+	/// @brief forgets all columns, the plots keep the ones they reference until they are bound again
+	void clear();
+
+	size_t getColumnCount() const;
+
+	/// @brief applies to the existing and to the future columns
+	void setMaxPoints(uint32_t newMaxPoints);
+
+	/// @brief arena the future columns are allocated from
+	void setArena(BufferArena* newArena);
+
+	/// @brief pool the chunks of the future columns are drawn from
+	void setChunkPool(std::shared_ptr<ChunkPool<double>> newPool);
+
+   private:
+	struct Entry
+	{
+		Column column;
+		History history;
+	};
+
+	Entry makeEntry(CompressedHistory::Encoding encoding, const std::string& name);
+
+   private:
+	uint32_t maxPoints = 10000;
+	BufferArena* arena = nullptr;
+	std::shared_ptr<ChunkPool<double>> chunkPool;
+	bool historyEnabled = false;
+	bool packingEnabled = false;
+	std::shared_ptr<SpillDirectory> spillDirectory;
+	Entry time;
+	std::unordered_map<Variable*, Entry> columns;
+};
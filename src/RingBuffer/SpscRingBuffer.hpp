@@ -0,0 +1,243 @@
+#ifndef _SPSCRINGBUFFER_HPP
+#define _SPSCRINGBUFFER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/// @brief Preallocated lock-free single-producer/single-consumer ring. The producer fills slots in place
+/// (claim/publish) and the consumer processes them in place (front/pop), so no allocation or copy happens
+/// on the hot path. The capacity is rounded up to a power of two. When the ring is full, new items are
+/// dropped and counted as overflows so that the producer never blocks. With blockingWait the consumer can
+/// sleep in waitForData instead of polling - the producer then only takes the lock to wake it up when it
+/// is actually waiting, so pushing stays lock-free.
+template <typename T>
+class SpscRingBuffer
+{
+   public:
+	static constexpr size_t cacheLineSize = 64;
+
+	explicit SpscRingBuffer(size_t minCapacity, bool blockingWait = false) : buffer(roundUpToPowerOfTwo(minCapacity)), mask(buffer.size() - 1), blockingWait(blockingWait) {}
+
+	/* producer side - returns the slot to fill or nullptr if the ring is full */
+	T* claim()
+	{
+		size_t head = writeIdx.load(std::memory_order_relaxed);
+		if (head - cachedReadIdx == buffer.size())
+		{
+			cachedReadIdx = readIdx.load(std::memory_order_acquire);
+			if (head - cachedReadIdx == buffer.size())
+			{
+				overflows.fetch_add(1, std::memory_order_relaxed);
+				return nullptr;
+			}
+		}
+		return &buffer[head & mask];
+	}
+
+	/* producer side - makes the claimed slot visible to the consumer */
+	void publish()
+	{
+		publish(1);
+	}
+
+	bool push(const T& item)
+	{
+		T* slot = claim();
+		if (slot == nullptr)
+			return false;
+		*slot = item;
+		publish();
+		return true;
+	}
+
+	/* producer side - copies as many items as fit, the rest are dropped and counted as overflows */
+	size_t pushN(const T* items, size_t count)
+	{
+		size_t head = writeIdx.load(std::memory_order_relaxed);
+		size_t free = buffer.size() - (head - cachedReadIdx);
+		if (free < count)
+		{
+			cachedReadIdx = readIdx.load(std::memory_order_acquire);
+			free = buffer.size() - (head - cachedReadIdx);
+		}
+
+		size_t pushed = std::min(count, free);
+		if (pushed < count)
+			overflows.fetch_add(count - pushed, std::memory_order_relaxed);
+		if (pushed == 0)
+			return 0;
+
+		size_t first = head & mask;
+		size_t tail = std::min(pushed, buffer.size() - first);
+		std::copy(items, items + tail, &buffer[first]);
+		std::copy(items + tail, items + pushed, &buffer[0]);
+		publish(pushed);
+		return pushed;
+	}
+
+	/* consumer side - returns the oldest slot or nullptr if the ring is empty */
+	T* front()
+	{
+		size_t tail = readIdx.load(std::memory_order_relaxed);
+		if (tail == cachedWriteIdx)
+		{
+			cachedWriteIdx = writeIdx.load(std::memory_order_acquire);
+			if (tail == cachedWriteIdx)
+				return nullptr;
+		}
+		return &buffer[tail & mask];
+	}
+
+	/* consumer side - releases the slot returned by front */
+	void pop()
+	{
+		readIdx.store(readIdx.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+	}
+
+	/* consumer side - moves the oldest item out, false if the ring is empty */
+	bool tryPop(T& item)
+	{
+		T* slot = front();
+		if (slot == nullptr)
+			return false;
+		item = std::move(*slot);
+		pop();
+		return true;
+	}
+
+	/* consumer side - copies up to maxCount of the oldest items, returns the number copied */
+	size_t popN(T* items, size_t maxCount)
+	{
+		size_t tail = readIdx.load(std::memory_order_relaxed);
+		size_t available = cachedWriteIdx - tail;
+		if (available < maxCount)
+		{
+			cachedWriteIdx = writeIdx.load(std::memory_order_acquire);
+			available = cachedWriteIdx - tail;
+		}
+
+		size_t popped = std::min(maxCount, available);
+		size_t first = tail & mask;
+		size_t run = std::min(popped, buffer.size() - first);
+		std::copy(&buffer[first], &buffer[first] + run, items);
+		std::copy(&buffer[0], &buffer[0] + (popped - run), items + run);
+
+		readIdx.store(tail + popped, std::memory_order_release);
+		return popped;
+	}
+
+	/* consumer side - drops all items */
+	void clear()
+	{
+		cachedWriteIdx = writeIdx.load(std::memory_order_acquire);
+		readIdx.store(cachedWriteIdx, std::memory_order_release);
+	}
+
+	/* consumer side - waits until the ring is not empty or the timeout passes, requires blockingWait */
+	bool waitForData(std::chrono::microseconds timeout)
+	{
+		if (front() != nullptr)
+			return true;
+
+		std::unique_lock<std::mutex> lock(waitMutex);
+		consumerWaiting.store(true, std::memory_order_relaxed);
+		/* pairs with the fence in publish so that either the producer sees the flag or the consumer sees the item */
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		bool ready = waitCondition.wait_for(lock, timeout, [this]()
+											{ return writeIdx.load(std::memory_order_acquire) != readIdx.load(std::memory_order_relaxed); });
+		consumerWaiting.store(false, std::memory_order_relaxed);
+		return ready;
+	}
+
+	size_t size() const
+	{
+		size_t tail = readIdx.load(std::memory_order_acquire);
+		return writeIdx.load(std::memory_order_acquire) - tail;
+	}
+
+	size_t capacity() const
+	{
+		return buffer.size();
+	}
+
+	size_t getMaxDepth() const
+	{
+		return maxDepth.load(std::memory_order_relaxed);
+	}
+
+	uint64_t getOverflowCount() const
+	{
+		return overflows.load(std::memory_order_relaxed);
+	}
+
+	void resetStatistics()
+	{
+		maxDepth = 0;
+		overflows = 0;
+	}
+
+	/* gives access to all slots, e.g. to preallocate them - only allowed while the ring is empty and both sides are idle */
+	template <typename F>
+	void forEachSlot(F&& function)
+	{
+		for (auto& slot : buffer)
+			function(slot);
+	}
+
+   private:
+	void publish(size_t count)
+	{
+		size_t head = writeIdx.load(std::memory_order_relaxed) + count;
+		writeIdx.store(head, std::memory_order_release);
+
+		size_t depth = head - readIdx.load(std::memory_order_relaxed);
+		if (depth > maxDepth.load(std::memory_order_relaxed))
+			maxDepth.store(depth, std::memory_order_relaxed);
+
+		if (!blockingWait)
+			return;
+
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (consumerWaiting.load(std::memory_order_relaxed))
+		{
+			std::lock_guard<std::mutex> lock(waitMutex);
+			waitCondition.notify_one();
+		}
+	}
+
+	static size_t roundUpToPowerOfTwo(size_t value)
+	{
+		size_t result = 1;
+		while (result < value)
+			result <<= 1;
+		return result;
+	}
+
+   private:
+	std::vector<T> buffer;
+	const size_t mask;
+	const bool blockingWait;
+
+	/* producer owned */
+	alignas(cacheLineSize) std::atomic<size_t> writeIdx = 0;
+	size_t cachedReadIdx = 0;
+	std::atomic<size_t> maxDepth = 0;
+	std::atomic<uint64_t> overflows = 0;
+
+	/* consumer owned */
+	alignas(cacheLineSize) std::atomic<size_t> readIdx = 0;
+	size_t cachedWriteIdx = 0;
+
+	/* read by the producer on every publish with blockingWait, the lock is only taken when the consumer sleeps */
+	alignas(cacheLineSize) std::atomic<bool> consumerWaiting = false;
+	std::mutex waitMutex;
+	std::condition_variable waitCondition;
+};
+
+#endif
@@ -0,0 +1,80 @@
+#ifndef __BUFFERARENA_HPP
+#define __BUFFERARENA_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// @brief Monotonic allocator backing the plot buffers of a single acquisition. Memory is handed out
+/// from large chunks and is never returned piece by piece - reset() frees everything at once, so the
+/// users have to drop their pointers before (see PlotHandler::eraseAllPlotData).
+class BufferArena
+{
+   public:
+	explicit BufferArena(size_t chunkSize = defaultChunkSize) : chunkSize(chunkSize) {}
+
+	void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t))
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+
+		size_t start = (used + alignment - 1) & ~(alignment - 1);
+		if (chunks.empty() || start + bytes > currentChunkSize)
+		{
+			/* large buffers get a chunk of their own */
+			currentChunkSize = std::max(chunkSize, bytes + alignment);
+			chunks.push_back(std::make_unique_for_overwrite<std::byte[]>(currentChunkSize));
+			reservedBytes += currentChunkSize;
+
+			uintptr_t base = reinterpret_cast<uintptr_t>(chunks.back().get());
+			start = ((base + alignment - 1) & ~(alignment - 1)) - base;
+		}
+
+		used = start + bytes;
+		allocatedBytes += bytes;
+		return chunks.back().get() + start;
+	}
+
+	template <typename T>
+	T* allocate(size_t count)
+	{
+		return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+	}
+
+	void reset()
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		chunks.clear();
+		used = 0;
+		currentChunkSize = 0;
+		allocatedBytes = 0;
+		reservedBytes = 0;
+	}
+
+	size_t getAllocatedBytes() const
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		return allocatedBytes;
+	}
+
+	size_t getReservedBytes() const
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		return reservedBytes;
+	}
+
+   private:
+	static constexpr size_t defaultChunkSize = 4 * 1024 * 1024;
+
+	mutable std::mutex mtx;
+	size_t chunkSize;
+	std::vector<std::unique_ptr<std::byte[]>> chunks;
+	size_t currentChunkSize = 0;
+	size_t used = 0;
+	size_t allocatedBytes = 0;
+	size_t reservedBytes = 0;
+};
+
+#endif
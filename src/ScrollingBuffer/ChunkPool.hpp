@@ -0,0 +1,106 @@
+#ifndef __CHUNKPOOL_HPP
+#define __CHUNKPOOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/// @brief Pool of fixed-size chunks the ring buffers are built from. Chunks are reference counted and the
+/// last reference returns them to the pool instead of the heap, so a restarted acquisition reuses the memory
+/// of the previous one and a frozen view keeps its chunks alive after the buffer has moved on. The chunks
+/// keep the pool alive, it can be dropped by its users at any time.
+template <typename T>
+class ChunkPool : public std::enable_shared_from_this<ChunkPool<T>>
+{
+   public:
+	using Chunk = std::shared_ptr<T>;
+
+	ChunkPool() = default;
+	ChunkPool(const ChunkPool&) = delete;
+	ChunkPool& operator=(const ChunkPool&) = delete;
+
+	~ChunkPool()
+	{
+		for (auto& [size, chunks] : idle)
+			for (T* chunk : chunks)
+				delete[] chunk;
+	}
+
+	/// @brief chunk of size points, uninitialized, the pool has to be owned by a shared_ptr
+	Chunk acquire(uint32_t size)
+	{
+		T* chunk = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(mtx);
+			auto& chunks = idleOfSize(size);
+			if (!chunks.empty())
+			{
+				chunk = chunks.back();
+				chunks.pop_back();
+				idleBytes -= size * sizeof(T);
+			}
+			else
+				allocatedBytes += size * sizeof(T);
+		}
+
+		if (chunk == nullptr)
+			chunk = new T[size];
+
+		return Chunk(chunk, [pool = this->shared_from_this(), size](T* chunk)
+					 { pool->recycle(chunk, size); });
+	}
+
+	/// @brief frees the idle chunks
+	void trim()
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		for (auto& [size, chunks] : idle)
+			for (T* chunk : chunks)
+				delete[] chunk;
+		idle.clear();
+		allocatedBytes -= idleBytes;
+		idleBytes = 0;
+	}
+
+	/// @brief bytes of all chunks, in use or idle
+	size_t getAllocatedBytes() const
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		return allocatedBytes;
+	}
+
+	size_t getIdleBytes() const
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		return idleBytes;
+	}
+
+   private:
+	void recycle(T* chunk, uint32_t size)
+	{
+		std::lock_guard<std::mutex> lock(mtx);
+		idleOfSize(size).push_back(chunk);
+		idleBytes += size * sizeof(T);
+	}
+
+	/* the buffers use one chunk size and a smaller one for the tail of the ring, a linear search is enough */
+	std::vector<T*>& idleOfSize(uint32_t size)
+	{
+		auto it = std::find_if(idle.begin(), idle.end(), [size](const auto& entry)
+							   { return entry.first == size; });
+		if (it != idle.end())
+			return it->second;
+		return idle.emplace_back(size, std::vector<T*>()).second;
+	}
+
+   private:
+	mutable std::mutex mtx;
+	std::vector<std::pair<uint32_t, std::vector<T*>>> idle;
+	size_t allocatedBytes = 0;
+	size_t idleBytes = 0;
+};
+
+#endif
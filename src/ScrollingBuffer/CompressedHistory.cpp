@@ -0,0 +1,523 @@
+#include "CompressedHistory.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace
+{
+
+constexpr double nsPerSecond = 1e9;
+
+int64_t toNanoseconds(double seconds)
+{
+	return std::llround(seconds * nsPerSecond);
+}
+
+double toSeconds(int64_t nanoseconds)
+{
+	return static_cast<double>(nanoseconds) / nsPerSecond;
+}
+
+int64_t signExtend(uint64_t value, uint32_t bits)
+{
+	uint32_t shift = 64 - bits;
+	return static_cast<int64_t>(value << shift) >> shift;
+}
+
+bool fitsSigned(int64_t value, uint32_t bits)
+{
+	int64_t limit = int64_t{1} << (bits - 1);
+	return value >= -limit && value < limit;
+}
+
+/* bits are appended MSB first */
+class BitWriter
+{
+   public:
+	explicit BitWriter(std::vector<uint64_t>& words) : words(words)
+	{
+		words.clear();
+	}
+
+	void write(uint64_t value, uint32_t bits)
+	{
+		if (bits < 64)
+			value &= (uint64_t{1} << bits) - 1;
+
+		uint32_t used = bitCount % 64;
+		if (used == 0)
+			words.push_back(0);
+
+		uint32_t free = 64 - used;
+		if (bits <= free)
+			words.back() |= bits == 64 ? value : value << (free - bits);
+		else
+		{
+			uint32_t remaining = bits - free;
+			words.back() |= value >> remaining;
+			words.push_back(value << (64 - remaining));
+		}
+		bitCount += bits;
+	}
+
+   private:
+	std::vector<uint64_t>& words;
+	uint64_t bitCount = 0;
+};
+
+class BitReader
+{
+   public:
+	explicit BitReader(const uint64_t* words) : words(words) {}
+
+	uint64_t read(uint32_t bits)
+	{
+		uint64_t word = words[position / 64];
+		uint32_t used = position % 64;
+		uint32_t free = 64 - used;
+		uint64_t result;
+
+		if (bits <= free)
+			result = (word << used) >> (64 - bits);
+		else
+		{
+			uint32_t remaining = bits - free;
+			result = (((word << used) >> used) << remaining) | (words[position / 64 + 1] >> (64 - remaining));
+		}
+		position += bits;
+		return result;
+	}
+
+	bool readBit()
+	{
+		return read(1) != 0;
+	}
+
+   private:
+	const uint64_t* words;
+	uint64_t position = 0;
+};
+
+}  // namespace
+
+CompressedHistory::CompressedHistory(Encoding encoding) : encoding(encoding)
+{
+	tail.reserve(blockSize);
+}
+
+void CompressedHistory::append(double value)
+{
+	/* the tail holds what the decoder would return */
+	if (encoding == Encoding::DELTA_OF_DELTA)
+		value = toSeconds(toNanoseconds(value));
+
+	tail.push_back(value);
+	if (tail.size() == blockSize)
+		seal();
+}
+
+void CompressedHistory::clear()
+{
+	blocks.clear();
+	tail.clear();
+	segments.clear();
+	firstUnspilled = 0;
+	unspilledBytes = 0;
+}
+
+void CompressedHistory::setSpill(std::shared_ptr<SpillDirectory> directory, const std::string& name, size_t newSegmentBytes)
+{
+	spillDirectory = std::move(directory);
+	spillName = name;
+	segmentBytes = newSegmentBytes;
+	firstUnspilled = blocks.size();
+	unspilledBytes = 0;
+}
+
+uint64_t CompressedHistory::size() const
+{
+	return static_cast<uint64_t>(blocks.size()) * blockSize + tail.size();
+}
+
+CompressedHistory::Encoding CompressedHistory::getEncoding() const
+{
+	return encoding;
+}
+
+size_t CompressedHistory::getBlockCount() const
+{
+	return blocks.size() + (tail.empty() ? 0 : 1);
+}
+
+CompressedHistory::Summary CompressedHistory::getSummary(size_t block) const
+{
+	if (block < blocks.size())
+		return blocks[block].summary;
+	return summarize(tail);
+}
+
+void CompressedHistory::readBlock(size_t block, std::vector<double>& out) const
+{
+	if (block >= blocks.size())
+	{
+		out = tail;
+		return;
+	}
+
+	const Block& sealed = blocks[block];
+	const uint64_t* words = sealed.words.data();
+
+	/* the segment is paged in by the OS as the words are decoded */
+	if (sealed.segment != noSegment)
+	{
+		words = segments[sealed.segment]->getWords();
+		if (words == nullptr)
+		{
+			out.assign(sealed.summary.count, sealed.summary.first);
+			return;
+		}
+		words += sealed.offset;
+	}
+
+	if (encoding == Encoding::XOR)
+		decodeXor(words, sealed.summary.count, out);
+	else
+		decodeDeltaOfDelta(words, sealed.summary.count, out);
+}
+
+size_t CompressedHistory::getMemoryBytes() const
+{
+	size_t bytes = tail.capacity() * sizeof(double) + blocks.capacity() * sizeof(Block);
+	for (auto& block : blocks)
+		bytes += block.words.capacity() * sizeof(uint64_t);
+	return bytes;
+}
+
+size_t CompressedHistory::getSpilledBytes() const
+{
+	size_t bytes = 0;
+	for (auto& segment : segments)
+		bytes += segment->getSize() * sizeof(uint64_t);
+	return bytes;
+}
+
+size_t CompressedHistory::getSegmentCount() const
+{
+	return segments.size();
+}
+
+size_t CompressedHistory::findBlock(double timestamp) const
+{
+	size_t first = 0;
+	size_t last = getBlockCount();
+
+	while (first < last)
+	{
+		size_t middle = first + (last - first) / 2;
+		if (getSummary(middle).last < timestamp)
+			first = middle + 1;
+		else
+			last = middle;
+	}
+	return first;
+}
+
+void CompressedHistory::decimate(const CompressedHistory& time, const CompressedHistory& values, double xMin, double xMax, uint32_t maxBuckets, std::vector<double>& xs, std::vector<double>& ys)
+{
+	xs.clear();
+	ys.clear();
+
+	if (time.size() == 0 || time.size() != values.size())
+		return;
+
+	maxBuckets = std::max(maxBuckets, 1u);
+	size_t count = time.getBlockCount();
+	size_t first = std::min(time.findBlock(xMin), count - 1);
+	size_t last = std::min(time.findBlock(xMax), count - 1);
+	size_t blocksInRange = last - first + 1;
+
+	auto emit = [&](double x, double min, double max)
+	{
+		xs.push_back(x);
+		ys.push_back(min);
+		xs.push_back(x);
+		ys.push_back(max);
+	};
+
+	/* a wide range is drawn from the block summaries, each bucket spanning whole blocks */
+	if (blocksInRange > maxBuckets / 8)
+	{
+		size_t group = (blocksInRange + maxBuckets - 1) / maxBuckets;
+		for (size_t block = first; block <= last; block += group)
+		{
+			Summary summary = values.getSummary(block);
+			for (size_t next = block + 1; next < std::min(block + group, last + 1); next++)
+			{
+				Summary nextSummary = values.getSummary(next);
+				summary.min = std::min(summary.min, nextSummary.min);
+				summary.max = std::max(summary.max, nextSummary.max);
+			}
+			emit(time.getSummary(block).first, summary.min, summary.max);
+		}
+		return;
+	}
+
+	uint64_t points = 0;
+	for (size_t block = first; block <= last; block++)
+		points += time.getSummary(block).count;
+
+	uint64_t bucketSize = (points + maxBuckets - 1) / maxBuckets;
+
+	std::vector<double> timeBlock;
+	std::vector<double> valueBlock;
+	uint64_t inBucket = 0;
+	double bucketX = 0.0;
+	double bucketMin = 0.0;
+	double bucketMax = 0.0;
+
+	/* whole blocks are decoded, the points beyond the range let the curve reach the plot edges */
+	for (size_t block = first; block <= last; block++)
+	{
+		time.readBlock(block, timeBlock);
+		values.readBlock(block, valueBlock);
+
+		for (size_t i = 0; i < timeBlock.size(); i++)
+		{
+			if (bucketSize <= 2)
+			{
+				xs.push_back(timeBlock[i]);
+				ys.push_back(valueBlock[i]);
+				continue;
+			}
+
+			if (inBucket == 0)
+			{
+				bucketX = timeBlock[i];
+				bucketMin = valueBlock[i];
+				bucketMax = valueBlock[i];
+			}
+			else
+			{
+				bucketMin = std::min(bucketMin, valueBlock[i]);
+				bucketMax = std::max(bucketMax, valueBlock[i]);
+			}
+
+			if (++inBucket == bucketSize)
+			{
+				emit(bucketX, bucketMin, bucketMax);
+				inBucket = 0;
+			}
+		}
+	}
+
+	if (inBucket > 0)
+		emit(bucketX, bucketMin, bucketMax);
+}
+
+void CompressedHistory::seal()
+{
+	Block block;
+	block.summary = summarize(tail);
+
+	if (encoding == Encoding::XOR)
+		encodeXor(tail, block.words);
+	else
+		encodeDeltaOfDelta(tail, block.words);
+
+	block.words.shrink_to_fit();
+	unspilledBytes += block.words.size() * sizeof(uint64_t);
+	blocks.push_back(std::move(block));
+	tail.clear();
+
+	if (spillDirectory != nullptr && unspilledBytes >= segmentBytes)
+		spill();
+}
+
+void CompressedHistory::spill()
+{
+	std::vector<uint64_t> words;
+	words.reserve(unspilledBytes / sizeof(uint64_t));
+	for (size_t block = firstUnspilled; block < blocks.size(); block++)
+		words.insert(words.end(), blocks[block].words.begin(), blocks[block].words.end());
+
+	auto path = spillDirectory->getPath() / (spillName + "_" + std::to_string(segments.size()) + ".seg");
+	auto segment = SpillSegment::write(path, words);
+
+	/* without a writable directory the blocks simply stay in RAM */
+	if (segment == nullptr)
+	{
+		spillDirectory.reset();
+		return;
+	}
+
+	uint32_t offset = 0;
+	for (size_t block = firstUnspilled; block < blocks.size(); block++)
+	{
+		blocks[block].segment = static_cast<uint32_t>(segments.size());
+		blocks[block].offset = offset;
+		offset += static_cast<uint32_t>(blocks[block].words.size());
+		std::vector<uint64_t>().swap(blocks[block].words);
+	}
+
+	segments.push_back(std::move(segment));
+	firstUnspilled = blocks.size();
+	unspilledBytes = 0;
+}
+
+void CompressedHistory::encodeXor(const std::vector<double>& points, std::vector<uint64_t>& words) const
+{
+	BitWriter writer(words);
+
+	uint64_t previous = std::bit_cast<uint64_t>(points[0]);
+	writer.write(previous, 64);
+
+	/* leading zeros are capped to fit 5 bits, 64 meaningful bits are stored as 0 in 6 bits */
+	uint32_t previousLeading = 64;
+	uint32_t previousTrailing = 0;
+
+	for (size_t i = 1; i < points.size(); i++)
+	{
+		uint64_t current = std::bit_cast<uint64_t>(points[i]);
+		uint64_t difference = current ^ previous;
+		previous = current;
+
+		if (difference == 0)
+		{
+			writer.write(0, 1);
+			continue;
+		}
+
+		uint32_t leading = std::min(static_cast<uint32_t>(std::countl_zero(difference)), 31u);
+		uint32_t trailing = static_cast<uint32_t>(std::countr_zero(difference));
+
+		if (previousLeading < 64 && leading >= previousLeading && trailing >= previousTrailing)
+		{
+			writer.write(0b10, 2);
+			writer.write(difference >> previousTrailing, 64 - previousLeading - previousTrailing);
+			continue;
+		}
+
+		uint32_t meaningful = 64 - leading - trailing;
+		writer.write(0b11, 2);
+		writer.write(leading, 5);
+		writer.write(meaningful == 64 ? 0 : meaningful, 6);
+		writer.write(difference >> trailing, meaningful);
+		previousLeading = leading;
+		previousTrailing = trailing;
+	}
+}
+
+void CompressedHistory::decodeXor(const uint64_t* words, uint32_t count, std::vector<double>& out)
+{
+	out.resize(count);
+	BitReader reader(words);
+
+	uint64_t previous = reader.read(64);
+	out[0] = std::bit_cast<double>(previous);
+
+	uint32_t previousLeading = 0;
+	uint32_t previousTrailing = 0;
+
+	for (uint32_t i = 1; i < count; i++)
+	{
+		if (reader.readBit())
+		{
+			if (reader.readBit())
+			{
+				previousLeading = static_cast<uint32_t>(reader.read(5));
+				uint32_t meaningful = static_cast<uint32_t>(reader.read(6));
+				meaningful = meaningful == 0 ? 64 : meaningful;
+				previousTrailing = 64 - previousLeading - meaningful;
+			}
+			previous ^= reader.read(64 - previousLeading - previousTrailing) << previousTrailing;
+		}
+		out[i] = std::bit_cast<double>(previous);
+	}
+}
+
+void CompressedHistory::encodeDeltaOfDelta(const std::vector<double>& points, std::vector<uint64_t>& words) const
+{
+	BitWriter writer(words);
+
+	int64_t previous = toNanoseconds(points[0]);
+	int64_t previousDelta = 0;
+	writer.write(static_cast<uint64_t>(previous), 64);
+
+	for (size_t i = 1; i < points.size(); i++)
+	{
+		int64_t current = toNanoseconds(points[i]);
+		int64_t delta = current - previous;
+		int64_t deltaOfDelta = delta - previousDelta;
+		previous = current;
+		previousDelta = delta;
+
+		/* regular sampling makes most of these zero, the jitter of the timestamps fits 12 or 20 bits */
+		if (deltaOfDelta == 0)
+			writer.write(0, 1);
+		else if (fitsSigned(deltaOfDelta, 7))
+		{
+			writer.write(0b10, 2);
+			writer.write(static_cast<uint64_t>(deltaOfDelta), 7);
+		}
+		else if (fitsSigned(deltaOfDelta, 12))
+		{
+			writer.write(0b110, 3);
+			writer.write(static_cast<uint64_t>(deltaOfDelta), 12);
+		}
+		else if (fitsSigned(deltaOfDelta, 20))
+		{
+			writer.write(0b1110, 4);
+			writer.write(static_cast<uint64_t>(deltaOfDelta), 20);
+		}
+		else if (fitsSigned(deltaOfDelta, 32))
+		{
+			writer.write(0b11110, 5);
+			writer.write(static_cast<uint64_t>(deltaOfDelta), 32);
+		}
+		else
+		{
+			writer.write(0b11111, 5);
+			writer.write(static_cast<uint64_t>(deltaOfDelta), 64);
+		}
+	}
+}
+
+void CompressedHistory::decodeDeltaOfDelta(const uint64_t* words, uint32_t count, std::vector<double>& out)
+{
+	static constexpr uint32_t widths[] = {7, 12, 20, 32, 64};
+
+	out.resize(count);
+	BitReader reader(words);
+
+	int64_t previous = static_cast<int64_t>(reader.read(64));
+	int64_t previousDelta = 0;
+	out[0] = toSeconds(previous);
+
+	for (uint32_t i = 1; i < count; i++)
+	{
+		int64_t deltaOfDelta = 0;
+
+		if (reader.readBit())
+		{
+			/* up to four more prefix bits select the width */
+			uint32_t width = 0;
+			while (width < 4 && reader.readBit())
+				width++;
+			deltaOfDelta = signExtend(reader.read(widths[width]), widths[width]);
+		}
+
+		previousDelta += deltaOfDelta;
+		previous += previousDelta;
+		out[i] = toSeconds(previous);
+	}
+}
+
+CompressedHistory::Summary CompressedHistory::summarize(const std::vector<double>& points)
+{
+	if (points.empty())
+		return Summary{0.0, 0.0, 0.0, 0.0, 0};
+
+	auto [min, max] = std::minmax_element(points.begin(), points.end());
+	return Summary{points.front(), points.back(), *min, *max, static_cast<uint32_t>(points.size())};
+}
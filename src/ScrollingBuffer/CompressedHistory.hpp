@@ -0,0 +1,134 @@
+#ifndef __COMPRESSEDHISTORY_HPP
+#define __COMPRESSEDHISTORY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "SpillSegment.hpp"
+
+/// @brief Complete history of a column compressed in fixed-size blocks, Gorilla style. Values are XOR
+/// encoded against the previous one, timestamps are kept with 1 ns resolution and delta-of-delta encoded.
+/// The newest points stay uncompressed in a hot tail of up to blockSize points that is sealed once full.
+/// Every block keeps a summary (first, last, min, max) so that long ranges can be drawn and located
+/// without decoding. The history is read by the GUI while the acquisition is stopped.
+/// With a spill directory set, the sealed blocks are moved to memory-mapped segment files once they add
+/// up to segmentBytes, so only the summaries, the blocks of the open segment and the tail stay in RAM.
+class CompressedHistory
+{
+   public:
+	enum class Encoding : uint8_t
+	{
+		XOR = 0,
+		DELTA_OF_DELTA = 1,
+	};
+
+	struct Summary
+	{
+		double first;
+		double last;
+		double min;
+		double max;
+		uint32_t count;
+	};
+
+	static constexpr uint32_t blockSize = 1024;
+	static constexpr size_t defaultSegmentBytes = 1 << 20;
+
+	explicit CompressedHistory(Encoding encoding = Encoding::XOR);
+
+	void append(double value);
+	void clear();
+
+	/// @brief moves the blocks sealed from now on to segment files named after name in the directory,
+	/// nullptr keeps all blocks in RAM
+	void setSpill(std::shared_ptr<SpillDirectory> directory, const std::string& name, size_t segmentBytes = defaultSegmentBytes);
+
+	uint64_t size() const;
+	Encoding getEncoding() const;
+
+	/// @brief number of blocks including the hot tail as the last one
+	size_t getBlockCount() const;
+	Summary getSummary(size_t block) const;
+
+	/// @brief decodes the points of the block into out, the last block is the hot tail
+	void readBlock(size_t block, std::vector<double>& out) const;
+
+	/// @brief bytes of RAM used by the compressed blocks and the hot tail, without the segment files
+	size_t getMemoryBytes() const;
+
+	/// @brief bytes written to the segment files
+	size_t getSpilledBytes() const;
+	size_t getSegmentCount() const;
+
+	/// @brief index of the first block ending at or after the timestamp, valid for a DELTA_OF_DELTA history
+	size_t findBlock(double timestamp) const;
+
+	/// @brief calls callback(time, value) for all points with time in [start, end], decoding block by block
+	template <typename Callback>
+	static void forEachInRange(const CompressedHistory& time, const CompressedHistory& values, double start, double end, Callback&& callback)
+	{
+		if (time.size() == 0 || time.size() != values.size())
+			return;
+
+		std::vector<double> timeBlock;
+		std::vector<double> valueBlock;
+
+		for (size_t block = time.findBlock(start); block < time.getBlockCount(); block++)
+		{
+			if (time.getSummary(block).first > end)
+				break;
+
+			time.readBlock(block, timeBlock);
+			values.readBlock(block, valueBlock);
+
+			for (size_t i = 0; i < timeBlock.size(); i++)
+			{
+				if (timeBlock[i] >= start && timeBlock[i] <= end)
+					callback(timeBlock[i], valueBlock[i]);
+			}
+		}
+	}
+
+	/// @brief fills xs and ys with at most about 2 * maxBuckets points of the range [xMin, xMax], wide ranges
+	/// are drawn from the block summaries without decoding
+	static void decimate(const CompressedHistory& time, const CompressedHistory& values, double xMin, double xMax, uint32_t maxBuckets, std::vector<double>& xs, std::vector<double>& ys);
+
+   private:
+	/* a spilled block has no words in RAM, they are at offset of its segment */
+	struct Block
+	{
+		std::vector<uint64_t> words;
+		Summary summary;
+		uint32_t segment = noSegment;
+		uint32_t offset = 0;
+	};
+
+	static constexpr uint32_t noSegment = UINT32_MAX;
+
+	void seal();
+	void spill();
+	void encodeXor(const std::vector<double>& points, std::vector<uint64_t>& words) const;
+	void encodeDeltaOfDelta(const std::vector<double>& points, std::vector<uint64_t>& words) const;
+	static void decodeXor(const uint64_t* words, uint32_t count, std::vector<double>& out);
+	static void decodeDeltaOfDelta(const uint64_t* words, uint32_t count, std::vector<double>& out);
+	static Summary summarize(const std::vector<double>& points);
+
+   private:
+	Encoding encoding;
+	std::vector<Block> blocks;
+	std::vector<double> tail;
+
+	/* declared before the segments so that the directory outlives their files */
+	std::shared_ptr<SpillDirectory> spillDirectory;
+	std::string spillName;
+	size_t segmentBytes = defaultSegmentBytes;
+	std::vector<std::unique_ptr<SpillSegment>> segments;
+	/* blocks before this one are spilled */
+	size_t firstUnspilled = 0;
+	size_t unspilledBytes = 0;
+};
+
+#endif
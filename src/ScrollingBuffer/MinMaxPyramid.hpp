@@ -0,0 +1,234 @@
+#ifndef __MINMAXPYRAMID_HPP
+#define __MINMAXPYRAMID_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "ScrollingBuffer.hpp"
+
+/// @brief Min/max pyramid of a ScrollingBuffer snapshot used to draw long series at a bounded cost.
+/// Level k holds the min and max of every bucket of 2^k consecutive points, the levels are rings sized
+/// to the buffer so that every bucket lying in the buffer window is available. The pyramid is updated
+/// incrementally from the points added since the previous update - a completed bucket is folded into the
+/// level above. decimate returns about two points per bucket for the requested time range, picking the
+/// level so that the number of buckets does not exceed maxBuckets, so spikes are never dropped.
+/// The finest levels are not stored - their buckets are cheaper to scan than to keep.
+template <typename T>
+class MinMaxPyramid
+{
+   public:
+	/// @brief folds the points added to the snapshot of the buffer since the previous call
+	void update(const ScrollingBuffer<T>& buffer)
+	{
+		uint64_t head = buffer.getCopyHead();
+
+		if (buffer.getMaxSize() != maxSize || buffer.getEpoch() != epoch)
+		{
+			reset(buffer.getMaxSize());
+			epoch = buffer.getEpoch();
+		}
+
+		if (head == processedHead)
+			return;
+
+		const T* data = buffer.getFirstElementCopy();
+		uint64_t begin = std::max(processedHead, head > maxSize ? head - maxSize : 0);
+
+		/* after a gap the first bucket is partial, it starts before the window so it is never used */
+		for (uint64_t i = begin; i < head; i++)
+			addPoint(i, data[i % maxSize], i == begin && begin != processedHead);
+
+		processedHead = head;
+	}
+
+	/// @brief fills xs and ys with the points of the snapshot with time in [xMin, xMax] decimated to at most
+	/// maxBuckets min/max pairs, one point beyond both ends is included so that the curve reaches the edges
+	/// @param time time buffer snapshot taken at the same sample as the one of the pyramid buffer
+	/// @param values buffer snapshot the pyramid was last updated from
+	void decimate(const ScrollingBuffer<double>& time, const ScrollingBuffer<T>& values, double xMin, double xMax, uint32_t maxBuckets, std::vector<double>& xs, std::vector<double>& ys) const
+	{
+		xs.clear();
+		ys.clear();
+
+		uint64_t head = time.getCopyHead();
+		uint64_t oldest = head - time.getCopySize();
+		if (head == oldest || values.getCopyHead() != head)
+			return;
+
+		const double* timeData = time.getFirstElementCopy();
+		const T* data = values.getFirstElementCopy();
+		uint32_t size = time.getMaxSize();
+
+		uint64_t begin = lowerBound(timeData, size, oldest, head, xMin);
+		uint64_t end = lowerBound(timeData, size, begin, head, xMax);
+		begin = begin > oldest ? begin - 1 : begin;
+		end = end < head ? end + 1 : end;
+
+		uint64_t count = end - begin;
+		maxBuckets = std::max(maxBuckets, 1u);
+
+		if (count <= 2ull * maxBuckets)
+		{
+			xs.reserve(count);
+			ys.reserve(count);
+			for (uint64_t i = begin; i < end; i++)
+			{
+				xs.push_back(timeData[i % size]);
+				ys.push_back(static_cast<double>(data[i % size]));
+			}
+			return;
+		}
+
+		uint32_t level = 0;
+		while ((count >> level) > maxBuckets)
+			level++;
+
+		xs.reserve(2 * ((count >> level) + 2));
+		ys.reserve(2 * ((count >> level) + 2));
+
+		auto emit = [&](uint64_t first, Bucket bucket)
+		{
+			double x = timeData[first % size];
+			xs.push_back(x);
+			ys.push_back(static_cast<double>(bucket.min));
+			xs.push_back(x);
+			ys.push_back(static_cast<double>(bucket.max));
+		};
+
+		uint64_t bucketSize = 1ull << level;
+		uint64_t firstFull = (begin + bucketSize - 1) >> level;
+		uint64_t lastFull = end >> level;
+
+		/* partial buckets at both ends of the range are scanned, the same as buckets of the levels not stored */
+		if (level < firstLevel || level - firstLevel >= levels.size() || maxSize != size || processedHead != head || firstFull >= lastFull)
+		{
+			for (uint64_t first = begin; first < end; first += bucketSize)
+				emit(first, scan(data, size, first, std::min(first + bucketSize, end)));
+			return;
+		}
+
+		if (begin < (firstFull << level))
+			emit(begin, scan(data, size, begin, firstFull << level));
+
+		const Level& stored = levels[level - firstLevel];
+		for (uint64_t bucket = firstFull; bucket < lastFull; bucket++)
+			emit(bucket << level, stored.buckets[bucket % stored.buckets.size()]);
+
+		if ((lastFull << level) < end)
+			emit(lastFull << level, scan(data, size, lastFull << level, end));
+	}
+
+	void reset(uint32_t newMaxSize)
+	{
+		maxSize = newMaxSize;
+		processedHead = 0;
+		levels.clear();
+
+		for (uint32_t level = firstLevel; (maxSize >> level) > 0; level++)
+			levels.push_back(Level{std::vector<Bucket>((maxSize >> level) + 2)});
+	}
+
+	/// @brief bytes allocated for all levels
+	size_t getAllocatedBytes() const
+	{
+		size_t bytes = 0;
+		for (auto& level : levels)
+			bytes += level.buckets.size() * sizeof(Bucket);
+		return bytes;
+	}
+
+   private:
+	struct Bucket
+	{
+		T min;
+		T max;
+	};
+
+	struct Level
+	{
+		std::vector<Bucket> buckets;
+	};
+
+	void addPoint(uint64_t index, T x, bool restart)
+	{
+		if (levels.empty())
+			return;
+
+		constexpr uint64_t mask = (1ull << firstLevel) - 1;
+		uint64_t bucket = index >> firstLevel;
+		Bucket& current = levels[0].buckets[bucket % levels[0].buckets.size()];
+
+		if (restart || (index & mask) == 0)
+			current = Bucket{x, x};
+		else
+		{
+			current.min = std::min(current.min, x);
+			current.max = std::max(current.max, x);
+		}
+
+		if ((index & mask) == mask)
+			fold(bucket);
+	}
+
+	/* propagates a completed bucket of the first stored level up as long as it completes the parent */
+	void fold(uint64_t bucket)
+	{
+		for (size_t level = 0; level + 1 < levels.size(); level++)
+		{
+			const Bucket& child = levels[level].buckets[bucket % levels[level].buckets.size()];
+			uint64_t parentIndex = bucket >> 1;
+			Bucket& parent = levels[level + 1].buckets[parentIndex % levels[level + 1].buckets.size()];
+
+			if ((bucket & 1) == 0)
+			{
+				parent = child;
+				return;
+			}
+
+			parent.min = std::min(parent.min, child.min);
+			parent.max = std::max(parent.max, child.max);
+			bucket = parentIndex;
+		}
+	}
+
+	static Bucket scan(const T* data, uint32_t size, uint64_t first, uint64_t last)
+	{
+		uint32_t index = first % size;
+		Bucket bucket{data[index], data[index]};
+		for (uint64_t i = first + 1; i < last; i++)
+		{
+			index = index + 1 == size ? 0 : index + 1;
+			bucket.min = std::min(bucket.min, data[index]);
+			bucket.max = std::max(bucket.max, data[index]);
+		}
+		return bucket;
+	}
+
+	/* first index in [first, last) with time not less than x, the time is monotonic in ring order */
+	static uint64_t lowerBound(const double* timeData, uint32_t size, uint64_t first, uint64_t last, double x)
+	{
+		while (first < last)
+		{
+			uint64_t middle = first + (last - first) / 2;
+			if (timeData[middle % size] < x)
+				first = middle + 1;
+			else
+				last = middle;
+		}
+		return first;
+	}
+
+   private:
+	/* buckets of fewer points are scanned on every decimate call */
+	static constexpr uint32_t firstLevel = 4;
+
+	uint32_t maxSize = 0;
+	/* head of the snapshot at the last update */
+	uint64_t processedHead = 0;
+	/* epoch of the buffer at the last update */
+	uint32_t epoch = 0;
+	std::vector<Level> levels;
+};
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef __PACKEDCODEC_HPP
+#define __PACKEDCODEC_HPP
+
+#include <cstdint>
+
+/// @brief Decodes the raw words a packed ScrollingBuffer stores in their native width. The words are little
+/// endian and getWidth() bytes long, decoding is done in batches by the readers only.
+template <typename T>
+class PackedCodec
+{
+   public:
+	virtual ~PackedCodec() = default;
+
+	/// @brief bytes per word, 1, 2 or 4
+	virtual uint8_t getWidth() const = 0;
+
+	/// @brief decodes count consecutive words into out
+	virtual void decode(const uint8_t* words, uint32_t count, T* out) const = 0;
+};
+
+#endif
@@ -1,85 +1,477 @@
 #ifndef __SCROLLINGBUFFER_HPP
 #define __SCROLLINGBUFFER_HPP
 
-#include <array>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <cstring>
-#include <mutex>
+#include <memory>
+#include <vector>
+
+#include "BufferArena.hpp"
+#include "ChunkPool.hpp"
+#include "PackedCodec.hpp"
+
+/// @brief Single-writer ring buffer of maxSize points. The writer publishes the total number of points
+/// with a release store, readers derive a consistent (offset, size) view from a single acquire load and
+/// need no lock. copyData keeps a snapshot for a single reader (the GUI) and copies only the points added
+/// since the previous call, the copied range is validated afterwards like in a seqlock.
+/// The ring is made of reference counted chunks of up to maxChunkSize points drawn from a ChunkPool on the
+/// first point, the contiguous snapshot is allocated on the first copyData, from the arena if one is set.
+/// freeze() shares the chunks with an immutable Frozen view, the writer copies a shared chunk before writing
+/// into it, so only the chunks overwritten while the view is alive are duplicated.
+/// With a codec set the buffer is packed - the writer appends raw words of the codec width with addRaw and
+/// the readers decode them in batches, the snapshot holds decoded points.
+/// erase, release, freeze, setArena, setChunkPool, setCodec and setMaxSize must not run concurrently with addPoint.
 template <typename T>
 class ScrollingBuffer
 {
    public:
+	/// @brief contiguous run of points
+	struct Span
+	{
+		const T* data;
+		uint32_t size;
+	};
+
+	/// @brief points of the snapshot in logical order (oldest first), the ring wraps at most once so the
+	/// range is made of at most two spans
+	struct Range
+	{
+		Span first;
+		Span second;
+
+		uint32_t size() const
+		{
+			return first.size + second.size;
+		}
+
+		template <typename Callback>
+		void forEach(Callback&& callback) const
+		{
+			for (const Span& span : {first, second})
+				for (uint32_t i = 0; i < span.size; i++)
+					callback(span.data[i]);
+		}
+	};
+
+	/// @brief points of the buffer at the moment of freeze(), sharing the chunks with it. The view stays
+	/// valid after the buffer has been erased or released and has to be dropped by the reader thread.
+	class Frozen
+	{
+	   public:
+		uint32_t getSize() const
+		{
+			return static_cast<uint32_t>(std::min<uint64_t>(head, maxSize));
+		}
+
+		/// @brief total number of points written when the view was taken
+		uint64_t getHead() const
+		{
+			return head;
+		}
+
+		size_t getChunkCount() const
+		{
+			return chunks.size();
+		}
+
+		/// @brief point at the logical index, 0 being the oldest one
+		T getValue(uint32_t index) const
+		{
+			uint32_t physical = physicalIndex(index);
+			return decodeAt(chunks[physical / chunkSize].get(), physical % chunkSize, codec.get(), width);
+		}
+
+		/// @brief logical index of the first point greater than value, the view has to be sorted like a time column
+		uint32_t upperBound(T value) const
+		{
+			uint32_t first = 0;
+			uint32_t last = getSize();
+
+			while (first < last)
+			{
+				uint32_t middle = first + (last - first) / 2;
+				if (!(value < getValue(middle)))
+					first = middle + 1;
+				else
+					last = middle;
+			}
+			return first;
+		}
+
+		/// @brief calls callback(value) for the points with logical indexes [first, last)
+		template <typename Callback>
+		void forEach(uint32_t first, uint32_t last, Callback&& callback) const
+		{
+			last = std::min(last, getSize());
+			if (first >= last)
+				return;
+
+			forEachRun(physicalIndex(first), last - first, chunkSize, maxSize, [&](uint32_t chunk, uint32_t inChunk, uint32_t run, uint32_t)
+					   {
+				if (codec == nullptr)
+				{
+					const T* values = chunks[chunk].get() + inChunk;
+					for (uint32_t i = 0; i < run; i++)
+						callback(values[i]);
+					return;
+				}
+
+				const uint8_t* words = reinterpret_cast<const uint8_t*>(chunks[chunk].get()) + inChunk * width;
+				T values[decodeBatchSize];
+				for (uint32_t done = 0; done < run;)
+				{
+					uint32_t count = std::min(decodeBatchSize, run - done);
+					codec->decode(words + done * width, count, values);
+					for (uint32_t i = 0; i < count; i++)
+						callback(values[i]);
+					done += count;
+				} });
+		}
+
+		/// @brief fills xs and ys with the minimum and maximum of each of at most maxBuckets buckets of the
+		/// range [xMin, xMax], both views have to be frozen at the same sample
+		static void decimate(const Frozen& time, const Frozen& values, T xMin, T xMax, uint32_t maxBuckets, std::vector<T>& xs, std::vector<T>& ys)
+		{
+			xs.clear();
+			ys.clear();
+			if (time.getSize() == 0 || time.head != values.head || time.maxSize != values.maxSize || maxBuckets == 0)
+				return;
+
+			/* one point outside of the range on each side keeps the line running to the plot edges */
+			uint32_t first = time.upperBound(xMin);
+			first = first > 0 ? first - 1 : 0;
+			uint32_t last = std::min(time.upperBound(xMax) + 1, time.getSize());
+			if (first >= last)
+				return;
+
+			uint32_t count = last - first;
+			if (count <= 2 * maxBuckets)
+			{
+				uint32_t index = first;
+				values.forEach(first, last, [&](T value)
+							   {
+					xs.push_back(time.getValue(index++));
+					ys.push_back(value); });
+				return;
+			}
+
+			uint32_t bucket = (count + maxBuckets - 1) / maxBuckets;
+			uint32_t index = first;
+			uint32_t bucketEnd = first + bucket;
+			uint32_t minIndex = first;
+			uint32_t maxIndex = first;
+			T minValue{};
+			T maxValue{};
+
+			values.forEach(first, last, [&](T value)
+						   {
+				if (index == bucketEnd - bucket || value < minValue)
+				{
+					minValue = value;
+					minIndex = index;
+				}
+				if (index == bucketEnd - bucket || maxValue < value)
+				{
+					maxValue = value;
+					maxIndex = index;
+				}
+
+				if (++index == bucketEnd || index == last)
+				{
+					/* both extremes in the order they were sampled */
+					bool minFirst = minIndex <= maxIndex;
+					xs.push_back(time.getValue(minFirst ? minIndex : maxIndex));
+					ys.push_back(minFirst ? minValue : maxValue);
+					if (minIndex != maxIndex)
+					{
+						xs.push_back(time.getValue(minFirst ? maxIndex : minIndex));
+						ys.push_back(minFirst ? maxValue : minValue);
+					}
+					bucketEnd += bucket;
+				} });
+		}
+
+	   private:
+		friend class ScrollingBuffer;
+
+		uint32_t physicalIndex(uint32_t index) const
+		{
+			uint32_t oldest = head > maxSize ? head % maxSize : 0;
+			uint32_t physical = oldest + index;
+			return physical >= maxSize ? physical - maxSize : physical;
+		}
+
+		std::vector<typename ChunkPool<T>::Chunk> chunks;
+		std::shared_ptr<const PackedCodec<T>> codec;
+		uint32_t width = sizeof(T);
+		uint32_t chunkSize = 1;
+		uint32_t maxSize = 1;
+		uint64_t head = 0;
+	};
+
+	static constexpr uint32_t maxChunkSize = 4096;
+	/* points decoded at once by the readers of a packed buffer */
+	static constexpr uint32_t decodeBatchSize = 256;
+
 	ScrollingBuffer() = default;
 	~ScrollingBuffer() = default;
 
 	void addPoint(T x)
 	{
-		std::lock_guard<std::mutex> lock(mtx);
-		data[offset] = x;
-		offset = (offset + 1) % maxSize;
-		if (offset == 0)
-			isFull = true;
+		append([&](uint32_t index)
+			   { writePointer[index] = x; });
+	}
+
+	/// @brief appends the raw word of a packed buffer, the bytes above the codec width are dropped
+	void addRaw(uint32_t word)
+	{
+		append([&](uint32_t index)
+			   {
+			uint8_t* destination = reinterpret_cast<uint8_t*>(writePointer) + index * width;
+			switch (width)
+			{
+				case 1:
+					*destination = static_cast<uint8_t>(word);
+					break;
+				case 2:
+					std::memcpy(destination, &word, 2);
+					break;
+				default:
+					std::memcpy(destination, &word, 4);
+					break;
+			} });
+	}
+
+	/// @brief shares the current points with an immutable view, O(chunks)
+	Frozen freeze() const
+	{
+		Frozen frozen;
+		frozen.head = head.load(std::memory_order_acquire);
+		if (frozen.head == 0)
+			return frozen;
+
+		frozen.chunks = chunks;
+		frozen.codec = codec;
+		frozen.width = width;
+		frozen.chunkSize = chunkSize;
+		frozen.maxSize = maxSize;
+		/* the writer checks again whether the chunk it writes to is shared */
+		freezes++;
+		return frozen;
 	}
 
+
 	uint32_t getSize() const
 	{
-		std::lock_guard<std::mutex> lock(mtx);
-		return isFull ? maxSize : offset;
+		return sizeFromHead(head.load(std::memory_order_acquire));
 	}
 
+	/// @brief first point of the storage, contiguous with the following ones up to the end of the first chunk,
+	/// a decoded copy for a packed buffer
 	T* getFirstElement() const
 	{
-		std::lock_guard<std::mutex> lock(mtx);
-		return &data[0];
+		return head.load(std::memory_order_acquire) > 0 ? pointAt(0) : &empty;
+	}
+
+	/// @brief point at the logical index, 0 being the oldest one
+	T getValue(uint32_t index) const
+	{
+		uint64_t current = head.load(std::memory_order_acquire);
+		if (index >= sizeFromHead(current))
+			return T{};
+		uint32_t physical = (current > maxSize ? current % maxSize : 0) + index;
+		return valueAt(physical >= maxSize ? physical - maxSize : physical);
 	}
+
+	/// @brief updates the snapshot with the points added since the previous call
 	void copyData()
 	{
-		std::lock_guard<std::mutex> lock(mtx);
-		std::memcpy(&dataCopy[0], &data[0], maxSize * sizeof(data[0]));
+		uint64_t end = head.load(std::memory_order_acquire);
+		if (end == copiedHead)
+			return;
+		if (dataCopy == nullptr)
+			dataCopy = allocate(ownedDataCopy);
+
+		while (true)
+		{
+			uint64_t begin = std::max(copiedHead, end > maxSize ? end - maxSize : 0);
+			copyRange(begin, end);
+
+			/* the copy is valid unless the writer has started to overwrite the first copied slot meanwhile */
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (writing.load(std::memory_order_relaxed) <= begin + maxSize)
+				break;
+			end = head.load(std::memory_order_acquire);
+		}
+		copiedHead = end;
 	}
 
 	T* getFirstElementCopy() const
 	{
-		std::lock_guard<std::mutex> lock(mtx);
-		return &dataCopy[0];
+		return dataCopy != nullptr ? &dataCopy[0] : &empty;
+	}
+
+	/// @brief view of the snapshot taken by the last copyData
+	uint32_t getCopyOffset() const
+	{
+		return copiedHead % maxSize;
+	}
+
+	uint32_t getCopySize() const
+	{
+		return sizeFromHead(copiedHead);
+	}
+
+	/// @brief total number of points written when the snapshot was taken
+	uint64_t getCopyHead() const
+	{
+		return copiedHead;
+	}
+
+	/// @brief point of the snapshot at the logical index, 0 being the oldest one
+	T getCopyValue(uint32_t index) const
+	{
+		return getCopySize() > 0 ? dataCopy[physicalCopyIndex(index)] : T{};
+	}
+
+	/// @brief logical index of the first point of the snapshot greater than value, found by a binary search
+	/// so the snapshot has to be sorted in logical order like a time column
+	uint32_t upperBoundCopy(T value) const
+	{
+		uint32_t first = 0;
+		uint32_t last = getCopySize();
+
+		while (first < last)
+		{
+			uint32_t middle = first + (last - first) / 2;
+			if (!(value < dataCopy[physicalCopyIndex(middle)]))
+				first = middle + 1;
+			else
+				last = middle;
+		}
+		return first;
+	}
+
+	/// @brief logical index of the point held at value - the newest one not greater than value, 0 before the oldest one
+	uint32_t getCopyIndexAt(T value) const
+	{
+		uint32_t index = upperBoundCopy(value);
+		return index > 0 ? index - 1 : 0;
+	}
+
+	/// @brief points of the snapshot with logical indexes [first, last), without copying them
+	Range getCopyRange(uint32_t first, uint32_t last) const
+	{
+		last = std::min(last, getCopySize());
+		if (first >= last)
+			return Range{Span{dataCopy, 0}, Span{dataCopy, 0}};
+
+		uint32_t begin = physicalCopyIndex(first);
+		uint32_t count = last - first;
+		uint32_t tail = std::min(count, maxSize - begin);
+		return Range{Span{&dataCopy[begin], tail}, Span{&dataCopy[0], count - tail}};
 	}
 
 	T* getLastElement()
 	{
-		std::lock_guard<std::mutex> lock(mtx);
-		return &data[offset > 0 ? offset - 1 : 0];
+		uint64_t current = head.load(std::memory_order_acquire);
+		if (current == 0)
+			return &empty;
+		return pointAt((current - 1) % maxSize);
 	}
 
 	T getNewestValue()
 	{
-		std::lock_guard<std::mutex> lock(mtx);
-		return data[offset > 0 ? offset - 1 : 0];
+		return *getLastElement();
 	}
 
 	T getOldestValue()
 	{
-		std::lock_guard<std::mutex> lock(mtx);
-		if (isFull)
-			return data[offset < maxSize ? offset : 0];
+		uint64_t current = head.load(std::memory_order_acquire);
+		if (current == 0)
+			return T{};
+		if (current >= maxSize)
+			return valueAt(current % maxSize);
 		else
-			return data[0];
+			return valueAt(0);
 	}
 
 	uint32_t getOffset() const
 	{
-		std::lock_guard<std::mutex> lock(mtx);
-		return offset;
+		return head.load(std::memory_order_acquire) % maxSize;
 	}
 
 	void erase()
 	{
-		std::lock_guard<std::mutex> lock(mtx);
-		offset = 0;
-		isFull = false;
+		head.store(0, std::memory_order_release);
+		writing.store(0, std::memory_order_relaxed);
+		writeOffset = 0;
+		writeChunk = 0;
+		writeInChunk = 0;
+		copiedHead = 0;
+		epoch++;
+	}
+
+	/// @brief incremented whenever the points are dropped, lets derived data detect a restart
+	uint32_t getEpoch() const
+	{
+		return epoch;
+	}
+
+	/// @brief drops the storage, the chunks not shared with a frozen view go back to the pool. It is allocated
+	/// again from the current pool and arena on the next point
+	void release()
+	{
+		erase();
+		chunks.clear();
+		chunkData.reset();
+		storageBytes = 0;
+		writePointer = nullptr;
+		dataCopy = nullptr;
+		std::vector<T>().swap(ownedDataCopy);
+	}
+
+	/// @brief arena used by the next allocation, nullptr for the heap
+	void setArena(BufferArena* newArena)
+	{
+		arena = newArena;
+	}
+
+	/// @brief pool the chunks are drawn from on the next allocation, nullptr for a pool of the buffer's own
+	void setChunkPool(std::shared_ptr<ChunkPool<T>> newPool)
+	{
+		pool = std::move(newPool);
 	}
 
+	/// @brief packs the points as raw words decoded by the codec, nullptr stores plain points. Changing the
+	/// codec drops the points
+	void setCodec(std::shared_ptr<const PackedCodec<T>> newCodec)
+	{
+		if (newCodec == codec)
+			return;
+		release();
+		codec = std::move(newCodec);
+		width = codec != nullptr ? codec->getWidth() : sizeof(T);
+	}
+
+	bool isPacked() const
+	{
+		return codec != nullptr;
+	}
+
+	const PackedCodec<T>* getCodec() const
+	{
+		return codec.get();
+	}
+
+	/// @brief changing the size drops the points as the storage is sized to maxSize
 	void setMaxSize(uint32_t newMaxSize)
 	{
-		std::lock_guard<std::mutex> lock(mtx);
+		if (newMaxSize == maxSize || newMaxSize == 0)
+			return;
+		release();
 		maxSize = newMaxSize;
 	}
 
@@ -88,16 +480,22 @@ class ScrollingBuffer
 		return maxSize;
 	}
 
+	/// @brief bytes allocated for the points and their snapshot, the chunks shared with frozen views included
+	size_t getAllocatedBytes() const
+	{
+		return storageBytes + (dataCopy != nullptr) * maxSize * sizeof(T);
+	}
+
 	uint32_t getIndexFromvalue(double value)
 	{
 		for (uint32_t t = 0; t < getSize(); t++)
 		{
-			double first = data[t];
+			double first = valueAt(t);
 
 			if ((t + 1) >= getSize())
 				return getSize() - 1;
 
-			double second = data[t + 1];
+			double second = valueAt(t + 1);
 			if (value >= first && value < second)
 				return t;
 		}
@@ -111,27 +509,206 @@ class ScrollingBuffer
 		if (getSize() == 0)
 			return vec;
 
+		auto append = [&](size_t first, size_t last)
+		{
+			for (size_t i = first; i < last; i++)
+				vec.push_back(valueAt(i));
+		};
+
 		if (startIndex < stopIndex)
-			vec.insert(vec.end(), &data[startIndex], &data[stopIndex]);
-		else if (startIndex > stopIndex || (isFull && startIndex == stopIndex))
+			append(startIndex, stopIndex);
+		else if (startIndex > stopIndex || (getSize() == maxSize && startIndex == stopIndex))
 		{
-			vec.insert(vec.end(), &data[startIndex], &data[getSize()]);
-			vec.insert(vec.end(), data.begin(), &data[stopIndex]);
+			append(startIndex, getSize());
+			append(0, stopIndex);
 		}
 		else if (startIndex == stopIndex)
-			vec.insert(vec.end(), &data[0], &data[getSize()]);
+			append(0, getSize());
 
 		return vec;
 	}
 
    private:
-	mutable std::mutex mtx;
+	uint32_t physicalCopyIndex(uint32_t index) const
+	{
+		uint32_t oldest = copiedHead > maxSize ? copiedHead % maxSize : 0;
+		uint32_t physical = oldest + index;
+		return physical >= maxSize ? physical - maxSize : physical;
+	}
+
+	uint32_t sizeFromHead(uint64_t current) const
+	{
+		return static_cast<uint32_t>(std::min<uint64_t>(current, maxSize));
+	}
+
+	/* calls callback(chunk, offset in chunk, count, physical index) for the runs of count points starting at
+	the physical index, a run ends at the end of a chunk or of the ring */
+	template <typename Callback>
+	static void forEachRun(uint32_t physical, uint32_t count, uint32_t chunkSize, uint32_t maxSize, Callback&& callback)
+	{
+		while (count > 0)
+		{
+			uint32_t chunk = physical / chunkSize;
+			uint32_t inChunk = physical - chunk * chunkSize;
+			uint32_t run = std::min({count, chunkSize - inChunk, maxSize - physical});
+			callback(chunk, inChunk, run, physical);
+			count -= run;
+			physical = physical + run == maxSize ? 0 : physical + run;
+		}
+	}
+
+	static T decodeAt(const T* chunk, uint32_t inChunk, const PackedCodec<T>* codec, uint32_t width)
+	{
+		if (codec == nullptr)
+			return chunk[inChunk];
+
+		T value;
+		codec->decode(reinterpret_cast<const uint8_t*>(chunk) + inChunk * width, 1, &value);
+		return value;
+	}
+
+	T valueAt(uint32_t physical) const
+	{
+		return decodeAt(chunkData[physical / chunkSize].load(std::memory_order_acquire), physical % chunkSize, codec.get(), width);
+	}
+
+	T* pointAt(uint32_t physical) const
+	{
+		if (codec != nullptr)
+		{
+			decoded = valueAt(physical);
+			return &decoded;
+		}
+		return chunkData[physical / chunkSize].load(std::memory_order_acquire) + physical % chunkSize;
+	}
+
+	/* packed words are decoded straight into the snapshot */
+	void copyRange(uint64_t begin, uint64_t end)
+	{
+		forEachRun(begin % maxSize, static_cast<uint32_t>(end - begin), chunkSize, maxSize, [&](uint32_t chunk, uint32_t inChunk, uint32_t run, uint32_t physical)
+				   {
+			const T* source = chunkData[chunk].load(std::memory_order_acquire);
+			if (codec == nullptr)
+				std::memcpy(&dataCopy[physical], source + inChunk, run * sizeof(T));
+			else
+				codec->decode(reinterpret_cast<const uint8_t*>(source) + inChunk * width, run, &dataCopy[physical]); });
+	}
+
+	uint32_t chunkLength(uint32_t chunk) const
+	{
+		return std::min(chunkSize, maxSize - chunk * chunkSize);
+	}
+
+	/* elements of T holding the points of the chunk */
+	uint32_t chunkStorage(uint32_t chunk) const
+	{
+		return (chunkLength(chunk) * width + sizeof(T) - 1) / sizeof(T);
+	}
+
+	template <typename Store>
+	void append(Store&& store)
+	{
+		if (chunks.empty())
+			allocateChunks();
+		if (writeInChunk == 0 || checkedFreezes != freezes)
+			makeWritable();
+
+		uint64_t next = head.load(std::memory_order_relaxed) + 1;
+		writing.store(next, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		store(writeInChunk);
+		if (++writeOffset == maxSize)
+		{
+			writeOffset = 0;
+			writeChunk = 0;
+			writeInChunk = 0;
+		}
+		else if (++writeInChunk == chunkSize)
+		{
+			writeChunk++;
+			writeInChunk = 0;
+		}
+		head.store(next, std::memory_order_release);
+	}
+
+	void allocateChunks()
+	{
+		if (pool == nullptr)
+			pool = std::make_shared<ChunkPool<T>>();
+
+		/* small buffers stay contiguous, the last chunk holds the remainder of the ring */
+		chunkSize = std::min(maxChunkSize, maxSize);
+		uint32_t count = (maxSize + chunkSize - 1) / chunkSize;
+
+		chunkData = std::make_unique<std::atomic<T*>[]>(count);
+		chunks.reserve(count);
+		for (uint32_t chunk = 0; chunk < count; chunk++)
+		{
+			chunks.push_back(pool->acquire(chunkStorage(chunk)));
+			storageBytes += chunkStorage(chunk) * sizeof(T);
+			chunkData[chunk].store(chunks.back().get(), std::memory_order_relaxed);
+		}
+	}
+
+	/* a chunk shared with a frozen view is replaced by a copy before it is written, the readers may still
+	read the old one as it holds the same points */
+	void makeWritable()
+	{
+		checkedFreezes = freezes;
+		auto& chunk = chunks[writeChunk];
+		if (chunk.use_count() > 1)
+		{
+			uint32_t length = chunkStorage(writeChunk);
+			auto copy = pool->acquire(length);
+			std::memcpy(copy.get(), chunk.get(), length * sizeof(T));
+			chunkData[writeChunk].store(copy.get(), std::memory_order_release);
+			chunk = std::move(copy);
+		}
+		writePointer = chunk.get();
+	}
+
+	T* allocate(std::vector<T>& owned)
+	{
+		if (arena != nullptr)
+			return arena->allocate<T>(maxSize);
+		owned.resize(maxSize);
+		return owned.data();
+	}
+
+   private:
 	uint32_t maxSize = 10000;
-	uint32_t offset = 0;
-	bool isFull = false;
-	static constexpr uint32_t arraySizeMax = 20001; //WHY not 20000? 
-	mutable std::array<T, arraySizeMax> data;
-	mutable std::array<T, arraySizeMax> dataCopy;
+	/* total number of points written, published by the writer */
+	std::atomic<uint64_t> head = 0;
+	/* number of points once the point being written is published */
+	std::atomic<uint64_t> writing = 0;
+	/* writer side position of the next point, in the ring and in its chunk */
+	uint32_t writeOffset = 0;
+	uint32_t writeChunk = 0;
+	uint32_t writeInChunk = 0;
+	T* writePointer = nullptr;
+	/* number of freeze() calls, the writer checks the chunk it writes to when it changes */
+	mutable uint32_t freezes = 0;
+	uint32_t checkedFreezes = 0;
+	/* head at the last copyData, reader side */
+	uint64_t copiedHead = 0;
+	uint32_t epoch = 0;
+	BufferArena* arena = nullptr;
+	std::shared_ptr<ChunkPool<T>> pool;
+	uint32_t chunkSize = maxChunkSize;
+	/* owned by the writer, the readers use the published pointers */
+	std::vector<typename ChunkPool<T>::Chunk> chunks;
+	std::unique_ptr<std::atomic<T*>[]> chunkData;
+	size_t storageBytes = 0;
+	std::shared_ptr<const PackedCodec<T>> codec;
+	/* bytes per point in the chunks */
+	uint32_t width = sizeof(T);
+	T* dataCopy = nullptr;
+	std::vector<T> ownedDataCopy;
+	/* returned instead of the storage that has not been allocated yet */
+	mutable T empty{};
+	/* point of a packed buffer returned by pointer */
+	mutable T decoded{};
 };
 
-#endif
\ No newline at end of file
+#endif
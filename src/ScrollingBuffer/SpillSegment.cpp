@@ -0,0 +1,155 @@
+#include "SpillSegment.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+std::shared_ptr<SpillDirectory> SpillDirectory::create(const std::filesystem::path& base)
+{
+	static std::atomic<uint32_t> sessionCounter{0};
+
+	std::error_code error;
+	std::filesystem::path parent = base.empty() ? std::filesystem::temp_directory_path(error) / "MCUViewer" : base;
+	if (error)
+		return nullptr;
+
+	std::filesystem::create_directories(parent, error);
+	if (error)
+		return nullptr;
+
+	auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+	/* another instance may have created the same name in the same millisecond */
+	for (uint32_t attempt = 0; attempt < 16; attempt++)
+	{
+		auto path = parent / ("session_" + std::to_string(milliseconds) + "_" + std::to_string(sessionCounter++));
+		if (std::filesystem::create_directory(path, error))
+			return std::make_shared<SpillDirectory>(path);
+		if (error)
+			return nullptr;
+	}
+	return nullptr;
+}
+
+SpillDirectory::SpillDirectory(std::filesystem::path path) : path(std::move(path))
+{
+}
+
+SpillDirectory::~SpillDirectory()
+{
+	std::error_code error;
+	std::filesystem::remove_all(path, error);
+}
+
+const std::filesystem::path& SpillDirectory::getPath() const
+{
+	return path;
+}
+
+std::unique_ptr<SpillSegment> SpillSegment::write(const std::filesystem::path& path, const std::vector<uint64_t>& words)
+{
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return nullptr;
+
+	file.write(reinterpret_cast<const char*>(words.data()), static_cast<std::streamsize>(words.size() * sizeof(uint64_t)));
+	file.close();
+
+	if (file.fail())
+	{
+		std::error_code error;
+		std::filesystem::remove(path, error);
+		return nullptr;
+	}
+
+	return std::unique_ptr<SpillSegment>(new SpillSegment(path, words.size()));
+}
+
+SpillSegment::SpillSegment(std::filesystem::path path, size_t size) : path(std::move(path)), size(size)
+{
+}
+
+SpillSegment::~SpillSegment()
+{
+	unmap();
+	std::error_code error;
+	std::filesystem::remove(path, error);
+}
+
+const uint64_t* SpillSegment::getWords() const
+{
+	if (mapping == nullptr)
+		map();
+	return mapping;
+}
+
+size_t SpillSegment::getSize() const
+{
+	return size;
+}
+
+bool SpillSegment::isMapped() const
+{
+	return mapping != nullptr;
+}
+
+void SpillSegment::map() const
+{
+	if (size == 0)
+		return;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+
+	HANDLE handle = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(file);
+	if (handle == NULL)
+		return;
+
+	void* view = MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0);
+	if (view == NULL)
+	{
+		CloseHandle(handle);
+		return;
+	}
+	mappingHandle = handle;
+	mapping = static_cast<const uint64_t*>(view);
+#else
+	int file = open(path.c_str(), O_RDONLY);
+	if (file < 0)
+		return;
+
+	/* the mapping stays valid after the descriptor is closed */
+	void* view = mmap(nullptr, size * sizeof(uint64_t), PROT_READ, MAP_SHARED, file, 0);
+	close(file);
+	if (view == MAP_FAILED)
+		return;
+
+	mapping = static_cast<const uint64_t*>(view);
+#endif
+}
+
+void SpillSegment::unmap() const
+{
+	if (mapping == nullptr)
+		return;
+
+#ifdef _WIN32
+	UnmapViewOfFile(mapping);
+	CloseHandle(mappingHandle);
+	mappingHandle = nullptr;
+#else
+	munmap(const_cast<uint64_t*>(mapping), size * sizeof(uint64_t));
+#endif
+	mapping = nullptr;
+}
@@ -0,0 +1,66 @@
+#ifndef __SPILLSEGMENT_HPP
+#define __SPILLSEGMENT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// @brief Session directory holding the segment files of one acquisition. It is removed together with
+/// its content once the last history referencing it is gone.
+class SpillDirectory
+{
+   public:
+	/// @brief creates a fresh session directory under base, the system temporary directory when base is empty
+	/// @return nullptr when the directory cannot be created
+	static std::shared_ptr<SpillDirectory> create(const std::filesystem::path& base);
+
+	explicit SpillDirectory(std::filesystem::path path);
+	~SpillDirectory();
+
+	SpillDirectory(const SpillDirectory&) = delete;
+	SpillDirectory& operator=(const SpillDirectory&) = delete;
+
+	const std::filesystem::path& getPath() const;
+
+   private:
+	std::filesystem::path path;
+};
+
+/// @brief Sealed, read-only file of compressed words. The file is written once and memory-mapped on the first
+/// access, so the pages are brought in by the OS only when the blocks are decoded and can be dropped again
+/// under memory pressure. The file is deleted with the segment.
+class SpillSegment
+{
+   public:
+	/// @return nullptr when the file cannot be written
+	static std::unique_ptr<SpillSegment> write(const std::filesystem::path& path, const std::vector<uint64_t>& words);
+
+	~SpillSegment();
+
+	SpillSegment(const SpillSegment&) = delete;
+	SpillSegment& operator=(const SpillSegment&) = delete;
+
+	/// @brief words of the file, mapped on the first call, nullptr if the mapping fails
+	const uint64_t* getWords() const;
+	size_t getSize() const;
+	bool isMapped() const;
+
+   private:
+	SpillSegment(std::filesystem::path path, size_t size);
+	void map() const;
+	void unmap() const;
+
+   private:
+	std::filesystem::path path;
+	/* number of words */
+	size_t size;
+	mutable const uint64_t* mapping = nullptr;
+#ifdef _WIN32
+	mutable void* mappingHandle = nullptr;
+#endif
+};
+
+#endif
@@ -3,9 +3,10 @@
 
 #include <algorithm>
 #include <cmath>
-#include <numeric>
+#include <utility>
 #include <vector>
 
+#include "CompressedHistory.hpp"
 #include "Plot.hpp"
 #include "ScrollingBuffer.hpp"
 
@@ -35,10 +36,61 @@ class Statistics
 		double fmax;
 	};
 
+	/// @brief calculates the results from the snapshots of the buffers taken by the plot, the range is located by a
+	/// binary search and read in place - the results are zero when the snapshots were not taken at the same sample
 	static void calculateResults(Plot::Series* ser, ScrollingBuffer<double>* time, double start, double end, DigitalResults& results)
 	{
-		auto data = ser->buffer->getLinearData(time->getIndexFromvalue(start) + 1, time->getIndexFromvalue(end) + 1);
-		std::vector<double> timeData = time->getLinearData(time->getIndexFromvalue(start) + 1, time->getIndexFromvalue(end) + 1);
+		results = DigitalResults{};
+		if (ser->buffer->getCopyHead() != time->getCopyHead())
+			return;
+
+		auto [first, last] = getSnapshotIndexes(time, start, end);
+		std::vector<double> timeData, data;
+		timeData.reserve(last - first);
+		data.reserve(last - first);
+		time->getCopyRange(first, last).forEach([&](double t)
+												{ timeData.push_back(t); });
+		ser->buffer->getCopyRange(first, last).forEach([&](double value)
+													   { data.push_back(value); });
+		calculateDigitalResults(timeData, data, results);
+	}
+
+	static void calculateResults(Plot::Series* ser, ScrollingBuffer<double>* time, double start, double end, AnalogResults& results)
+	{
+		results = AnalogResults{};
+		if (ser->buffer->getCopyHead() != time->getCopyHead())
+			return;
+
+		auto [first, last] = getSnapshotIndexes(time, start, end);
+		AnalogAccumulator accumulator;
+		ser->buffer->getCopyRange(first, last).forEach([&](double value)
+													   { accumulator.add(value); });
+		accumulator.getResults(results);
+	}
+
+	/// @brief calculates the results from the compressed history of the series, decoded block by block
+	static void calculateResults(const CompressedHistory& time, const CompressedHistory& values, double start, double end, DigitalResults& results)
+	{
+		results = DigitalResults{};
+		std::vector<double> timeData, data;
+		CompressedHistory::forEachInRange(time, values, start, end, [&](double t, double value)
+										  { timeData.push_back(t); data.push_back(value); });
+		calculateDigitalResults(timeData, data, results);
+	}
+
+	static void calculateResults(const CompressedHistory& time, const CompressedHistory& values, double start, double end, AnalogResults& results)
+	{
+		AnalogAccumulator accumulator;
+		CompressedHistory::forEachInRange(time, values, start, end, [&](double, double value)
+										  { accumulator.add(value); });
+		accumulator.getResults(results);
+	}
+
+   private:
+	TEST_FRIENDS_STATISTICS
+
+	static void calculateDigitalResults(const std::vector<double>& timeData, const std::vector<double>& data, DigitalResults& results)
+	{
 		std::vector<double> Lvec, Hvec;
 
 		if (!convertDigitalSeriesToVectors(timeData, data, Lvec, Hvec))
@@ -65,54 +117,53 @@ class Statistics
 		results.fmax = findmax(f);
 	}
 
-	static void calculateResults(Plot::Series* ser, ScrollingBuffer<double>* time, double start, double end, AnalogResults& results)
+	/* single pass min, max, mean and population standard deviation (Welford) */
+	struct AnalogAccumulator
 	{
-		/* + 1 is to account for the way sample is "held" for the entire duration of sample period */
-		auto data = ser->buffer->getLinearData(time->getIndexFromvalue(start) + 1, time->getIndexFromvalue(end) + 1);
-		results.min = findmin(data);
-		results.max = findmax(data);
-		results.mean = mean(data);
-		results.stddev = stddev(data);
-	}
+		uint64_t count = 0;
+		double min = 0.0;
+		double max = 0.0;
+		double mean = 0.0;
+		double m2 = 0.0;
 
-   private:
-	TEST_FRIENDS_STATISTICS
+		void add(double value)
+		{
+			min = count == 0 ? value : std::min(min, value);
+			max = count == 0 ? value : std::max(max, value);
+			count++;
+			double delta = value - mean;
+			mean += delta / static_cast<double>(count);
+			m2 += delta * (value - mean);
+		}
 
-	static double findmin(std::vector<double> data)
-	{
-		if (data.empty())
-			return 0.0;
-		return *std::min_element(data.begin(), data.end());
-	}
+		void getResults(AnalogResults& results) const
+		{
+			results.min = min;
+			results.max = max;
+			results.mean = mean;
+			results.stddev = count > 0 ? std::sqrt(m2 / static_cast<double>(count)) : 0.0;
+		}
+	};
 
-	static double findmax(std::vector<double> data)
+	/* + 1 is to account for the way sample is "held" for the entire duration of sample period, so the range
+	starts after the sample held at start and ends with the one held at end */
+	static std::pair<uint32_t, uint32_t> getSnapshotIndexes(ScrollingBuffer<double>* time, double start, double end)
 	{
-		if (data.empty())
-			return 0.0;
-		return *std::max_element(data.begin(), data.end());
+		return {time->upperBoundCopy(start), time->upperBoundCopy(end)};
 	}
 
-	static double mean(std::vector<double> data)
+	static double findmin(const std::vector<double>& data)
 	{
 		if (data.empty())
 			return 0.0;
-		return std::accumulate(data.begin(), data.end(), 0.0) / static_cast<double>(data.size());
+		return *std::min_element(data.begin(), data.end());
 	}
 
-	static double stddev(std::vector<double> data)
+	static double findmax(const std::vector<double>& data)
 	{
 		if (data.empty())
 			return 0.0;
-
-		double m = mean(data);
-
-		double variance = 0.0;
-		for (const double& value : data)
-			variance += (value - m) * (value - m);
-
-		variance /= static_cast<double>(data.size());
-
-		return std::sqrt(variance);
+		return *std::max_element(data.begin(), data.end());
 	}
 
 	static bool convertDigitalSeriesToVectors(std::vector<double> time, std::vector<double> data, std::vector<double>& Lvec, std::vector<double>& Hvec)
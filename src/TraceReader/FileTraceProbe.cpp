@@ -0,0 +1,127 @@
+#include "FileTraceProbe.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+FileTraceProbe::FileTraceProbe(spdlog::logger* logger) : fileBuffer(fileBufferSize), logger(logger)
+{
+}
+
+FileTraceProbe::~FileTraceProbe()
+{
+	stopTrace();
+}
+
+bool FileTraceProbe::startTrace(const TraceProbeSettings& probeSettings, uint32_t coreFrequency, uint32_t tracePrescaler, uint32_t activeChannelMask, bool shouldReset)
+{
+	(void)tracePrescaler;
+	(void)activeChannelMask;
+	(void)shouldReset;
+
+	stopTrace();
+
+	/* the buffer has to be set before the file is opened to take effect */
+	file.rdbuf()->pubsetbuf(fileBuffer.data(), fileBuffer.size());
+	file.open(probeSettings.replayFilePath, std::ios::in | std::ios::binary);
+	if (!file.is_open())
+	{
+		logger->error("Failed to open SWO capture file: {}", probeSettings.replayFilePath);
+		return false;
+	}
+
+	if (!readHeader(coreFrequency))
+	{
+		file.close();
+		return false;
+	}
+
+	recordData.clear();
+	recordOffset = 0;
+	endOfCapture = false;
+	realTime = probeSettings.replayRealTime;
+	start = std::chrono::steady_clock::now();
+
+	logger->info("Replaying SWO capture {} {}", probeSettings.replayFilePath, realTime ? "in real time" : "as fast as possible");
+	return true;
+}
+
+bool FileTraceProbe::stopTrace()
+{
+	if (file.is_open())
+		file.close();
+	return true;
+}
+
+int32_t FileTraceProbe::readTraceBuffer(uint8_t* buffer, uint32_t size)
+{
+	if (!file.is_open())
+		return -1;
+
+	/* records are split and merged freely, the decoder does not care where a read ends */
+	uint32_t length = 0;
+	while (length < size)
+	{
+		if (recordOffset == recordData.size())
+		{
+			if (endOfCapture)
+				break;
+
+			if (!readRecord())
+			{
+				endOfCapture = true;
+				recordData.clear();
+				recordOffset = 0;
+				logger->info("Replay reached the end of the SWO capture");
+				break;
+			}
+		}
+
+		if (realTime && std::chrono::steady_clock::now() - start < std::chrono::duration<double>(recordTime))
+			break;
+
+		size_t chunk = std::min<size_t>(size - length, recordData.size() - recordOffset);
+		std::memcpy(buffer + length, recordData.data() + recordOffset, chunk);
+		recordOffset += chunk;
+		length += chunk;
+	}
+	return static_cast<int32_t>(length);
+}
+
+std::vector<std::string> FileTraceProbe::getConnectedDevices()
+{
+	return std::vector<std::string>{"FILE"};
+}
+
+bool FileTraceProbe::readHeader(uint32_t coreFrequency)
+{
+	char magic[sizeof(TraceCapture::magic)]{};
+	uint32_t version = 0;
+	file.read(magic, sizeof(magic));
+
+	uint32_t recordedFrequency = 0;
+	uint32_t recordedPrescaler = 0;
+	uint32_t recordedChannelMask = 0;
+
+	if (!file || std::memcmp(magic, TraceCapture::magic, sizeof(magic)) != 0 || !read(version) || version != TraceCapture::version ||
+		!read(recordedFrequency) || !read(recordedPrescaler) || !read(recordedChannelMask))
+	{
+		logger->error("SWO capture file has no valid header");
+		return false;
+	}
+
+	logger->info("SWO capture recorded at {} Hz core clock, prescaler {}, channel mask 0x{:08x}", recordedFrequency, recordedPrescaler, recordedChannelMask);
+	if (recordedFrequency != coreFrequency)
+		logger->warn("Decoding the capture with a {} Hz core clock instead", coreFrequency);
+	return true;
+}
+
+bool FileTraceProbe::readRecord()
+{
+	uint32_t size = 0;
+	if (!read(recordTime) || !read(size))
+		return false;
+
+	recordData.resize(size);
+	recordOffset = 0;
+	return static_cast<bool>(file.read(reinterpret_cast<char*>(recordData.data()), size));
+}
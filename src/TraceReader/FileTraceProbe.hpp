@@ -0,0 +1,59 @@
+#ifndef _FILETRACEPROBE_HPP
+#define _FILETRACEPROBE_HPP
+
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ITraceProbe.hpp"
+#include "TraceCapture.hpp"
+#include "spdlog/spdlog.h"
+
+/// @brief Trace probe playing back the raw SWO bytes of a capture written by RecordingTraceProbe, either at
+/// the recorded pace or as fast as the reader takes them. The bytes are decoded again with the current core
+/// clock and channel settings, not the recorded ones. Reads return 0 once the capture ends.
+class FileTraceProbe : public ITraceProbe
+{
+   public:
+	FileTraceProbe(spdlog::logger* logger);
+	~FileTraceProbe();
+
+	bool startTrace(const TraceProbeSettings& probeSettings, uint32_t coreFrequency, uint32_t tracePrescaler, uint32_t activeChannelMask, bool shouldReset) override;
+	bool stopTrace() override;
+	int32_t readTraceBuffer(uint8_t* buffer, uint32_t size) override;
+
+	std::string getTargetName() override { return std::string("Replayed capture"); }
+	std::vector<std::string> getConnectedDevices() override;
+
+	bool isEndOfCapture() const { return endOfCapture; }
+
+   private:
+	template <typename T>
+	bool read(T& value)
+	{
+		return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+
+	bool readHeader(uint32_t coreFrequency);
+	bool readRecord();
+
+   private:
+	/* sequential reads of multi-GB captures go through a large stream buffer */
+	static constexpr size_t fileBufferSize = 4 * 1024 * 1024;
+	std::vector<char> fileBuffer;
+	std::ifstream file;
+
+	double recordTime = 0.0;
+	std::vector<uint8_t> recordData;
+	/* bytes of the current record already returned */
+	size_t recordOffset = 0;
+
+	bool realTime = true;
+	bool endOfCapture = false;
+	std::chrono::steady_clock::time_point start;
+
+	spdlog::logger* logger;
+};
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 
+#include <string>
 #include <vector>
 
 class ITraceProbe
@@ -14,6 +15,9 @@ class ITraceProbe
 		std::string serialNumber = "";
 		std::string device = "";
 		uint32_t speedkHz = 10000;
+		/* file probe only */
+		std::string replayFilePath = "";
+		bool replayRealTime = true;
 
 	} TraceProbeSettings;
 
@@ -0,0 +1,243 @@
+#include "ItmDecoder.hpp"
+
+#include <array>
+
+namespace
+{
+
+enum class Kind : uint8_t
+{
+	unknown,
+	source,
+	timestamp,
+	extension,
+};
+
+struct Header
+{
+	Kind kind;
+	/* payload bytes of a source packet */
+	uint8_t payload;
+	bool continuation;
+	/* 1 to 3 for the delayed local timestamps, 0 otherwise */
+	uint8_t delay;
+};
+
+/* the overflow packet (0x70) matches the local timestamp pattern and is decoded as one, as it always was */
+constexpr std::array<Header, 256> makeHeaderTable()
+{
+	std::array<Header, 256> table{};
+	for (uint32_t c = 0; c < table.size(); c++)
+	{
+		Header& header = table[c];
+		header.continuation = (c & 0x80) != 0;
+
+		if ((c & 0x03) != 0 && (c & 0x04) == 0)
+		{
+			header.kind = Kind::source;
+			header.payload = (c & 0x03) == 0x03 ? 4 : (c & 0x03);
+		}
+		else if ((c & 0x0f) == 0 && (c & 0x70) != 0)
+		{
+			header.kind = Kind::timestamp;
+			if (c == 0xd0)
+				header.delay = 1;
+			else if (c == 0xe0)
+				header.delay = 2;
+			else if (c == 0xf0)
+				header.delay = 3;
+		}
+		else if ((c & 0x0b) == 0x08)
+			header.kind = Kind::extension;
+		else
+			header.kind = Kind::unknown;
+	}
+	return table;
+}
+
+constexpr std::array<Header, 256> headers = makeHeaderTable();
+
+inline uint32_t loadPayload(const uint8_t* payload, uint8_t size)
+{
+	uint32_t value = payload[0];
+	if (size > 1)
+		value |= static_cast<uint32_t>(payload[1]) << 8;
+	if (size > 2)
+		value |= static_cast<uint32_t>(payload[2]) << 16 | static_cast<uint32_t>(payload[3]) << 24;
+	return value;
+}
+
+inline void countDelay(ItmDecoder::Statistics& statistics, uint8_t delay)
+{
+	if (delay == 1)
+		statistics.delayedTimestamp1++;
+	else if (delay == 2)
+		statistics.delayedTimestamp2++;
+	else if (delay == 3)
+		statistics.delayedTimestamp3++;
+}
+
+}  // namespace
+
+ItmDecoder::Result ItmDecoder::decode(const uint8_t* data, size_t length, Event* out, size_t capacity)
+{
+	const uint8_t* p = data;
+	const uint8_t* end = data + length;
+	size_t events = 0;
+
+	/* any byte can end a timestamp, which emits up to channels events */
+	while (p < end && events + channels <= capacity)
+	{
+		if (state == State::idle)
+		{
+			const uint8_t c = *p;
+			const Header& header = headers[c];
+			const size_t available = static_cast<size_t>(end - p) - 1;
+
+			if (header.kind == Kind::source && available >= header.payload)
+			{
+				/* source packets of one size usually come in runs between two timestamps, the low three
+				header bits hold both the kind and the size */
+				const uint8_t payload = header.payload;
+				do
+				{
+					statistics.framesTotal++;
+					addValue(*p >> 3, loadPayload(p + 1, payload));
+					p += 1 + payload;
+				} while (static_cast<size_t>(end - p) > payload && (*p & 0x07) == (c & 0x07));
+				continue;
+			}
+
+			if (header.kind == Kind::timestamp && header.continuation)
+			{
+				const uint8_t* last = p + 1;
+				while (last < end && (*last & 0x80))
+					last++;
+
+				if (last < end)
+				{
+					statistics.framesTotal++;
+					countDelay(statistics, header.delay);
+
+					uint32_t timestamp = 0;
+					uint8_t bits = 0;
+					for (const uint8_t* q = p + 1; q <= last && bits < 32; q++, bits += 7)
+						timestamp |= static_cast<uint32_t>(*q & 0x7f) << bits;
+
+					events += emit(out + events, timestamp);
+					p = last + 1;
+					continue;
+				}
+			}
+		}
+
+		/* single byte packets and the packets split between two buffers */
+		events += step(*p++, out + events);
+	}
+
+	return {static_cast<size_t>(p - data), events};
+}
+
+void ItmDecoder::reset()
+{
+	*this = ItmDecoder();
+}
+
+ItmDecoder::Statistics ItmDecoder::getStatistics() const
+{
+	return statistics;
+}
+
+size_t ItmDecoder::step(uint8_t c, Event* out)
+{
+	switch (state)
+	{
+		case State::idle:
+			return stepIdle(c, out);
+
+		case State::source:
+			word |= static_cast<uint32_t>(c) << shift;
+			shift += 8;
+			if (--payloadLeft == 0)
+			{
+				addValue(sourceChannel, word);
+				state = State::idle;
+			}
+			return 0;
+
+		case State::timestamp:
+			if (shift < 32)
+			{
+				word |= static_cast<uint32_t>(c & 0x7f) << shift;
+				shift += 7;
+			}
+			if (c & 0x80)
+				return 0;
+			state = State::idle;
+			return emit(out, word);
+
+		case State::extension:
+			if ((c & 0x80) == 0)
+				state = State::idle;
+			return 0;
+	}
+	return 0;
+}
+
+size_t ItmDecoder::stepIdle(uint8_t c, Event* out)
+{
+	const Header& header = headers[c];
+	statistics.framesTotal++;
+
+	switch (header.kind)
+	{
+		case Kind::source:
+			sourceChannel = c >> 3;
+			payloadLeft = header.payload;
+			word = 0;
+			shift = 0;
+			state = State::source;
+			return 0;
+
+		case Kind::timestamp:
+			countDelay(statistics, header.delay);
+			if (!header.continuation)
+				return emit(out, (c & 0x7f) >> 4);
+			word = 0;
+			shift = 0;
+			state = State::timestamp;
+			return 0;
+
+		case Kind::extension:
+			if (header.continuation)
+				state = State::extension;
+			return 0;
+
+		default:
+			statistics.errorFramesTotal++;
+			return 0;
+	}
+}
+
+void ItmDecoder::addValue(uint8_t channel, uint32_t value)
+{
+	if (channel >= channels || pending == channels)
+	{
+		statistics.errorFramesTotal++;
+		return;
+	}
+	pendingChannel[pending] = channel;
+	pendingValue[pending] = value;
+	pending++;
+}
+
+size_t ItmDecoder::emit(Event* out, uint32_t timestamp)
+{
+	time += timestamp;
+	for (uint8_t i = 0; i < pending; i++)
+		out[i] = Event{time, pendingValue[i], pendingChannel[i]};
+
+	size_t events = pending;
+	pending = 0;
+	return events;
+}
@@ -0,0 +1,84 @@
+#ifndef _ITMDECODER_HPP
+#define _ITMDECODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/// @brief Decoder of the ITM packet stream read over SWO. Whole buffers are decoded per call: packet
+/// headers are classified with a lookup table, complete packets are decoded in place and runs of source
+/// packets of the same size take a tight loop. Only a packet split between two buffers goes through the
+/// byte-wise state machine. Source packets are latched until the next local timestamp, which emits one
+/// event per latched packet. Nothing is allocated, the events are written straight into the caller's batch.
+class ItmDecoder
+{
+   public:
+	/* ITM stimulus ports, the 5 bit port number of a source packet always fits */
+	static constexpr uint32_t channels = 32;
+
+	/// @brief one source packet and the time of the local timestamp that followed it
+	struct Event
+	{
+		/* core clock cycles since the decoder was reset */
+		uint64_t timestamp;
+		uint32_t value;
+		uint8_t channel;
+	};
+
+	struct Statistics
+	{
+		uint32_t framesTotal;
+		uint32_t errorFramesTotal;
+		uint32_t delayedTimestamp1;
+		uint32_t delayedTimestamp2;
+		uint32_t delayedTimestamp3;
+	};
+
+	struct Result
+	{
+		/* bytes consumed, less than the length only when the batch filled up */
+		size_t bytes;
+		size_t events;
+	};
+
+	/// @brief decodes data until it is consumed or the batch has no room for the events of another
+	/// timestamp, a packet can continue in the next call
+	/// @param capacity size of out, at least channels
+	Result decode(const uint8_t* data, size_t length, Event* out, size_t capacity);
+
+	/// @brief drops the decoding state, the latched packets, the time and the statistics
+	void reset();
+
+	Statistics getStatistics() const;
+
+   private:
+	enum class State : uint8_t
+	{
+		idle,
+		source,
+		timestamp,
+		extension,
+	};
+
+	/* return the number of events written to out */
+	size_t step(uint8_t c, Event* out);
+	size_t stepIdle(uint8_t c, Event* out);
+	void addValue(uint8_t channel, uint32_t value);
+	size_t emit(Event* out, uint32_t timestamp);
+
+   private:
+	State state = State::idle;
+	uint8_t payloadLeft = 0;
+	uint8_t shift = 0;
+	uint8_t sourceChannel = 0;
+	uint32_t word = 0;
+
+	/* source packets waiting for the next timestamp, more than channels between two timestamps are errors */
+	uint8_t pending = 0;
+	uint8_t pendingChannel[channels]{};
+	uint32_t pendingValue[channels]{};
+
+	uint64_t time = 0;
+	Statistics statistics{};
+};
+
+#endif
@@ -0,0 +1,96 @@
+#include "RecordingTraceProbe.hpp"
+
+RecordingTraceProbe::RecordingTraceProbe(std::shared_ptr<ITraceProbe> probe, const std::string& filePath, spdlog::logger* logger) : probe(probe), filePath(filePath), logger(logger)
+{
+	buffer1.reserve(bufferFlushSize);
+	buffer2.reserve(bufferFlushSize);
+}
+
+RecordingTraceProbe::~RecordingTraceProbe()
+{
+	if (isRecording)
+		stopTrace();
+}
+
+bool RecordingTraceProbe::startTrace(const TraceProbeSettings& probeSettings, uint32_t coreFrequency, uint32_t tracePrescaler, uint32_t activeChannelMask, bool shouldReset)
+{
+	if (!probe->startTrace(probeSettings, coreFrequency, tracePrescaler, activeChannelMask, shouldReset))
+		return false;
+
+	file.open(filePath, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+	{
+		logger->error("Failed to open SWO capture file: {}", filePath);
+		probe->stopTrace();
+		return false;
+	}
+
+	start = std::chrono::steady_clock::now();
+	bytesRecorded = 0;
+	currentBuffer->clear();
+	currentBuffer->insert(currentBuffer->end(), std::begin(TraceCapture::magic), std::end(TraceCapture::magic));
+	append(TraceCapture::version);
+	append(coreFrequency);
+	append(tracePrescaler);
+	append(activeChannelMask);
+
+	isRecording = true;
+	logger->info("Recording SWO capture to {}", filePath);
+	return true;
+}
+
+bool RecordingTraceProbe::stopTrace()
+{
+	bool result = probe->stopTrace();
+
+	if (isRecording)
+	{
+		isRecording = false;
+		flush();
+		saveTask.wait();
+		file.close();
+		logger->info("SWO capture of {} bytes saved to {}", bytesRecorded, filePath);
+	}
+	return result;
+}
+
+int32_t RecordingTraceProbe::readTraceBuffer(uint8_t* buffer, uint32_t size)
+{
+	int32_t length = probe->readTraceBuffer(buffer, size);
+	if (length <= 0 || !isRecording)
+		return length;
+
+	append(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+	append(static_cast<uint32_t>(length));
+	currentBuffer->insert(currentBuffer->end(), buffer, buffer + length);
+	bytesRecorded += length;
+
+	if (currentBuffer->size() >= bufferFlushSize)
+		flush();
+
+	return length;
+}
+
+std::string RecordingTraceProbe::getTargetName()
+{
+	return probe->getTargetName();
+}
+
+std::vector<std::string> RecordingTraceProbe::getConnectedDevices()
+{
+	return probe->getConnectedDevices();
+}
+
+void RecordingTraceProbe::flush()
+{
+	/* the previous write has to finish before its buffer is reused */
+	if (saveTask.valid())
+		saveTask.wait();
+
+	auto* fullBuffer = currentBuffer;
+	currentBuffer = currentBuffer == &buffer1 ? &buffer2 : &buffer1;
+	currentBuffer->clear();
+
+	saveTask = std::async(std::launch::async, [this, fullBuffer]()
+						  { file.write(reinterpret_cast<const char*>(fullBuffer->data()), fullBuffer->size()); });
+}
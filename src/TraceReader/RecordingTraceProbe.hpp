@@ -0,0 +1,59 @@
+#ifndef _RECORDINGTRACEPROBE_HPP
+#define _RECORDINGTRACEPROBE_HPP
+
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ITraceProbe.hpp"
+#include "TraceCapture.hpp"
+#include "spdlog/spdlog.h"
+
+/// @brief Decorator that forwards all calls to the wrapped trace probe and records the raw bytes of every
+/// read, together with their time, to a capture file that can be replayed with FileTraceProbe. The reads are
+/// gathered in large buffers which are written on a background task, so the reader thread never waits for
+/// the disk unless it outpaces it.
+class RecordingTraceProbe : public ITraceProbe
+{
+   public:
+	RecordingTraceProbe(std::shared_ptr<ITraceProbe> probe, const std::string& filePath, spdlog::logger* logger);
+	~RecordingTraceProbe();
+
+	bool startTrace(const TraceProbeSettings& probeSettings, uint32_t coreFrequency, uint32_t tracePrescaler, uint32_t activeChannelMask, bool shouldReset) override;
+	bool stopTrace() override;
+	int32_t readTraceBuffer(uint8_t* buffer, uint32_t size) override;
+
+	std::string getTargetName() override;
+	std::vector<std::string> getConnectedDevices() override;
+
+   private:
+	template <typename T>
+	void append(const T& value)
+	{
+		auto bytes = reinterpret_cast<const uint8_t*>(&value);
+		currentBuffer->insert(currentBuffer->end(), bytes, bytes + sizeof(T));
+	}
+
+	void flush();
+
+   private:
+	static constexpr size_t bufferFlushSize = 4 * 1024 * 1024;
+
+	std::shared_ptr<ITraceProbe> probe;
+	std::string filePath;
+	spdlog::logger* logger;
+
+	bool isRecording = false;
+	uint64_t bytesRecorded = 0;
+	std::ofstream file;
+	std::vector<uint8_t> buffer1;
+	std::vector<uint8_t> buffer2;
+	std::vector<uint8_t>* currentBuffer = &buffer1;
+	std::future<void> saveTask{};
+	std::chrono::steady_clock::time_point start;
+};
+
+#endif
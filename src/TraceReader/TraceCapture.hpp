@@ -0,0 +1,19 @@
+#ifndef _TRACECAPTURE_HPP
+#define _TRACECAPTURE_HPP
+
+#include <cstdint>
+
+/* Raw SWO capture written by RecordingTraceProbe and read by FileTraceProbe. All values are little endian.
+The file starts with the magic, the version and the settings the trace was started with, followed by one
+record per probe read that returned data:
+
+HEADER  u32 core frequency [Hz], u32 trace prescaler, u32 active channel mask
+RECORD  f64 time in seconds since the trace start, u32 size, size x u8 raw SWO bytes
+*/
+namespace TraceCapture
+{
+static constexpr char magic[8] = {'M', 'C', 'U', 'V', 'S', 'W', 'O', '\0'};
+static constexpr uint32_t version = 1;
+}  // namespace TraceCapture
+
+#endif
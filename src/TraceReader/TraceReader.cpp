@@ -6,17 +6,6 @@
 #include <random>
 #include <utility>
 
-#define TRACE_OP_IS_OVERFLOW(c)		   (c == 0x70)
-#define TRACE_OP_IS_LOCAL_TIME(c)	   ((c & 0x0f) == 0x00 && (c & 0x70) != 0x00)
-#define TRACE_OP_IS_SW_SOURCE(c)	   ((c & 0x03) != 0x00 && (c & 0x04) == 0x00)
-#define TRACE_OP_GET_CONTINUATION(c)   (c & 0x80)
-#define TRACE_OP_GET_SOURCE_SIZE(c)	   (c & 0x03)
-#define TRACE_OP_GET_SW_SOURCE_ADDR(c) (c >> 3)
-#define TRACE_TIMEOUT_1				   0xD0
-#define TRACE_TIMEOUT_2				   0xE0
-#define TRACE_TIMEOUT_3				   0xF0
-#define TRACE_OP_IS_EXTENSION(c)	   ((c & 0x0b) == 0x08)
-
 TraceReader::TraceReader(spdlog::logger* logger) : logger(logger)
 {
 }
@@ -42,8 +31,15 @@ bool TraceReader::startAcqusition(const ITraceProbe::TraceProbeSettings& probeSe
 
 	if (TraceProbe->startTrace(probeSettings, coreFrequency * 1000, tracePrescaler, activeChannelsMask, shouldReset))
 	{
+		/* the reader and decoder threads are not running, nothing else touches the rings */
+		rawBuffer.clear();
+		rawBuffer.resetStatistics();
+		traceTable.clear();
+		traceTable.resetStatistics();
+		decoder.reset();
 		lastErrorMsg = "";
 		isRunning = true;
+		decoderHandle = std::thread(&TraceReader::decoderThread, this);
 		readerHandle = std::thread(&TraceReader::readerThread, this);
 		return true;
 	}
@@ -59,6 +55,8 @@ bool TraceReader::stopAcqusition()
 
 	if (readerHandle.joinable())
 		readerHandle.join();
+	if (decoderHandle.joinable())
+		decoderHandle.join();
 
 	return true;
 }
@@ -68,13 +66,21 @@ bool TraceReader::isValid() const
 	return isRunning;
 }
 
-bool TraceReader::readTrace(double& timestamp, std::array<uint32_t, 10>& trace)
+bool TraceReader::readTrace(TraceEvent& event, std::chrono::microseconds timeout)
 {
-	if (!isRunning || traceTable.size() == 0)
+	if (!isRunning)
+		return false;
+
+	auto* decoded = traceTable.front();
+	if (decoded == nullptr && timeout.count() > 0 && traceTable.waitForData(timeout))
+		decoded = traceTable.front();
+	if (decoded == nullptr)
 		return false;
-	auto entry = traceTable.pop();
-	timestamp = entry.second / static_cast<double>(coreFrequency * 1000);
-	trace = entry.first;
+
+	event.timestamp = static_cast<double>(decoded->timestamp) / static_cast<double>(coreFrequency * 1000);
+	event.channel = decoded->channel;
+	event.value = decoded->value;
+	traceTable.pop();
 	return true;
 }
 
@@ -133,149 +139,12 @@ std::string TraceReader::getTargetName()
 
 TraceReader::TraceIndicators TraceReader::getTraceIndicators() const
 {
-	return traceIndicators;
-}
-
-TraceReader::TraceState TraceReader::updateTraceIdle(uint8_t c)
-{
-	traceIndicators.framesTotal++;
-
-	if (TRACE_OP_IS_SW_SOURCE(c))
-	{
-		sourceFrameSize = (c & 0x03);
-		currentChannel[awaitingTimestamp] = (c & 0xf8) >> 3;
-		return TRACE_STATE_TARGET_SOURCE_1B;
-	}
-	else if (TRACE_OP_IS_LOCAL_TIME(c))
-	{
-		timestampVec.clear();
-		timestamp = 0;
-
-		if (c == TRACE_TIMEOUT_1)
-			traceIndicators.delayedTimestamp1++;
-		else if (c == TRACE_TIMEOUT_2)
-			traceIndicators.delayedTimestamp2++;
-		else if (c == TRACE_TIMEOUT_3)
-			traceIndicators.delayedTimestamp3++;
-
-		if (TRACE_OP_GET_CONTINUATION(c))
-			return TRACE_STATE_TARGET_TIMESTAMP_HEADER;
-		else
-		{
-			timestampVec.push_back(c);
-			timestampEnd(true);
-			return TRACE_STATE_IDLE;
-		}
-	}
-	else if (TRACE_OP_IS_EXTENSION(c))
-		return TRACE_OP_GET_CONTINUATION(c) ? TRACE_STATE_SKIP_FRAME : TRACE_STATE_IDLE;
-	else if (TRACE_OP_IS_OVERFLOW(c))
-		logger->error("OVERFLOW OPTCODE {}", c);
-
-	logger->debug("Unknown optcode {}", c);
-	traceIndicators.errorFramesTotal++;
-
-	return TRACE_STATE_IDLE;
-}
-
-void TraceReader::timestampEnd(bool headerData)
-{
-	if (headerData)
-		timestamp = (uint32_t)(timestampVec[0] & 0x7f) >> 4;
-	else
-	{
-		for (uint32_t i = 0; i < timestampVec.size(); i++)
-			timestamp |= (uint32_t)(timestampVec[i] & 0x7f) << 7 * i;
-	}
-
-	std::array<uint32_t, channels> currentEntry{previousEntry};
-
-	uint32_t i = 0;
-	while (awaitingTimestamp--)
-	{
-		if (currentChannel[i] > channels || i >= channels - 1)
-		{
-			traceIndicators.errorFramesTotal++;
-			logger->debug("Wrong channel id {}, {}", i, currentChannel[i]);
-			break;
-		}
-		currentEntry[currentChannel[i]] = currentValue[i];
-		i++;
-	}
-
-	traceTable.push(std::pair<std::array<uint32_t, channels>, double>{currentEntry, timestamp});
-	previousEntry = currentEntry;
-	awaitingTimestamp = 0;
-}
-
-TraceReader::TraceState TraceReader::updateTrace(uint8_t c)
-{
-	awaitingTimestamp = std::clamp(awaitingTimestamp, (uint8_t)0, (uint8_t)(sizeof(currentValue) / sizeof(currentValue[0])));
-
-	switch (state)
-	{
-		case TRACE_STATE_IDLE:
-			return updateTraceIdle(c);
-
-		case TRACE_STATE_TARGET_SOURCE_1B:
-		{
-			currentValue[awaitingTimestamp] = c;
-			if (sourceFrameSize == 0x01)
-			{
-				awaitingTimestamp++;
-				return TRACE_STATE_IDLE;
-			}
-			return TRACE_STATE_TARGET_SOURCE_2B;
-		}
-		case TRACE_STATE_TARGET_SOURCE_2B:
-		{
-			currentValue[awaitingTimestamp] |= (c << 8);
-			if (sourceFrameSize == 0x02)
-			{
-				awaitingTimestamp++;
-				return TRACE_STATE_IDLE;
-			}
-			return TRACE_STATE_TARGET_SOURCE_3B;
-		}
-		case TRACE_STATE_TARGET_SOURCE_3B:
-		{
-			currentValue[awaitingTimestamp] |= (c << 16);
-			return TRACE_STATE_TARGET_SOURCE_4B;
-		}
-		case TRACE_STATE_TARGET_SOURCE_4B:
-		{
-			currentValue[awaitingTimestamp++] |= (c << 24);
-			return TRACE_STATE_IDLE;
-		}
-
-		case TRACE_STATE_TARGET_TIMESTAMP_HEADER:
-		{
-			timestampVec.push_back(c);
-			if (TRACE_OP_GET_CONTINUATION(c))
-				return TRACE_STATE_TARGET_TIMESTAMP_CONT;
-			else
-				timestampEnd(false);
-			return TRACE_STATE_IDLE;
-		}
-
-		case TRACE_STATE_TARGET_TIMESTAMP_CONT:
-		{
-			timestampVec.push_back(c);
-			if (TRACE_OP_GET_CONTINUATION(c))
-				return TRACE_STATE_TARGET_TIMESTAMP_CONT;
-			else
-				timestampEnd(false);
-			return TRACE_STATE_IDLE;
-		}
-
-		case TRACE_STATE_SKIP_FRAME:
-			return TRACE_OP_GET_CONTINUATION(c) ? TRACE_STATE_SKIP_FRAME
-												: TRACE_STATE_IDLE;
-
-		default:
-			logger->critical("Invalid state! {}", state);
-			return TRACE_STATE_IDLE;
-	}
+	TraceIndicators indicators = traceIndicators;
+	indicators.tableOverflows = static_cast<uint32_t>(traceTable.getOverflowCount());
+	indicators.tableMaxDepth = static_cast<uint32_t>(traceTable.getMaxDepth());
+	indicators.rawBufferOverflows = static_cast<uint32_t>(rawBuffer.getOverflowCount());
+	indicators.rawBufferMaxDepth = static_cast<uint32_t>(rawBuffer.getMaxDepth());
+	return indicators;
 }
 
 void TraceReader::readerThread()
@@ -310,13 +179,37 @@ void TraceReader::readerThread()
 
 		traceIndicators.sleepCycles = 0;
 
-		for (int32_t i = 0; i < length; i++)
-		{
-			state = updateTrace(buffer[i]);
-			if (!isRunning)
-				break;
-		}
+		/* never blocks, bytes that do not fit in the ring are dropped and counted as overflows */
+		rawBuffer.pushN(buffer, length);
 	}
 	TraceProbe->stopTrace();
 	logger->info("Closing trace thread {}", isRunning);
-}
\ No newline at end of file
+}
+
+void TraceReader::decoderThread()
+{
+	while (isRunning)
+	{
+		size_t length = rawBuffer.popN(decodeBuffer, size);
+		if (length == 0)
+		{
+			rawBuffer.waitForData(std::chrono::microseconds(1000));
+			continue;
+		}
+
+		/* never blocks, events that do not fit in the table are dropped and counted as overflows */
+		for (size_t decoded = 0; decoded < length;)
+		{
+			auto result = decoder.decode(decodeBuffer + decoded, length - decoded, batch.data(), batch.size());
+			traceTable.pushN(batch.data(), result.events);
+			decoded += result.bytes;
+		}
+
+		auto statistics = decoder.getStatistics();
+		traceIndicators.framesTotal = statistics.framesTotal;
+		traceIndicators.errorFramesTotal = statistics.errorFramesTotal;
+		traceIndicators.delayedTimestamp1 = statistics.delayedTimestamp1;
+		traceIndicators.delayedTimestamp2 = statistics.delayedTimestamp2;
+		traceIndicators.delayedTimestamp3 = statistics.delayedTimestamp3;
+	}
+}
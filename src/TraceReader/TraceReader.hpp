@@ -1,6 +1,8 @@
 #ifndef _ITRACEREADER_HPP
 #define _ITRACEREADER_HPP
 
+#include <array>
+#include <chrono>
 #include <map>
 #include <memory>
 #include <string>
@@ -8,12 +10,15 @@
 #include <vector>
 
 #include "ITraceProbe.hpp"
-#include "RingBufferBlocking.hpp"
+#include "ItmDecoder.hpp"
+#include "SpscRingBuffer.hpp"
 #include "spdlog/spdlog.h"
 
 class TraceReader
 {
    public:
+	static constexpr uint32_t channels = ItmDecoder::channels;
+
 	struct TraceIndicators
 	{
 		uint32_t framesTotal;
@@ -24,6 +29,20 @@ class TraceReader
 		uint32_t delayedTimestamp3;
 		uint32_t delayedTimestamp3InView;
 		uint32_t sleepCycles;
+		/* events dropped because the data handler did not keep up */
+		uint32_t tableOverflows;
+		uint32_t tableMaxDepth;
+		/* raw bytes dropped because the decoder did not keep up */
+		uint32_t rawBufferOverflows;
+		uint32_t rawBufferMaxDepth;
+	};
+
+	struct TraceEvent
+	{
+		/* seconds since the acquisition start */
+		double timestamp;
+		uint8_t channel;
+		uint32_t value;
 	};
 
 	TraceReader(spdlog::logger* logger);
@@ -32,7 +51,8 @@ class TraceReader
 	bool stopAcqusition();
 	bool isValid() const;
 
-	bool readTrace(double& timestamp, std::array<uint32_t, 10>& trace);
+	/// @brief pops the oldest decoded event, waiting up to timeout for one when there is none
+	bool readTrace(TraceEvent& event, std::chrono::microseconds timeout = std::chrono::microseconds(0));
 
 	std::string getLastErrorMsg() const;
 
@@ -50,35 +70,21 @@ class TraceReader
 	TraceIndicators getTraceIndicators() const;
 
    private:
-	typedef enum
-	{
-		TRACE_STATE_UNKNOWN,
-		TRACE_STATE_IDLE,
-		TRACE_STATE_TARGET_SOURCE_1B,
-		TRACE_STATE_TARGET_SOURCE_2B,
-		TRACE_STATE_TARGET_SOURCE_3B,
-		TRACE_STATE_TARGET_SOURCE_4B,
-		TRACE_STATE_TARGET_TIMESTAMP_HEADER,
-		TRACE_STATE_TARGET_TIMESTAMP_CONT,
-		TRACE_STATE_TARGET_TIMESTAMP_END,
-		TRACE_STATE_SKIP_FRAME,
-	} TraceState;
-
-	TraceState state = TRACE_STATE_IDLE;
 	TraceIndicators traceIndicators{};
 
-	static constexpr uint32_t channels = 10;
 	static constexpr uint32_t size = 10 * 2048;
+	/* read from the probe by the reader thread */
 	uint8_t buffer[size]{};
+	/* taken from the raw ring by the decoder thread */
+	uint8_t decodeBuffer[size]{};
 
-	uint32_t currentValue[channels]{};
-	uint8_t currentChannel[channels]{};
-
-	uint8_t awaitingTimestamp = 0;
-	uint32_t timestamp = 0;
-	uint8_t sourceFrameSize = 0;
+	/* about 5 s of SWO data at 8 MHz, so that a stalled decoder does not stop the probe from being drained */
+	static constexpr size_t rawBufferSize = 4 * 1024 * 1024;
+	SpscRingBuffer<uint8_t> rawBuffer{rawBufferSize, true};
 
-	std::vector<uint8_t> timestampVec;
+	static constexpr size_t batchSize = 256;
+	ItmDecoder decoder;
+	std::array<ItmDecoder::Event, batchSize> batch{};
 
 	uint32_t coreFrequency = 160000;
 	uint32_t tracePrescaler = 10;
@@ -87,18 +93,17 @@ class TraceReader
 
 	std::atomic<bool> isRunning{false};
 	std::string lastErrorMsg = "";
-	std::array<uint32_t, channels> previousEntry{};
-	RingBufferBlocking<std::pair<std::array<uint32_t, channels>, double>, 2000> traceTable;
+	/* filled by the decoder thread, drained by the data handler thread */
+	SpscRingBuffer<ItmDecoder::Event> traceTable{4096, true};
 	std::thread readerHandle;
+	std::thread decoderHandle;
 
 	std::shared_ptr<ITraceProbe> TraceProbe;
 	spdlog::logger* logger;
 	mutable std::mutex mtx;
 
-	TraceState updateTraceIdle(uint8_t c);
-	TraceState updateTrace(uint8_t c);
-	void timestampEnd(bool headerData);
 	void readerThread();
+	void decoderThread();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "SampleDecoder.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+
+using DecodeFunction = void (*)(const uint8_t* words, uint32_t count, double* out, double scale);
+
+/* memcpy keeps the unaligned loads well defined, compilers turn the loop into plain vector code */
+template <typename Word>
+void decodeWords(const uint8_t* words, uint32_t count, double* out, double scale)
+{
+	for (uint32_t i = 0; i < count; i++)
+	{
+		Word word;
+		std::memcpy(&word, words + i * sizeof(Word), sizeof(Word));
+		out[i] = static_cast<double>(word) * scale;
+	}
+}
+
+template <typename Signed, typename Unsigned>
+DecodeFunction pick(bool isSigned)
+{
+	return isSigned ? decodeWords<Signed> : decodeWords<Unsigned>;
+}
+
+}  // namespace
+
+std::shared_ptr<SampleDecoder> SampleDecoder::create(const Variable& var)
+{
+	Variable::Fractional fractional = var.getFractional();
+	uint8_t width = var.getSize();
+
+	if (var.isFractional())
+	{
+		if (fractional.baseVariable != nullptr)
+			return nullptr;
+
+		bool isSigned = var.getHighLevelType() == Variable::HighLevelType::SIGNEDFRAC;
+		double scale = std::ldexp(fractional.base, -static_cast<int>(fractional.fractionalBits));
+
+		switch (width)
+		{
+			case 1:
+				return std::shared_ptr<SampleDecoder>(new SampleDecoder(width, pick<int8_t, uint8_t>(isSigned), scale));
+			case 2:
+				return std::shared_ptr<SampleDecoder>(new SampleDecoder(width, pick<int16_t, uint16_t>(isSigned), scale));
+			default:
+				return std::shared_ptr<SampleDecoder>(new SampleDecoder(width, pick<int32_t, uint32_t>(isSigned), scale));
+		}
+	}
+
+	SampleDecoder::DecodeFunction function = nullptr;
+	switch (var.getType())
+	{
+		case Variable::Type::U8:
+			function = decodeWords<uint8_t>;
+			break;
+		case Variable::Type::I8:
+			function = decodeWords<int8_t>;
+			break;
+		case Variable::Type::U16:
+			function = decodeWords<uint16_t>;
+			break;
+		case Variable::Type::I16:
+			function = decodeWords<int16_t>;
+			break;
+		case Variable::Type::U32:
+			function = decodeWords<uint32_t>;
+			break;
+		case Variable::Type::I32:
+			function = decodeWords<int32_t>;
+			break;
+		case Variable::Type::F32:
+			function = decodeWords<float>;
+			break;
+		default:
+			return nullptr;
+	}
+	return std::shared_ptr<SampleDecoder>(new SampleDecoder(width, function, 1.0));
+}
+
+SampleDecoder::SampleDecoder(uint8_t width, DecodeFunction function, double scale) : width(width), function(function), scale(scale)
+{
+}
+
+uint8_t SampleDecoder::getWidth() const
+{
+	return width;
+}
+
+void SampleDecoder::decode(const uint8_t* words, uint32_t count, double* out) const
+{
+	function(words, count, out, scale);
+}
+
+double SampleDecoder::decode(uint32_t word) const
+{
+	uint8_t bytes[sizeof(word)];
+	std::memcpy(bytes, &word, sizeof(word));
+	double value;
+	function(bytes, 1, &value, scale);
+	return value;
+}
@@ -0,0 +1,38 @@
+#ifndef __SAMPLEDECODER_HPP
+#define __SAMPLEDECODER_HPP
+
+#include <cstdint>
+#include <memory>
+
+#include "PackedCodec.hpp"
+#include "Variable.hpp"
+
+/// @brief Decode parameters of a variable captured at acquisition start, so that its raw words (shifted and
+/// masked already, see Variable::setRawValue) can be stored in their native width and converted to doubles
+/// later, in batches. The conversion matches Variable::transformToDouble.
+class SampleDecoder : public PackedCodec<double>
+{
+   public:
+	/// @return nullptr for variables that cannot be decoded later - unknown types and fractionals whose
+	/// base is another sampled variable, as the base changes over time
+	static std::shared_ptr<SampleDecoder> create(const Variable& var);
+
+	uint8_t getWidth() const override;
+	void decode(const uint8_t* words, uint32_t count, double* out) const override;
+
+	/// @brief decodes a single word
+	double decode(uint32_t word) const;
+
+   private:
+	using DecodeFunction = void (*)(const uint8_t* words, uint32_t count, double* out, double scale);
+
+	SampleDecoder(uint8_t width, DecodeFunction function, double scale);
+
+   private:
+	uint8_t width;
+	DecodeFunction function;
+	/* 1.0 or base / 2^fractionalBits for fractionals */
+	double scale;
+};
+
+#endif
@@ -45,6 +45,11 @@ void Variable::setRawValue(uint32_t rawValue)
 	this->rawValue = (rawValue >> shift) & mask;
 }
 
+uint32_t Variable::getRawValue() const
+{
+	return rawValue;
+}
+
 void Variable::setValue(double val)
 {
 	value = val;
@@ -122,7 +127,7 @@ void Variable::setIsFound(bool found)
 	isFound = found;
 }
 
-uint8_t Variable::getSize()
+uint8_t Variable::getSize() const
 {
 	switch (type)
 	{
@@ -50,6 +50,8 @@ class Variable
 	std::string getTypeStr() const;
 
 	void setRawValue(uint32_t value);
+	/// @brief raw value shifted and masked, as decoded by transformToDouble
+	uint32_t getRawValue() const;
 	void setValue(double val);
 	double getValue() const;
 
@@ -67,7 +69,7 @@ class Variable
 	bool getIsFound() const;
 	void setIsFound(bool found);
 
-	uint8_t getSize();
+	uint8_t getSize() const;
 
 	bool getShouldUpdateFromElf() const;
 	void setShouldUpdateFromElf(bool shouldUpdateFromElf);
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "CompressedHistory.hpp"
+
+namespace
+{
+
+std::vector<double> readAll(const CompressedHistory& history)
+{
+	std::vector<double> all;
+	std::vector<double> block;
+	for (size_t i = 0; i < history.getBlockCount(); i++)
+	{
+		history.readBlock(i, block);
+		all.insert(all.end(), block.begin(), block.end());
+	}
+	return all;
+}
+
+}  // namespace
+
+TEST(CompressedHistoryTest, valuesRoundTripBitExact)
+{
+	CompressedHistory history(CompressedHistory::Encoding::XOR);
+	std::mt19937 generator{42};
+	std::normal_distribution<double> noise(0.0, 1.0);
+
+	std::vector<double> values;
+	double walk = 0.0;
+	for (uint32_t i = 0; i < 5 * CompressedHistory::blockSize + 123; i++)
+	{
+		/* slowly changing integers, noisy floats and a few special values */
+		if (i % 3 == 0)
+			walk += std::round(noise(generator));
+		double value = i % 3 == 0 ? walk : (i % 3 == 1 ? static_cast<float>(noise(generator)) : noise(generator));
+		if (i == 100)
+			value = std::numeric_limits<double>::infinity();
+		if (i == 2000)
+			value = -0.0;
+		values.push_back(value);
+		history.append(value);
+	}
+
+	ASSERT_EQ(history.size(), values.size());
+	ASSERT_EQ(history.getBlockCount(), 6);
+
+	auto decoded = readAll(history);
+	ASSERT_EQ(decoded.size(), values.size());
+	ASSERT_EQ(std::memcmp(decoded.data(), values.data(), values.size() * sizeof(double)), 0);
+}
+
+TEST(CompressedHistoryTest, jitteryTimestampsKeepNanosecondResolution)
+{
+	CompressedHistory history(CompressedHistory::Encoding::DELTA_OF_DELTA);
+	std::mt19937 generator{7};
+	std::uniform_real_distribution<double> jitter(-5e-6, 5e-6);
+
+	constexpr uint32_t count = 100000;
+	std::vector<double> timestamps;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		timestamps.push_back(1000.0 + i * 1e-3 + (i % 10 == 0 ? jitter(generator) : 0.0));
+		history.append(timestamps.back());
+	}
+
+	auto decoded = readAll(history);
+	ASSERT_EQ(decoded.size(), count);
+	for (uint32_t i = 0; i < count; i++)
+		ASSERT_NEAR(decoded[i], timestamps[i], 1e-9);
+
+	/* raw storage would take 8 bytes per timestamp */
+	ASSERT_LT(history.getMemoryBytes(), count * sizeof(double) / 4);
+}
+
+TEST(CompressedHistoryTest, decimatesWideRangeFromSummaries)
+{
+	CompressedHistory time(CompressedHistory::Encoding::DELTA_OF_DELTA);
+	CompressedHistory values(CompressedHistory::Encoding::XOR);
+
+	constexpr uint32_t count = 1000000;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		time.append(i * 1e-3);
+		values.append(i == 654321 ? 100.0 : static_cast<double>(i % 7));
+	}
+
+	std::vector<double> xs;
+	std::vector<double> ys;
+	CompressedHistory::decimate(time, values, 0.0, count * 1e-3, 500, xs, ys);
+
+	ASSERT_LE(xs.size(), 2 * 500 + 2);
+	ASSERT_EQ(*std::max_element(ys.begin(), ys.end()), 100.0);
+
+	/* a narrow range is decoded and keeps every point */
+	CompressedHistory::decimate(time, values, 100.0, 100.5, 2000, xs, ys);
+	ASSERT_GE(xs.size(), 501);
+	ASSERT_NEAR(xs[0], 100.0 - (100000 % CompressedHistory::blockSize) * 1e-3, 1e-9);
+	for (size_t i = 0; i < xs.size(); i++)
+		ASSERT_EQ(ys[i], static_cast<double>(std::llround(xs[i] * 1e3) % 7));
+}
+
+TEST(CompressedHistoryTest, iteratesPointsInRange)
+{
+	CompressedHistory time(CompressedHistory::Encoding::DELTA_OF_DELTA);
+	CompressedHistory values(CompressedHistory::Encoding::XOR);
+
+	for (uint32_t i = 0; i < 10000; i++)
+	{
+		time.append(i * 0.01);
+		values.append(i);
+	}
+
+	size_t count = 0;
+	double sum = 0.0;
+	CompressedHistory::forEachInRange(time, values, 20.005, 30.0, [&](double, double value)
+									  { count++; sum += value; });
+
+	ASSERT_EQ(count, 1000);
+	ASSERT_EQ(sum, (2001.0 + 3000.0) * 1000 / 2);
+}
+
+TEST(CompressedHistoryTest, spilledSegmentsReadBackAndAreRemoved)
+{
+	auto directory = SpillDirectory::create(std::filesystem::temp_directory_path() / "MCUViewerTest");
+	ASSERT_NE(directory, nullptr);
+	std::filesystem::path path = directory->getPath();
+
+	std::vector<double> values;
+	{
+		CompressedHistory history(CompressedHistory::Encoding::XOR);
+		history.setSpill(directory, "values", 4096);
+		directory.reset();
+
+		std::mt19937 generator{7};
+		std::uniform_real_distribution<double> noise(-1.0, 1.0);
+		for (uint32_t i = 0; i < 40 * CompressedHistory::blockSize + 77; i++)
+		{
+			values.push_back(noise(generator));
+			history.append(values.back());
+		}
+
+		ASSERT_GT(history.getSegmentCount(), 1);
+		ASSERT_GT(history.getSpilledBytes(), history.getMemoryBytes());
+		ASSERT_EQ(std::distance(std::filesystem::directory_iterator(path), std::filesystem::directory_iterator{}), history.getSegmentCount());
+
+		/* out of order so that segments are mapped on demand */
+		std::vector<double> block;
+		history.readBlock(20, block);
+		ASSERT_EQ(block[5], values[20 * CompressedHistory::blockSize + 5]);
+		ASSERT_EQ(readAll(history), values);
+
+		history.clear();
+		ASSERT_EQ(history.getSegmentCount(), 0);
+		ASSERT_TRUE(std::filesystem::is_empty(path));
+	}
+
+	/* the session directory goes away with the last history using it */
+	ASSERT_FALSE(std::filesystem::exists(path));
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "IDebugProbe.hpp"
+#include "MemoryReadPlanner.hpp"
+
+/* serves reads from a memory image and counts the single reads issued */
+class CountingDebugProbe : public IDebugProbe
+{
+   public:
+	CountingDebugProbe(uint32_t baseAddress, size_t size) : baseAddress(baseAddress), image(size)
+	{
+		for (size_t i = 0; i < image.size(); i++)
+			image[i] = static_cast<uint8_t>(i);
+	}
+
+	bool startAcqusition(const DebugProbeSettings& probeSettings, std::vector<std::pair<uint32_t, uint8_t>>& addressSizeVector, uint32_t samplingFreqency) override { return true; }
+	bool stopAcqusition() override { return true; }
+	bool isValid() const override { return true; }
+	std::string getTargetName() override { return std::string(); }
+	std::optional<varEntryType> readSingleEntry() override { return std::nullopt; }
+
+	bool readMemory(uint32_t address, uint8_t* buf, uint32_t size) override
+	{
+		readCount++;
+		if (address < baseAddress || address + size > baseAddress + image.size())
+			return false;
+		std::memcpy(buf, &image[address - baseAddress], size);
+		return true;
+	}
+
+	bool writeMemory(uint32_t address, uint8_t* buf, uint32_t size) override { return false; }
+	std::string getLastErrorMsg() const override { return std::string(); }
+	std::vector<std::string> getConnectedDevices() override { return {}; }
+
+	size_t readCount = 0;
+
+   private:
+	uint32_t baseAddress;
+	std::vector<uint8_t> image;
+};
+
+TEST(DebugProbeTest, batchFallbackReadsElementByElement)
+{
+	CountingDebugProbe probe(0x20000000, 256);
+	uint32_t a = 0, b = 0, c = 0;
+
+	std::vector<IDebugProbe::ReadRequest> requests{{0x20000004, 4, (uint8_t*)&a}, {0x20000010, 2, (uint8_t*)&b}, {0x20000100, 4, (uint8_t*)&c}};
+
+	EXPECT_FALSE(probe.readMemoryBatch(requests));
+	EXPECT_EQ(probe.readCount, 3);
+
+	EXPECT_TRUE(requests[0].success);
+	EXPECT_TRUE(requests[1].success);
+	EXPECT_FALSE(requests[2].success);
+	EXPECT_EQ(a, 0x07060504);
+	EXPECT_EQ(b, 0x1110);
+}
+
+TEST(DebugProbeTest, batchOfPlannedBlocksIssuesReadPerBlock)
+{
+	CountingDebugProbe probe(0x20000000, 1024);
+
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList;
+	for (uint32_t i = 0; i < 100; i++)
+		sampleList.push_back({0x20000000 + i * 8, 4});
+
+	MemoryReadPlanner planner;
+	planner.plan(sampleList, {32, 256});
+
+	std::vector<IDebugProbe::ReadRequest> requests;
+	for (auto& block : planner.getBlocks())
+		requests.push_back({block.address, block.size, planner.getBuffer() + block.bufferOffset});
+
+	EXPECT_TRUE(probe.readMemoryBatch(requests));
+	EXPECT_EQ(probe.readCount, 4);
+
+	std::vector<uint32_t> rawValues(sampleList.size());
+	planner.scatter(rawValues.data());
+
+	EXPECT_EQ(rawValues[0], 0x03020100);
+	EXPECT_EQ(rawValues[99], 0x1b1a1918);
+}
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+
+#ifndef _WIN32
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+
+#include "GdbServerDebugProbe.hpp"
+#include "spdlog/sinks/null_sink.h"
+#include "spdlog/spdlog.h"
+
+/* minimal gdbserver serving a RAM image, replies are run length encoded */
+class FakeGdbStub
+{
+   public:
+	static constexpr uint32_t ramStart = 0x20000000;
+
+	FakeGdbStub() : ram(0x1000)
+	{
+		for (size_t i = 0; i < ram.size(); i++)
+			ram[i] = (i / 16) % 2 == 0 ? 0 : static_cast<uint8_t>(i * 7);
+
+		listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+		sockaddr_in address{};
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+		listen(listenSocket, 1);
+
+		socklen_t length = sizeof(address);
+		getsockname(listenSocket, reinterpret_cast<sockaddr*>(&address), &length);
+		port = ntohs(address.sin_port);
+
+		handle = std::thread(&FakeGdbStub::serve, this);
+	}
+
+	~FakeGdbStub()
+	{
+		shutdown(listenSocket, SHUT_RDWR);
+		close(listenSocket);
+		if (handle.joinable())
+			handle.join();
+	}
+
+	std::string getAddress() const { return "127.0.0.1:" + std::to_string(port); }
+
+	std::vector<uint8_t> ram;
+	std::atomic<uint32_t> readPackets = 0;
+	std::atomic<uint32_t> maxQueuedPackets = 0;
+	std::atomic<bool> noAckMode = false;
+
+   private:
+	void serve()
+	{
+		int connection = accept(listenSocket, nullptr, nullptr);
+		if (connection < 0)
+			return;
+
+		int noDelay = 1;
+		setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+		std::string buffer;
+		char chunk[4096];
+		ssize_t received;
+
+		while ((received = recv(connection, chunk, sizeof(chunk), 0)) > 0)
+		{
+			buffer.append(chunk, received);
+
+			uint32_t queued = 0;
+			for (size_t i = buffer.find('#'); i != std::string::npos; i = buffer.find('#', i + 1))
+				queued++;
+			maxQueuedPackets = std::max<uint32_t>(maxQueuedPackets, queued);
+
+			size_t start, end;
+			while ((start = buffer.find('$')) != std::string::npos && (end = buffer.find('#', start)) != std::string::npos && end + 2 < buffer.size())
+			{
+				std::string payload = buffer.substr(start + 1, end - start - 1);
+				buffer.erase(0, end + 3);
+
+				std::string reply = (noAckMode ? "" : "+") + GdbServerDebugProbe::encodePacket(respond(payload));
+				send(connection, reply.data(), reply.size(), MSG_NOSIGNAL);
+			}
+		}
+		close(connection);
+	}
+
+	std::string respond(const std::string& payload)
+	{
+		if (payload.starts_with("qSupported"))
+			return "PacketSize=108;QStartNoAckMode+";
+		if (payload == "QStartNoAckMode")
+		{
+			noAckMode = true;
+			return "OK";
+		}
+		if (payload == "?")
+			return "S05";
+
+		if (payload[0] == 'm' || payload[0] == 'M')
+		{
+			uint32_t address = 0, size = 0;
+			std::sscanf(payload.c_str() + 1, "%x,%x", &address, &size);
+			if (address < ramStart || address >= ramStart + ram.size())
+				return "E14";
+
+			size = std::min<uint32_t>(size, ramStart + ram.size() - address);
+			uint8_t* data = &ram[address - ramStart];
+
+			if (payload[0] == 'M')
+			{
+				const char* hex = payload.c_str() + payload.find(':') + 1;
+				for (uint32_t i = 0; i < size; i++)
+					std::sscanf(hex + 2 * i, "%2hhx", &data[i]);
+				return "OK";
+			}
+
+			readPackets++;
+			std::string reply;
+			for (uint32_t i = 0; i < size; i++)
+			{
+				char byte[3];
+				std::snprintf(byte, sizeof(byte), "%02x", data[i]);
+				reply += byte;
+			}
+			return runLengthEncode(reply);
+		}
+		return "";
+	}
+
+	static std::string runLengthEncode(const std::string& data)
+	{
+		std::string result;
+		for (size_t i = 0; i < data.size();)
+		{
+			size_t run = 1;
+			while (i + run < data.size() && data[i + run] == data[i] && run < 6)
+				run++;
+
+			/* a run of 6 is sent as the character and 5 repeats, '"' = 5 + 29 */
+			result += run == 6 ? std::string{data[i], '*', '"'} : data.substr(i, run);
+			i += run;
+		}
+		return result;
+	}
+
+	int listenSocket;
+	uint16_t port = 0;
+	std::thread handle;
+};
+
+class GdbServerDebugProbeTest : public ::testing::Test
+{
+   protected:
+	void SetUp() override
+	{
+		logger = std::make_shared<spdlog::logger>("gdbserver", std::make_shared<spdlog::sinks::null_sink_mt>());
+		probe = std::make_unique<GdbServerDebugProbe>(logger.get());
+		probeSettings.gdbServerAddress = stub.getAddress();
+		ASSERT_TRUE(probe->startAcqusition(probeSettings, sampleList, 1000));
+	}
+
+	FakeGdbStub stub;
+	std::shared_ptr<spdlog::logger> logger;
+	std::unique_ptr<GdbServerDebugProbe> probe;
+	IDebugProbe::DebugProbeSettings probeSettings{};
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList;
+};
+
+TEST(GdbServerDebugProbeCodecTest, decodesEscapesAndRunLength)
+{
+	EXPECT_EQ(GdbServerDebugProbe::decodePayload("0*\"1"), "0000001");
+	EXPECT_EQ(GdbServerDebugProbe::decodePayload("a}]b"), "a}b");
+	EXPECT_EQ(GdbServerDebugProbe::encodePacket("OK"), "$OK#9a");
+}
+
+TEST_F(GdbServerDebugProbeTest, mergesRequestsIntoFewPackets)
+{
+	EXPECT_TRUE(stub.noAckMode);
+
+	uint32_t first = 0, second = 0;
+	std::vector<uint8_t> block(300);
+	std::vector<IDebugProbe::ReadRequest> requests{{FakeGdbStub::ramStart + 0x104, 300, block.data()},
+												   {FakeGdbStub::ramStart + 0x14, 4, reinterpret_cast<uint8_t*>(&second)},
+												   {FakeGdbStub::ramStart + 0x10, 4, reinterpret_cast<uint8_t*>(&first)}};
+
+	ASSERT_TRUE(probe->readMemoryBatch(requests));
+
+	/* 8 bytes in one packet, 300 bytes split by the 128 B packet limit */
+	EXPECT_EQ(stub.readPackets, 4);
+	EXPECT_EQ(probe->getReadPacketCount(), 4);
+	EXPECT_EQ(std::memcmp(&first, &stub.ram[0x10], 4), 0);
+	EXPECT_EQ(std::memcmp(&second, &stub.ram[0x14], 4), 0);
+	EXPECT_EQ(std::memcmp(block.data(), &stub.ram[0x104], block.size()), 0);
+}
+
+TEST_F(GdbServerDebugProbeTest, pipelinesPacketsAndReportsFailedRequests)
+{
+	std::vector<uint32_t> values(20);
+	std::vector<IDebugProbe::ReadRequest> requests;
+	for (size_t i = 0; i < values.size(); i++)
+		requests.push_back({static_cast<uint32_t>(FakeGdbStub::ramStart + i * 64), 4, reinterpret_cast<uint8_t*>(&values[i])});
+
+	uint32_t outside = 0;
+	requests.push_back({0x08000000, 4, reinterpret_cast<uint8_t*>(&outside)});
+
+	EXPECT_FALSE(probe->readMemoryBatch(requests));
+	EXPECT_GT(stub.maxQueuedPackets, 1);
+
+	for (size_t i = 0; i < values.size(); i++)
+	{
+		EXPECT_TRUE(requests[i].success);
+		EXPECT_EQ(std::memcmp(&values[i], &stub.ram[i * 64], 4), 0);
+	}
+	EXPECT_FALSE(requests.back().success);
+	EXPECT_TRUE(probe->isValid());
+}
+
+TEST_F(GdbServerDebugProbeTest, writesMemory)
+{
+	float value = 3.14f;
+	ASSERT_TRUE(probe->writeMemory(FakeGdbStub::ramStart + 0x20, reinterpret_cast<uint8_t*>(&value), sizeof(value)));
+
+	float readBack = 0.0f;
+	ASSERT_TRUE(probe->readMemory(FakeGdbStub::ramStart + 0x20, reinterpret_cast<uint8_t*>(&readBack), sizeof(readBack)));
+	EXPECT_FLOAT_EQ(readBack, 3.14f);
+}
+
+#endif
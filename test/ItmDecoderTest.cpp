@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "ItmDecoder.hpp"
+
+namespace
+{
+
+/* the frames of TraceReaderTest.testdoubleBuffers followed by 2 and 4 byte sources sharing a delayed
+timestamp, an extension and a timestamp without sources */
+const std::vector<uint8_t> stream = {9, 187, 192, 206, 9,
+									 17, 170, 192, 35,
+									 17, 187, 192, 233, 2,
+									 9, 170, 192, 165, 1,
+									 18, 0x34, 0x12, 27, 0x78, 0x56, 0x34, 0x12, 0x88, 0x01, 0xd0, 5,
+									 25, 170, 0x30,
+									 0x20,
+									 9, 5, 0x10};
+
+std::vector<ItmDecoder::Event> decodeInPieces(ItmDecoder& decoder, const std::vector<uint8_t>& data, size_t split, size_t capacity)
+{
+	std::vector<ItmDecoder::Event> decoded;
+	std::vector<ItmDecoder::Event> batch(capacity);
+
+	for (size_t offset = 0; offset < data.size();)
+	{
+		size_t length = std::min(split, data.size() - offset);
+		for (size_t consumed = 0; consumed < length;)
+		{
+			auto result = decoder.decode(data.data() + offset + consumed, length - consumed, batch.data(), batch.size());
+			decoded.insert(decoded.end(), batch.begin(), batch.begin() + result.events);
+			consumed += result.bytes;
+		}
+		offset += length;
+	}
+	return decoded;
+}
+
+void expectEvent(const ItmDecoder::Event& event, uint64_t timestamp, uint8_t channel, uint32_t value)
+{
+	EXPECT_EQ(event.timestamp, timestamp);
+	EXPECT_EQ(event.channel, channel);
+	EXPECT_EQ(event.value, value);
+}
+
+}  // namespace
+
+TEST(ItmDecoderTest, decodesSourcesAndTimestamps)
+{
+	ItmDecoder decoder;
+	auto decoded = decodeInPieces(decoder, stream, stream.size(), 64);
+
+	ASSERT_EQ(decoded.size(), 8);
+	expectEvent(decoded[0], 1230, 1, 187);
+	expectEvent(decoded[1], 1265, 2, 170);
+	expectEvent(decoded[3], 1791, 1, 170);
+	expectEvent(decoded[4], 1796, 2, 0x1234);
+	expectEvent(decoded[5], 1796, 3, 0x12345678);
+	expectEvent(decoded[6], 1799, 3, 170);
+	expectEvent(decoded[7], 1802, 1, 5);
+
+	auto statistics = decoder.getStatistics();
+	EXPECT_EQ(statistics.framesTotal, 17);
+	EXPECT_EQ(statistics.errorFramesTotal, 0);
+	EXPECT_EQ(statistics.delayedTimestamp1, 1);
+}
+
+TEST(ItmDecoderTest, splittingTheStreamDoesNotChangeTheResult)
+{
+	ItmDecoder reference;
+	auto expected = decodeInPieces(reference, stream, stream.size(), 64);
+
+	for (size_t split = 1; split < stream.size(); split++)
+	{
+		for (size_t capacity : {ItmDecoder::channels, ItmDecoder::channels + 1, 64u})
+		{
+			ItmDecoder decoder;
+			auto decoded = decodeInPieces(decoder, stream, split, capacity);
+			ASSERT_EQ(decoded.size(), expected.size()) << "split " << split << " capacity " << capacity;
+			for (size_t i = 0; i < decoded.size(); i++)
+				expectEvent(decoded[i], expected[i].timestamp, expected[i].channel, expected[i].value);
+			EXPECT_EQ(decoder.getStatistics().framesTotal, reference.getStatistics().framesTotal);
+		}
+	}
+}
+
+TEST(ItmDecoderTest, decodesAllPortsAndCountsUnknownHeaders)
+{
+	/* a sync byte, a hardware source header and sources on ports 12 and 31 */
+	std::vector<uint8_t> data = {0x00, 0x05, 0x61, 1, 0xf9, 2, 0x30};
+
+	ItmDecoder decoder;
+	auto decoded = decodeInPieces(decoder, data, data.size(), ItmDecoder::channels);
+
+	ASSERT_EQ(decoded.size(), 2);
+	expectEvent(decoded[0], 3, 12, 1);
+	expectEvent(decoded[1], 3, 31, 2);
+	EXPECT_EQ(decoder.getStatistics().errorFramesTotal, 2);
+
+	decoder.reset();
+	EXPECT_EQ(decoder.getStatistics().framesTotal, 0);
+}
@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <vector>
+
+#include "MemoryReadPlanner.hpp"
+
+TEST(MemoryReadPlannerTest, mergesNeighbouringAndOverlappingRanges)
+{
+	/* u32 and a u8 bitfield inside it, neighbouring struct members and a far away variable */
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList{{0x20000104, 4}, {0x20000000, 4}, {0x20000001, 1}, {0x20000004, 2}, {0x20000008, 4}};
+
+	MemoryReadPlanner planner;
+	planner.plan(sampleList, {16, 1024});
+
+	auto& blocks = planner.getBlocks();
+	ASSERT_EQ(blocks.size(), 2);
+	EXPECT_EQ(blocks[0].address, 0x20000000);
+	EXPECT_EQ(blocks[0].size, 12);
+	EXPECT_EQ(blocks[1].address, 0x20000104);
+	EXPECT_EQ(blocks[1].size, 4);
+}
+
+TEST(MemoryReadPlannerTest, respectsGapAndBlockSizeLimits)
+{
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList{{0x20000000, 4}, {0x20000010, 4}, {0x20000020, 4}, {0x20000024, 4}};
+
+	MemoryReadPlanner planner;
+	planner.plan(sampleList, {8, 1024});
+	EXPECT_EQ(planner.getBlocks().size(), 3);
+
+	planner.plan(sampleList, {64, 32});
+	EXPECT_EQ(planner.getBlocks().size(), 2);
+}
+
+TEST(MemoryReadPlannerTest, doesNotBridgeGapsInPeripheralRegion)
+{
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList{{0x40000000, 4}, {0x40000008, 4}, {0x4000000C, 2}};
+
+	MemoryReadPlanner planner;
+	planner.plan(sampleList, {32, 1024});
+
+	auto& blocks = planner.getBlocks();
+	ASSERT_EQ(blocks.size(), 2);
+	EXPECT_EQ(blocks[1].address, 0x40000008);
+	EXPECT_EQ(blocks[1].size, 8);
+}
+
+TEST(MemoryReadPlannerTest, scattersValuesInSampleListOrder)
+{
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList{{0x20000006, 2}, {0x20000000, 4}, {0x20000001, 1}, {0x20000003, 1}};
+
+	MemoryReadPlanner planner;
+	planner.plan(sampleList, {});
+	ASSERT_EQ(planner.getBlocks().size(), 1);
+
+	const uint8_t memory[8] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88};
+	std::memcpy(planner.getBuffer() + planner.getBlocks()[0].bufferOffset, memory, sizeof(memory));
+
+	std::vector<uint32_t> rawValues(sampleList.size());
+	planner.scatter(rawValues.data());
+
+	EXPECT_EQ(rawValues[0], 0x8877);
+	EXPECT_EQ(rawValues[1], 0x44332211);
+	EXPECT_EQ(rawValues[2], 0x22);
+	EXPECT_EQ(rawValues[3], 0x44);
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "MinMaxPyramid.hpp"
+#include "ScrollingBuffer.hpp"
+
+class MinMaxPyramidTest : public ::testing::Test
+{
+   protected:
+	void SetUp() override
+	{
+		time.setMaxSize(maxSize);
+		values.setMaxSize(maxSize);
+	}
+
+	static double valueAt(uint64_t i)
+	{
+		return static_cast<double>((i * 7919) % 1009);
+	}
+
+	void addPoints(uint64_t count)
+	{
+		for (uint64_t i = 0; i < count; i++, written++)
+		{
+			time.addPoint(static_cast<double>(written));
+			values.addPoint(valueAt(written));
+		}
+		time.copyData();
+		values.copyData();
+		pyramid.update(values);
+	}
+
+	static constexpr uint32_t maxSize = 1000;
+	uint64_t written = 0;
+	ScrollingBuffer<double> time;
+	ScrollingBuffer<double> values;
+	MinMaxPyramid<double> pyramid;
+	std::vector<double> xs;
+	std::vector<double> ys;
+};
+
+TEST_F(MinMaxPyramidTest, returnsRawPointsWhenFewerThanTwoPerBucket)
+{
+	addPoints(100);
+	pyramid.decimate(time, values, 10.0, 20.0, 50, xs, ys);
+
+	ASSERT_EQ(xs.size(), 12);
+	ASSERT_EQ(xs.front(), 9.0);
+	ASSERT_EQ(xs.back(), 20.0);
+	for (size_t i = 0; i < xs.size(); i++)
+		ASSERT_EQ(ys[i], valueAt(static_cast<uint64_t>(xs[i])));
+}
+
+TEST_F(MinMaxPyramidTest, bucketsMatchBruteForceAfterWrapping)
+{
+	/* incremental updates of an odd size so that buckets are completed across several updates */
+	while (written < 3500)
+		addPoints(37);
+
+	const double xMin = 2600.5;
+	const double xMax = 3400.0;
+	const uint32_t maxBuckets = 20;
+	pyramid.decimate(time, values, xMin, xMax, maxBuckets, xs, ys);
+
+	ASSERT_EQ(xs.size() % 2, 0);
+	ASSERT_LE(xs.size(), 2 * (maxBuckets + 2));
+	ASSERT_EQ(xs.front(), 2600.0);
+
+	/* every pair is the extent of the points from its time up to the time of the next pair */
+	for (size_t pair = 0; pair < xs.size(); pair += 2)
+	{
+		uint64_t first = static_cast<uint64_t>(xs[pair]);
+		uint64_t last = pair + 2 < xs.size() ? static_cast<uint64_t>(xs[pair + 2]) : 3401;
+
+		double min = valueAt(first);
+		double max = valueAt(first);
+		for (uint64_t i = first; i < last; i++)
+		{
+			min = std::min(min, valueAt(i));
+			max = std::max(max, valueAt(i));
+		}
+		ASSERT_EQ(xs[pair], xs[pair + 1]);
+		ASSERT_EQ(ys[pair], min) << "bucket at " << first;
+		ASSERT_EQ(ys[pair + 1], max) << "bucket at " << first;
+	}
+}
+
+TEST_F(MinMaxPyramidTest, keepsSingleSpikeInWholeWindow)
+{
+	addPoints(2500);
+	values.erase();
+	time.erase();
+	written = 0;
+
+	for (uint64_t i = 0; i < maxSize; i++)
+	{
+		time.addPoint(static_cast<double>(i));
+		values.addPoint(i == 777 ? 5000.0 : 0.0);
+	}
+	time.copyData();
+	values.copyData();
+	pyramid.update(values);
+
+	pyramid.decimate(time, values, 0.0, maxSize, 8, xs, ys);
+
+	ASSERT_LE(xs.size(), 2 * (8 + 2));
+	ASSERT_EQ(*std::max_element(ys.begin(), ys.end()), 5000.0);
+	ASSERT_EQ(std::count(ys.begin(), ys.end(), 5000.0), 1);
+}
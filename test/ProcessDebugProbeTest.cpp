@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+
+#ifdef __linux__
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <memory>
+
+#include "ProcessDebugProbe.hpp"
+#include "spdlog/sinks/null_sink.h"
+#include "spdlog/spdlog.h"
+
+static volatile uint32_t sampledCounter = 0x12345678;
+static volatile float sampledValues[4] = {1.0f, 2.0f, 3.0f, 4.0f};
+alignas(4096) static uint8_t inaccessiblePage[4096];
+
+class ProcessDebugProbeTest : public ::testing::Test
+{
+   protected:
+	void SetUp() override
+	{
+		logger = std::make_shared<spdlog::logger>("process", std::make_shared<spdlog::sinks::null_sink_mt>());
+		probe = std::make_unique<ProcessDebugProbe>(logger.get());
+		probeSettings.serialNumber = std::to_string(getpid()) + " MCUViewer_test";
+	}
+
+	/* link time address of a variable of this process, as it would be read from the *.elf file */
+	uint32_t linkAddress(volatile void* variable)
+	{
+		return static_cast<uint32_t>(reinterpret_cast<uintptr_t>(variable) - probe->getLoadBias());
+	}
+
+	std::shared_ptr<spdlog::logger> logger;
+	std::unique_ptr<ProcessDebugProbe> probe;
+	IDebugProbe::DebugProbeSettings probeSettings{};
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList;
+};
+
+TEST_F(ProcessDebugProbeTest, relocatesLinkTimeAddresses)
+{
+	ASSERT_TRUE(probe->startAcqusition(probeSettings, sampleList, 1000));
+	ASSERT_LT(reinterpret_cast<uintptr_t>(&sampledCounter) - probe->getLoadBias(), 0x100000000ull);
+
+	uint32_t counter = 0;
+	ASSERT_TRUE(probe->readMemory(linkAddress(&sampledCounter), reinterpret_cast<uint8_t*>(&counter), sizeof(counter)));
+	EXPECT_EQ(counter, 0x12345678);
+
+	counter = 42;
+	ASSERT_TRUE(probe->writeMemory(linkAddress(&sampledCounter), reinterpret_cast<uint8_t*>(&counter), sizeof(counter)));
+	EXPECT_EQ(sampledCounter, 42);
+}
+
+TEST_F(ProcessDebugProbeTest, readsBatchInSingleCallAndReportsFailures)
+{
+	ASSERT_TRUE(probe->startAcqusition(probeSettings, sampleList, 1000));
+
+	uint32_t counter = 0;
+	float values[4]{};
+	uint32_t unmapped = 0;
+	std::vector<IDebugProbe::ReadRequest> requests{{linkAddress(&sampledCounter), 4, reinterpret_cast<uint8_t*>(&counter)},
+												   {linkAddress(&sampledValues), sizeof(values), reinterpret_cast<uint8_t*>(values)}};
+
+	ASSERT_TRUE(probe->readMemoryBatch(requests));
+	EXPECT_TRUE(requests[0].success);
+	EXPECT_TRUE(requests[1].success);
+	EXPECT_FLOAT_EQ(values[3], 4.0f);
+
+	ASSERT_EQ(mprotect(inaccessiblePage, sizeof(inaccessiblePage), PROT_NONE), 0);
+	requests.push_back({linkAddress(inaccessiblePage), 4, reinterpret_cast<uint8_t*>(&unmapped)});
+	bool result = probe->readMemoryBatch(requests);
+	mprotect(inaccessiblePage, sizeof(inaccessiblePage), PROT_READ | PROT_WRITE);
+
+	EXPECT_FALSE(result);
+	EXPECT_TRUE(requests[0].success);
+	EXPECT_TRUE(requests[1].success);
+	EXPECT_FALSE(requests[2].success);
+}
+
+TEST_F(ProcessDebugProbeTest, rejectsInvalidProcess)
+{
+	probeSettings.serialNumber = "no process";
+	EXPECT_FALSE(probe->startAcqusition(probeSettings, sampleList, 1000));
+	EXPECT_FALSE(probe->getLastErrorMsg().empty());
+}
+
+#endif
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <filesystem>
+#include <memory>
+
+#include "RecordingDebugProbe.hpp"
+#include "ReplayDebugProbe.hpp"
+#include "SimulatedDebugProbe.hpp"
+#include "spdlog/sinks/null_sink.h"
+#include "spdlog/spdlog.h"
+
+class ReplayDebugProbeTest : public ::testing::Test
+{
+   protected:
+	void SetUp() override
+	{
+		logger = std::make_shared<spdlog::logger>("replay", std::make_shared<spdlog::sinks::null_sink_mt>());
+		simulatedProbe = std::make_shared<SimulatedDebugProbe>(logger.get());
+		capturePath = (std::filesystem::temp_directory_path() / "MCUViewer_replay_test.cap").string();
+
+		probeSettings.simulationLatencyUs = 0;
+		probeSettings.simulationBandwidthKBps = 100000;
+		probeSettings.simulationGenerators = "0x20000000 counter 1 0.001 u32; 0x20000004 noise 100 1 i16";
+		probeSettings.replayFilePath = capturePath;
+		probeSettings.replayRealTime = false;
+		sampleList = {{0x20000000, 4}, {0x20000004, 2}};
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove(capturePath);
+	}
+
+	std::shared_ptr<spdlog::logger> logger;
+	std::shared_ptr<SimulatedDebugProbe> simulatedProbe;
+	std::string capturePath;
+	IDebugProbe::DebugProbeSettings probeSettings{};
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList;
+};
+
+TEST_F(ReplayDebugProbeTest, replaysRecordedReads)
+{
+	std::vector<std::array<uint8_t, 8>> recorded;
+	{
+		RecordingDebugProbe recorder(simulatedProbe, capturePath, logger.get());
+		ASSERT_TRUE(recorder.startAcqusition(probeSettings, sampleList, 1000));
+
+		for (size_t i = 0; i < 50; i++)
+		{
+			std::array<uint8_t, 8> sample{};
+			std::vector<IDebugProbe::ReadRequest> requests{{0x20000000, 4, sample.data()}, {0x20000004, 2, sample.data() + 4}};
+			ASSERT_TRUE(recorder.readMemoryBatch(requests));
+			recorded.push_back(sample);
+		}
+		ASSERT_TRUE(recorder.stopAcqusition());
+	}
+
+	ReplayDebugProbe replay(logger.get());
+	ASSERT_TRUE(replay.startAcqusition(probeSettings, sampleList, 1000));
+
+	for (auto& expected : recorded)
+	{
+		std::array<uint8_t, 8> sample{};
+		ASSERT_TRUE(replay.readMemory(0x20000000, sample.data(), 4));
+		ASSERT_TRUE(replay.readMemory(0x20000004, sample.data() + 4, 2));
+		EXPECT_EQ(sample, expected);
+	}
+
+	uint8_t byte = 0;
+	EXPECT_FALSE(replay.readMemory(0x20000000, &byte, 1));
+	EXPECT_FALSE(replay.isValid());
+	EXPECT_EQ(replay.getSkippedRecordCount(), 0);
+}
+
+TEST_F(ReplayDebugProbeTest, replaysHssEntriesAndRejectsModeMismatch)
+{
+	probeSettings.mode = IDebugProbe::Mode::HSS;
+	std::vector<IDebugProbe::varEntryType> recorded;
+	{
+		RecordingDebugProbe recorder(simulatedProbe, capturePath, logger.get());
+		ASSERT_TRUE(recorder.startAcqusition(probeSettings, sampleList, 10000));
+
+		while (recorded.size() < 100)
+		{
+			auto entry = recorder.readSingleEntry();
+			if (entry.has_value())
+				recorded.push_back(*entry);
+		}
+		recorder.stopAcqusition();
+	}
+
+	ReplayDebugProbe replay(logger.get());
+	ASSERT_TRUE(replay.startAcqusition(probeSettings, sampleList, 10000));
+
+	for (auto& expected : recorded)
+	{
+		auto entry = replay.readSingleEntry();
+		ASSERT_TRUE(entry.has_value());
+		EXPECT_EQ(*entry, expected);
+	}
+	EXPECT_FALSE(replay.readSingleEntry().has_value());
+	EXPECT_FALSE(replay.isValid());
+
+	probeSettings.mode = IDebugProbe::Mode::NORMAL;
+	EXPECT_FALSE(replay.startAcqusition(probeSettings, sampleList, 10000));
+	EXPECT_FALSE(replay.getLastErrorMsg().empty());
+}
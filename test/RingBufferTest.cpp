@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <chrono>
+#include <thread>
 
 #include "RingBuffer.hpp"
+#include "SpscRingBuffer.hpp"
 
 TEST(RingBufferTest, testpushpop)
 {
@@ -20,3 +23,90 @@ TEST(RingBufferTest, testpushpop)
 	ASSERT_EQ(ringBuffer.pop(), array2);
 	ASSERT_EQ(ringBuffer.pop(), array3);
 }
+
+TEST(RingBufferTest, testSpscPushPopAndOverflow)
+{
+	SpscRingBuffer<uint32_t> ringBuffer(3);
+	ASSERT_EQ(ringBuffer.capacity(), 4);
+
+	for (uint32_t i = 0; i < 6; i++)
+		ringBuffer.push(i);
+
+	ASSERT_EQ(ringBuffer.size(), 4);
+	ASSERT_EQ(ringBuffer.getOverflowCount(), 2);
+	ASSERT_EQ(ringBuffer.getMaxDepth(), 4);
+
+	for (uint32_t i = 0; i < 4; i++)
+	{
+		ASSERT_EQ(*ringBuffer.front(), i);
+		ringBuffer.pop();
+	}
+	ASSERT_EQ(ringBuffer.front(), nullptr);
+}
+
+TEST(RingBufferTest, testSpscTwoThreads)
+{
+	SpscRingBuffer<uint64_t> ringBuffer(64);
+	constexpr uint64_t count = 200000;
+
+	std::thread producer([&]()
+						 {
+		for (uint64_t i = 0; i < count; i++)
+			while (!ringBuffer.push(i)); });
+
+	uint64_t expected = 0;
+	while (expected < count)
+	{
+		auto* item = ringBuffer.front();
+		if (item == nullptr)
+			continue;
+		ASSERT_EQ(*item, expected++);
+		ringBuffer.pop();
+	}
+	producer.join();
+}
+
+TEST(RingBufferTest, testSpscBulkAcrossWrap)
+{
+	SpscRingBuffer<uint32_t> ringBuffer(8);
+	std::array<uint32_t, 16> items;
+	for (uint32_t i = 0; i < items.size(); i++)
+		items[i] = i;
+
+	ASSERT_EQ(ringBuffer.pushN(items.data(), 5), 5);
+
+	std::array<uint32_t, 16> out{};
+	ASSERT_EQ(ringBuffer.popN(out.data(), 3), 3);
+	ASSERT_EQ(out[2], 2);
+
+	/* 2 items left, the next 6 wrap around the end of the storage */
+	ASSERT_EQ(ringBuffer.pushN(items.data() + 5, 6), 6);
+	ASSERT_EQ(ringBuffer.pushN(items.data() + 11, 2), 0);
+	ASSERT_EQ(ringBuffer.getOverflowCount(), 2);
+
+	ASSERT_EQ(ringBuffer.popN(out.data(), out.size()), 8);
+	for (uint32_t i = 0; i < 8; i++)
+		ASSERT_EQ(out[i], i + 3);
+	ASSERT_EQ(ringBuffer.popN(out.data(), out.size()), 0);
+}
+
+TEST(RingBufferTest, testSpscBlockingWait)
+{
+	SpscRingBuffer<uint32_t> ringBuffer(16, true);
+
+	ASSERT_FALSE(ringBuffer.waitForData(std::chrono::microseconds(1000)));
+
+	std::thread producer([&]()
+						 {
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		ringBuffer.push(42); });
+
+	auto start = std::chrono::steady_clock::now();
+	ASSERT_TRUE(ringBuffer.waitForData(std::chrono::seconds(10)));
+	ASSERT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(5));
+
+	uint32_t item = 0;
+	ASSERT_TRUE(ringBuffer.tryPop(item));
+	ASSERT_EQ(item, 42);
+	producer.join();
+}
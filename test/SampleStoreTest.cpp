@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "SampleStore.hpp"
+#include "Variable.hpp"
+
+TEST(SampleStoreTest, variableHasSingleColumn)
+{
+	SampleStore store;
+	Variable first{"first"};
+	Variable second{"second"};
+
+	auto column = store.getColumn(&first);
+
+	ASSERT_EQ(store.getColumn(&first), column);
+	ASSERT_NE(store.getColumn(&second), column);
+	ASSERT_EQ(store.getTimeColumn(), store.getTimeColumn());
+	ASSERT_EQ(store.getColumnCount(), 2);
+
+	/* every view of the column sees the point appended once */
+	column->addPoint(1.0);
+	ASSERT_EQ(store.getColumn(&first)->getSize(), 1);
+}
+
+TEST(SampleStoreTest, maxPointsApplyToExistingAndNewColumns)
+{
+	SampleStore store;
+	Variable first{"first"};
+	Variable second{"second"};
+
+	auto column = store.getColumn(&first);
+	store.setMaxPoints(50);
+
+	ASSERT_EQ(column->getMaxSize(), 50);
+	ASSERT_EQ(store.getTimeColumn()->getMaxSize(), 50);
+	ASSERT_EQ(store.getColumn(&second)->getMaxSize(), 50);
+}
+
+TEST(SampleStoreTest, clearKeepsReferencedColumnsAlive)
+{
+	SampleStore store;
+	BufferArena arena;
+	Variable var{"var"};
+	store.setArena(&arena);
+
+	auto column = store.getColumn(&var);
+	column->addPoint(3.0);
+	column->copyData();
+	store.clear();
+
+	ASSERT_EQ(store.getColumnCount(), 0);
+	ASSERT_NE(store.getColumn(&var), column);
+	ASSERT_EQ(column->getNewestValue(), 3.0);
+	ASSERT_GT(arena.getAllocatedBytes(), 0);
+}
+
+TEST(SampleStoreTest, packedColumnsStoreNativeWidth)
+{
+	SampleStore store;
+	Variable var{"var"};
+	var.setType(Variable::Type::I16);
+	store.setMaxPoints(1000);
+	store.setPackingEnabled(true);
+
+	auto column = store.getColumn(&var);
+	ASSERT_TRUE(column->isPacked());
+	ASSERT_FALSE(store.getTimeColumn()->isPacked());
+
+	for (int16_t value : {-3, 7, -32768})
+		column->addRaw(static_cast<uint16_t>(value));
+	column->copyData();
+
+	EXPECT_EQ(column->getCopyValue(0), -3.0);
+	EXPECT_EQ(column->getCopyValue(2), -32768.0);
+	EXPECT_EQ(column->getValue(1), 7.0);
+	EXPECT_EQ(column->getAllocatedBytes(), 1000 * (sizeof(int16_t) + sizeof(double)));
+}
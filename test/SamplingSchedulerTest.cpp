@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+#include <thread>
+
+#include "SamplingScheduler.hpp"
+
+static size_t takeSamples(SamplingScheduler& scheduler, size_t count, std::chrono::milliseconds readTime = std::chrono::milliseconds(0))
+{
+	size_t taken = 0;
+	while (taken < count)
+	{
+		if (!scheduler.isSampleDue())
+			continue;
+		std::this_thread::sleep_for(readTime);
+		taken++;
+	}
+	return taken;
+}
+
+TEST(SamplingSchedulerTest, keepsAbsoluteDeadlines)
+{
+	SamplingScheduler scheduler;
+	auto start = SamplingScheduler::Clock::now();
+	scheduler.start(1000.0, SamplingScheduler::OverrunPolicy::CATCH_UP);
+
+	takeSamples(scheduler, 21);
+	auto elapsed = SamplingScheduler::Clock::now() - start;
+
+	EXPECT_GE(elapsed, std::chrono::milliseconds(20));
+
+	auto histogram = scheduler.getLatenessHistogram();
+	EXPECT_EQ(std::accumulate(histogram.begin(), histogram.end(), uint64_t(0)), 21);
+	EXPECT_EQ(scheduler.getSkippedCount(), 0);
+}
+
+TEST(SamplingSchedulerTest, skipsMissedDeadlinesOnOverrun)
+{
+	SamplingScheduler scheduler;
+	scheduler.start(1000.0, SamplingScheduler::OverrunPolicy::SKIP);
+
+	/* every read takes longer than the period */
+	takeSamples(scheduler, 5, std::chrono::milliseconds(3));
+
+	EXPECT_GE(scheduler.getSkippedCount(), 8);
+}
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <iostream>
 #include <numeric>
+#include <thread>
 
 #include "ScrollingBuffer.hpp"
 
@@ -60,6 +61,33 @@ TEST_F(ScrollingBufferTest, testIndexLookup2)
 	ASSERT_EQ(test.getIndexFromvalue(21), 0);
 }
 
+TEST_F(ScrollingBufferTest, testCopyIndexLookupAcrossWrap)
+{
+	/* the snapshot holds 6..25, with 21..25 wrapped to the start of the storage */
+	ASSERT_EQ(test.upperBoundCopy(10.5), 5);
+	ASSERT_EQ(test.upperBoundCopy(21.0), 16);
+	ASSERT_EQ(test.getCopyValue(test.getCopyIndexAt(10.0)), 10.0);
+	ASSERT_EQ(test.getCopyValue(test.getCopyIndexAt(23.5)), 23.0);
+	ASSERT_EQ(test.getCopyIndexAt(0.0), 0);
+	ASSERT_EQ(test.getCopyIndexAt(100.0), defaultMaxSize - 1);
+}
+
+TEST_F(ScrollingBufferTest, testCopyRangeSpans)
+{
+	auto range = test.getCopyRange(3, 18);
+	ASSERT_EQ(range.first.size, 12);
+	ASSERT_EQ(range.second.size, 3);
+
+	std::vector<double> values;
+	range.forEach([&](double value)
+				  { values.push_back(value); });
+	std::vector<double> result{9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23};
+	ASSERT_EQ(values, result);
+
+	ASSERT_EQ(test.getCopyRange(2, 10).second.size, 0);
+	ASSERT_EQ(test.getCopyRange(10, 10).size(), 0);
+}
+
 TEST_F(ScrollingBufferTest, testOldestValue)
 {
 	ASSERT_EQ(test.getOldestValue(), 6);
@@ -89,4 +117,194 @@ TEST_F(ScrollingBufferTest, testLinearCopy3)
 	auto vec = test.getLinearData(0, 0);
 	std::vector<double> result{21, 22, 23, 24, 25, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20};
 	ASSERT_EQ(vec, result);
-}
\ No newline at end of file
+}
+TEST(ScrollingBufferAllocationTest, allocatesOnFirstPoint)
+{
+	ScrollingBuffer<double> buffer;
+	buffer.setMaxSize(1000000);
+
+	EXPECT_EQ(buffer.getAllocatedBytes(), 0);
+	EXPECT_EQ(buffer.getSize(), 0);
+	EXPECT_EQ(*buffer.getLastElement(), 0.0);
+	buffer.copyData();
+	EXPECT_EQ(buffer.getAllocatedBytes(), 0);
+
+	buffer.addPoint(1.0);
+	EXPECT_EQ(buffer.getAllocatedBytes(), 1000000 * sizeof(double));
+	buffer.copyData();
+	EXPECT_EQ(buffer.getAllocatedBytes(), 2 * 1000000 * sizeof(double));
+	EXPECT_EQ(*buffer.getFirstElementCopy(), 1.0);
+
+	buffer.setMaxSize(10);
+	EXPECT_EQ(buffer.getAllocatedBytes(), 0);
+	EXPECT_EQ(buffer.getSize(), 0);
+}
+
+TEST(ScrollingBufferAllocationTest, drawsFromArenaAndReleasesInBulk)
+{
+	BufferArena arena(1024);
+	std::vector<ScrollingBuffer<double>> buffers(10);
+
+	for (auto& buffer : buffers)
+	{
+		buffer.setArena(&arena);
+		buffer.setMaxSize(100);
+	}
+
+	/* the points live in pooled chunks, the arena backs the snapshots */
+	for (size_t i = 0; i < buffers.size(); i += 2)
+	{
+		for (uint32_t point = 0; point < 150; point++)
+			buffers[i].addPoint(point);
+		buffers[i].copyData();
+	}
+
+	EXPECT_EQ(arena.getAllocatedBytes(), 5 * 100 * sizeof(double));
+	EXPECT_EQ(buffers[0].getNewestValue(), 149.0);
+	EXPECT_EQ(buffers[0].getOldestValue(), 50.0);
+	EXPECT_EQ(buffers[1].getSize(), 0);
+
+	for (auto& buffer : buffers)
+		buffer.release();
+	arena.reset();
+
+	EXPECT_EQ(arena.getReservedBytes(), 0);
+	buffers[1].addPoint(5.0);
+	buffers[1].copyData();
+	EXPECT_EQ(buffers[1].getNewestValue(), 5.0);
+	EXPECT_EQ(arena.getAllocatedBytes(), 100 * sizeof(double));
+}
+
+TEST(ScrollingBufferSnapshotTest, copiesOnlyNewPoints)
+{
+	ScrollingBuffer<double> buffer;
+	buffer.setMaxSize(8);
+
+	for (uint32_t i = 0; i < 5; i++)
+		buffer.addPoint(i);
+	buffer.copyData();
+
+	/* the snapshot keeps the old values until the next copy */
+	for (uint32_t i = 5; i < 11; i++)
+		buffer.addPoint(i);
+	EXPECT_EQ(buffer.getFirstElementCopy()[0], 0.0);
+
+	buffer.copyData();
+	for (uint32_t i = 0; i < buffer.getSize(); i++)
+		EXPECT_EQ(buffer.getFirstElementCopy()[i], buffer.getFirstElement()[i]);
+	EXPECT_EQ(buffer.getOffset(), 3);
+	EXPECT_EQ(buffer.getOldestValue(), 3.0);
+}
+
+TEST(ScrollingBufferSnapshotTest, readerSeesConsistentSnapshotsWhileWriting)
+{
+	static constexpr uint32_t maxSize = 1000;
+	static constexpr uint32_t points = 2000000;
+
+	ScrollingBuffer<double> buffer;
+	buffer.setMaxSize(maxSize);
+	buffer.addPoint(0.0);
+
+	std::thread writer([&]()
+					   { for (uint32_t i = 1; i < points; i++) buffer.addPoint(i); });
+
+	double last = 0.0;
+	while (last < points - 1)
+	{
+		buffer.copyData();
+		uint32_t offset = buffer.getCopyOffset();
+		uint32_t size = buffer.getCopySize();
+		const double* copy = buffer.getFirstElementCopy();
+
+		/* values are the point indices, the snapshot in ring order has to be a contiguous run */
+		uint32_t oldest = size < maxSize ? 0 : offset;
+		double expected = copy[oldest];
+		for (uint32_t i = 0; i < size; i++)
+		{
+			ASSERT_EQ(copy[(oldest + i) % maxSize], expected) << "at " << i;
+			expected += 1.0;
+		}
+		ASSERT_GE(expected - 1.0, last);
+		last = expected - 1.0;
+	}
+	writer.join();
+}
+
+TEST(ScrollingBufferFreezeTest, frozenViewKeepsPointsWhileWriterMovesOn)
+{
+	static constexpr uint32_t maxSize = 3 * ScrollingBuffer<double>::maxChunkSize + 100;
+
+	auto pool = std::make_shared<ChunkPool<double>>();
+	ScrollingBuffer<double> buffer;
+	buffer.setChunkPool(pool);
+	buffer.setMaxSize(maxSize);
+
+	for (uint32_t i = 0; i < maxSize + 10; i++)
+		buffer.addPoint(i);
+
+	auto frozen = buffer.freeze();
+	EXPECT_EQ(frozen.getChunkCount(), 4);
+	EXPECT_EQ(frozen.getSize(), maxSize);
+	EXPECT_EQ(pool->getAllocatedBytes(), maxSize * sizeof(double));
+
+	/* only the chunk being overwritten is copied */
+	buffer.addPoint(-1.0);
+	EXPECT_EQ(pool->getAllocatedBytes(), (maxSize + ScrollingBuffer<double>::maxChunkSize) * sizeof(double));
+
+	for (uint32_t i = 0; i < maxSize; i++)
+		buffer.addPoint(-1.0);
+	buffer.release();
+
+	for (uint32_t i = 0; i < frozen.getSize(); i++)
+		ASSERT_EQ(frozen.getValue(i), i + 10.0);
+	EXPECT_EQ(frozen.upperBound(20.5), 11);
+
+	/* the chunks not shared anymore are reused by the next allocation */
+	size_t allocated = pool->getAllocatedBytes();
+	buffer.addPoint(1.0);
+	EXPECT_EQ(pool->getAllocatedBytes(), allocated);
+
+	std::vector<double> xs;
+	std::vector<double> ys;
+	ScrollingBuffer<double>::Frozen::decimate(frozen, frozen, 100.0, 5000.0, 100, xs, ys);
+	EXPECT_LE(xs.size(), 200);
+	EXPECT_EQ(xs.front(), 100.0);
+	EXPECT_EQ(xs.back(), 5001.0);
+	EXPECT_TRUE(std::is_sorted(xs.begin(), xs.end()));
+}
+
+TEST(ScrollingBufferFreezeTest, packedBufferDecodesInEveryView)
+{
+	class U16Codec : public PackedCodec<double>
+	{
+	   public:
+		uint8_t getWidth() const override { return 2; }
+		void decode(const uint8_t* words, uint32_t count, double* out) const override
+		{
+			for (uint32_t i = 0; i < count; i++)
+				out[i] = words[2 * i] | (words[2 * i + 1] << 8);
+		}
+	};
+
+	static constexpr uint32_t maxSize = 2 * ScrollingBuffer<double>::maxChunkSize + 1;
+
+	ScrollingBuffer<double> buffer;
+	buffer.setMaxSize(maxSize);
+	buffer.setCodec(std::make_shared<U16Codec>());
+
+	for (uint32_t i = 0; i < maxSize + 5; i++)
+		buffer.addRaw(i);
+	buffer.copyData();
+	EXPECT_EQ(buffer.getAllocatedBytes(), (2 * ScrollingBuffer<double>::maxChunkSize / 4 + 1) * sizeof(double) + maxSize * sizeof(double));
+
+	auto frozen = buffer.freeze();
+	buffer.addRaw(0);
+
+	double expected = 5.0;
+	frozen.forEach(0, frozen.getSize(), [&](double value)
+				   { ASSERT_EQ(value, expected++); });
+	for (uint32_t i = 0; i < maxSize; i++)
+		ASSERT_EQ(buffer.getCopyValue(i), i + 5.0);
+	EXPECT_EQ(buffer.getNewestValue(), 0.0);
+	EXPECT_EQ(buffer.getOldestValue(), 6.0);
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <filesystem>
+#include <memory>
+
+#include "SimulatedDebugProbe.hpp"
+#include "spdlog/sinks/null_sink.h"
+#include "spdlog/spdlog.h"
+
+class SimulatedDebugProbeTest : public ::testing::Test
+{
+   protected:
+	void SetUp() override
+	{
+		logger = std::make_shared<spdlog::logger>("simulated", std::make_shared<spdlog::sinks::null_sink_mt>());
+		probe = std::make_unique<SimulatedDebugProbe>(logger.get());
+		probeSettings.simulationLatencyUs = 0;
+		probeSettings.simulationBandwidthKBps = 100000;
+	}
+
+	std::shared_ptr<spdlog::logger> logger;
+	std::unique_ptr<SimulatedDebugProbe> probe;
+	IDebugProbe::DebugProbeSettings probeSettings{};
+	std::vector<std::pair<uint32_t, uint8_t>> sampleList;
+};
+
+TEST_F(SimulatedDebugProbeTest, parsesGenerators)
+{
+	auto generators = SimulatedDebugProbe::parseGenerators("0x20000000 sine 10 0.5; 0x20000004 counter 1 0.001 2 u16;bogus; 0x20000008 unknown");
+
+	ASSERT_EQ(generators.size(), 2);
+	EXPECT_EQ(generators[0].address, 0x20000000);
+	EXPECT_EQ(generators[0].type, SimulatedDebugProbe::Generator::Type::SINE);
+	EXPECT_EQ(generators[0].encoding, SimulatedDebugProbe::Generator::Encoding::F32);
+	EXPECT_DOUBLE_EQ(generators[0].amplitude, 10.0);
+	EXPECT_DOUBLE_EQ(generators[0].periodS, 0.5);
+
+	EXPECT_EQ(generators[1].type, SimulatedDebugProbe::Generator::Type::COUNTER);
+	EXPECT_EQ(generators[1].encoding, SimulatedDebugProbe::Generator::Encoding::U16);
+	EXPECT_DOUBLE_EQ(generators[1].offset, 2.0);
+}
+
+TEST_F(SimulatedDebugProbeTest, servesElfDataSection)
+{
+	probe->setElfFile((std::filesystem::path(__FILE__).parent_path() / "testFiles" / "MCUViewer_test.elf").string());
+	ASSERT_TRUE(probe->startAcqusition(probeSettings, sampleList, 100));
+
+	uint32_t value = 0;
+	ASSERT_TRUE(probe->readMemory(0x20000004, (uint8_t*)&value, 4));
+	EXPECT_EQ(value, 0x00f42400);
+
+	float floatValue = 0.0f;
+	ASSERT_TRUE(probe->readMemory(0x20000000, (uint8_t*)&floatValue, 4));
+	EXPECT_FLOAT_EQ(floatValue, -0.1f);
+
+	probe->stopAcqusition();
+	EXPECT_FALSE(probe->readMemory(0x20000004, (uint8_t*)&value, 4));
+}
+
+TEST_F(SimulatedDebugProbeTest, generatorsDriveMemoryInHssMode)
+{
+	probeSettings.mode = IDebugProbe::Mode::HSS;
+	probeSettings.simulationGenerators = "0x20000100 step 7 0.002 u8; 0x20000104 ramp 1000 10 u32";
+	sampleList = {{0x20000100, 1}, {0x20000104, 4}};
+
+	ASSERT_TRUE(probe->startAcqusition(probeSettings, sampleList, 1000));
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	probe->stopAcqusition();
+
+	size_t entries = 0;
+	bool stepHigh = false;
+	double lastTimestamp = -1.0;
+
+	while (auto entry = probe->readSingleEntry())
+	{
+		auto& [timestamp, values] = entry.value();
+		ASSERT_EQ(values.size(), 2);
+		EXPECT_GT(timestamp, lastTimestamp);
+		EXPECT_TRUE(values[0] == 0 || values[0] == 7);
+		stepHigh |= values[0] == 7;
+		lastTimestamp = timestamp;
+		entries++;
+	}
+
+	EXPECT_GT(entries, 20);
+	EXPECT_TRUE(stepHigh);
+}
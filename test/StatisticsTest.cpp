@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <vector>
 #define TEST_FRIENDS_STATISTICS friend class StatisticsTest;
 #include "Statistics.hpp"
@@ -55,3 +56,29 @@ TEST(StatisticsTest, testLvecHvec2)
 		std::cout << a << " ";
 	std::cout << std::endl;
 }
+
+TEST(StatisticsTest, testAnalogResultsFromWrappedSnapshot)
+{
+	ScrollingBuffer<double> time;
+	Plot::Series ser;
+	ser.buffer = std::make_shared<ScrollingBuffer<double>>();
+	time.setMaxSize(10);
+	ser.buffer->setMaxSize(10);
+
+	/* times 5..14 remain, the value is twice the time */
+	for (uint32_t i = 0; i < 15; i++)
+	{
+		time.addPoint(i);
+		ser.buffer->addPoint(2.0 * i);
+	}
+	time.copyData();
+	ser.buffer->copyData();
+
+	/* the sample held at 8.5 is excluded, the one held at 12.5 included */
+	Statistics::AnalogResults results;
+	Statistics::calculateResults(&ser, &time, 8.5, 12.5, results);
+	ASSERT_DOUBLE_EQ(results.min, 18.0);
+	ASSERT_DOUBLE_EQ(results.max, 24.0);
+	ASSERT_DOUBLE_EQ(results.mean, 21.0);
+	ASSERT_DOUBLE_EQ(results.stddev, std::sqrt(5.0));
+}
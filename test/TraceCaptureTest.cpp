@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "FileTraceProbe.hpp"
+#include "RecordingTraceProbe.hpp"
+#include "TraceReader.hpp"
+#include "spdlog/sinks/null_sink.h"
+#include "spdlog/spdlog.h"
+
+namespace
+{
+
+/* returns the given chunks one per read, then nothing */
+class ChunkTraceProbe : public ITraceProbe
+{
+   public:
+	explicit ChunkTraceProbe(std::vector<std::vector<uint8_t>> chunks) : chunks(std::move(chunks)) {}
+
+	bool startTrace(const TraceProbeSettings&, uint32_t, uint32_t, uint32_t, bool) override { return true; }
+	bool stopTrace() override { return true; }
+	int32_t readTraceBuffer(uint8_t* buffer, uint32_t size) override
+	{
+		if (next == chunks.size())
+			return 0;
+		auto& chunk = chunks[next++];
+		std::memcpy(buffer, chunk.data(), std::min<size_t>(size, chunk.size()));
+		return static_cast<int32_t>(std::min<size_t>(size, chunk.size()));
+	}
+	std::string getTargetName() override { return "chunks"; }
+	std::vector<std::string> getConnectedDevices() override { return {"chunks"}; }
+
+   private:
+	std::vector<std::vector<uint8_t>> chunks;
+	size_t next = 0;
+};
+
+}  // namespace
+
+class TraceCaptureTest : public ::testing::Test
+{
+   protected:
+	void SetUp() override
+	{
+		logger = std::make_shared<spdlog::logger>("capture", std::make_shared<spdlog::sinks::null_sink_mt>());
+		capturePath = (std::filesystem::temp_directory_path() / "MCUViewer_trace_capture_test.swo").string();
+		probeSettings.replayFilePath = capturePath;
+		probeSettings.replayRealTime = false;
+	}
+
+	void TearDown() override
+	{
+		std::filesystem::remove(capturePath);
+	}
+
+	void record(const std::vector<std::vector<uint8_t>>& chunks)
+	{
+		RecordingTraceProbe recorder(std::make_shared<ChunkTraceProbe>(chunks), capturePath, logger.get());
+		ASSERT_TRUE(recorder.startTrace(probeSettings, 160000000, 10, 0xffffffff, false));
+
+		std::array<uint8_t, 64> buffer{};
+		for (size_t i = 0; i <= chunks.size(); i++)
+			recorder.readTraceBuffer(buffer.data(), buffer.size());
+		ASSERT_TRUE(recorder.stopTrace());
+	}
+
+	std::shared_ptr<spdlog::logger> logger;
+	std::string capturePath;
+	ITraceProbe::TraceProbeSettings probeSettings{};
+};
+
+TEST_F(TraceCaptureTest, replaysRecordedBytesInAnyReadSize)
+{
+	std::vector<std::vector<uint8_t>> chunks = {{1, 2, 3}, {}, {4, 5, 6, 7, 8, 9, 10}, {11}, {12, 13, 14, 15, 16}};
+	record(chunks);
+
+	std::vector<uint8_t> expected;
+	for (auto& chunk : chunks)
+		expected.insert(expected.end(), chunk.begin(), chunk.end());
+
+	for (uint32_t readSize : {1u, 4u, 64u})
+	{
+		FileTraceProbe replay(logger.get());
+		ASSERT_TRUE(replay.startTrace(probeSettings, 160000000, 10, 0xffffffff, false));
+
+		std::vector<uint8_t> replayed;
+		std::vector<uint8_t> buffer(readSize);
+		for (int32_t length; (length = replay.readTraceBuffer(buffer.data(), readSize)) > 0;)
+			replayed.insert(replayed.end(), buffer.begin(), buffer.begin() + length);
+
+		EXPECT_EQ(replayed, expected) << "read size " << readSize;
+		EXPECT_TRUE(replay.isEndOfCapture());
+		EXPECT_EQ(replay.readTraceBuffer(buffer.data(), readSize), 0);
+	}
+}
+
+TEST_F(TraceCaptureTest, rejectsFileWithoutHeader)
+{
+	std::ofstream(capturePath, std::ios::binary) << "not a capture";
+
+	FileTraceProbe replay(logger.get());
+	EXPECT_FALSE(replay.startTrace(probeSettings, 160000000, 10, 0xffffffff, false));
+
+	uint8_t byte = 0;
+	EXPECT_EQ(replay.readTraceBuffer(&byte, 1), -1);
+}
+
+TEST_F(TraceCaptureTest, replayedCaptureDecodesLikeTheLiveStream)
+{
+	/* the frames of TraceReaderTest.testdoubleBuffersBoundaryTimestamp */
+	record({{9, 187, 192, 206, 9, 17, 170, 192, 35, 17, 187, 192, 233, 2, 9, 170, 192},
+			{165, 1, 9, 187, 192, 202, 9, 17, 170, 192, 35, 17, 187, 192, 234, 2, 25, 170, 192, 23}});
+
+	std::array<std::pair<uint8_t, uint32_t>, 8> expectedEvents{{{1, 187}, {2, 170}, {2, 187}, {1, 170}, {1, 187}, {2, 170}, {2, 187}, {3, 170}}};
+	std::array<bool, 32> activeChannels{};
+	activeChannels.fill(true);
+
+	TraceReader traceReader(logger.get());
+	traceReader.setTraceTimeout(0);
+	traceReader.changeDevice(std::make_shared<FileTraceProbe>(logger.get()));
+	ASSERT_TRUE(traceReader.startAcqusition(probeSettings, activeChannels));
+
+	double previousTimestamp = 0.0;
+	for (auto& [channel, value] : expectedEvents)
+	{
+		TraceReader::TraceEvent event{};
+		ASSERT_TRUE(traceReader.readTrace(event, std::chrono::milliseconds(1000)));
+		EXPECT_EQ(event.channel, channel);
+		EXPECT_EQ(event.value, value);
+		EXPECT_GT(event.timestamp, previousTimestamp);
+		previousTimestamp = event.timestamp;
+	}
+	traceReader.stopAcqusition();
+}
@@ -71,9 +71,7 @@ TEST_F(TraceReaderTest, startTest)
 TEST_F(TraceReaderTest, testChannelsAndTimestamp)
 {
 	uint8_t buf[] = {9, 187, 192, 206, 9};
-	std::array<uint32_t, 10> trace{};
-	std::array<uint32_t, 10> expected{0, 187, 0, 0, 0, 0, 0, 0, 0, 0};
-	double timestamp = 0.0;
+	TraceReader::TraceEvent event{};
 
 	EXPECT_CALL(*TraceProbe, readTraceBuffer(_, _)).WillOnce(testing::Invoke([&](uint8_t* buffer, uint32_t size)
 																			  {memcpy(buffer,buf,sizeof(buf));
@@ -82,9 +80,10 @@ TEST_F(TraceReaderTest, testChannelsAndTimestamp)
 
 	traceReader->startAcqusition(probeSettings, activeChannels);
 	std::this_thread::sleep_for(std::chrono::milliseconds(50));
-	ASSERT_EQ(traceReader->readTrace(timestamp, trace), true);
-	ASSERT_NEAR(7.6875e-06, timestamp, 1e-9);
-	ASSERT_EQ(trace, expected);
+	ASSERT_EQ(traceReader->readTrace(event), true);
+	ASSERT_NEAR(7.6875e-06, event.timestamp, 1e-9);
+	ASSERT_EQ(event.channel, 1);
+	ASSERT_EQ(event.value, 187);
 }
 
 TEST_F(TraceReaderTest, testdoubleBuffersBoundaryTimestamp)
@@ -100,17 +99,8 @@ TEST_F(TraceReaderTest, testdoubleBuffersBoundaryTimestamp)
 					  17, 187, 192, 234, 2,
 					  25, 170, 192, 23};
 
-	std::array<uint32_t, channels> trace{};
-
 	std::array<double, 10> expectedTimestamp = {7.6875e-06, 2.1875e-07, 2.25625e-06, 1.03125e-06, 7.6625e-06, 2.1875e-07, 2.2625e-06, 1.4375e-07};
-	std::array<std::array<uint32_t, channels>, 8> expectedTrace{{{{0, 187, 0, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 170, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 170, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 170, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 170, 0, 0, 0, 0, 0, 0}}}};
+	std::array<std::pair<uint8_t, uint32_t>, 8> expectedEvents{{{1, 187}, {2, 170}, {2, 187}, {1, 170}, {1, 187}, {2, 170}, {2, 187}, {3, 170}}};
 
 	EXPECT_CALL(*TraceProbe, readTraceBuffer(_, _))
 		.WillOnce(testing::Invoke([&](uint8_t* buffer, uint32_t size)
@@ -124,13 +114,16 @@ TEST_F(TraceReaderTest, testdoubleBuffersBoundaryTimestamp)
 	traceReader->startAcqusition(probeSettings, activeChannels);
 	std::this_thread::sleep_for(std::chrono::milliseconds(50));
 
-	int i = 0;
-	for (auto& e : expectedTrace)
+	/* the timestamps are deltas, the events carry the time since the start */
+	double time = 0.0;
+	for (size_t i = 0; i < expectedEvents.size(); i++)
 	{
-		double timestamp = 0.0;
-		ASSERT_EQ(traceReader->readTrace(timestamp, trace), true);
-		ASSERT_NEAR(expectedTimestamp[i++], timestamp, 10e-9);
-		ASSERT_EQ(trace, e);
+		TraceReader::TraceEvent event{};
+		time += expectedTimestamp[i];
+		ASSERT_EQ(traceReader->readTrace(event), true);
+		ASSERT_NEAR(time, event.timestamp, 10e-9);
+		ASSERT_EQ(event.channel, expectedEvents[i].first);
+		ASSERT_EQ(event.value, expectedEvents[i].second);
 	}
 }
 
@@ -146,14 +139,7 @@ TEST_F(TraceReaderTest, testChannelsAndTimestamp2)
 					 25, 170, 192, 23};
 
 	std::array<double, 10> expectedTimestamp = {7.6875e-06, 2.1875e-07, 2.25625e-06, 1.03125e-06, 7.6625e-06, 2.1875e-07, 2.2625e-06, 1.4375e-07};
-	std::array<std::array<uint32_t, channels>, 8> expectedTrace{{{{0, 187, 0, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 170, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 170, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 170, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 170, 0, 0, 0, 0, 0, 0}}}};
+	std::array<std::pair<uint8_t, uint32_t>, 8> expectedEvents{{{1, 187}, {2, 170}, {2, 187}, {1, 170}, {1, 187}, {2, 170}, {2, 187}, {3, 170}}};
 
 	EXPECT_CALL(*TraceProbe, readTraceBuffer(_, _))
 		.WillOnce(testing::Invoke([&](uint8_t* buffer, uint32_t size)
@@ -164,14 +150,16 @@ TEST_F(TraceReaderTest, testChannelsAndTimestamp2)
 	traceReader->startAcqusition(probeSettings, activeChannels);
 	std::this_thread::sleep_for(std::chrono::milliseconds(50));
 
-	int i = 0;
-	for (auto& e : expectedTrace)
+	/* the timestamps are deltas, the events carry the time since the start */
+	double time = 0.0;
+	for (size_t i = 0; i < expectedEvents.size(); i++)
 	{
-		std::array<uint32_t, channels> trace{};
-		double timestamp = 0.0;
-		ASSERT_EQ(traceReader->readTrace(timestamp, trace), true);
-		ASSERT_NEAR(expectedTimestamp[i++], timestamp, 10e-9);
-		ASSERT_EQ(trace, e);
+		TraceReader::TraceEvent event{};
+		time += expectedTimestamp[i];
+		ASSERT_EQ(traceReader->readTrace(event), true);
+		ASSERT_NEAR(time, event.timestamp, 10e-9);
+		ASSERT_EQ(event.channel, expectedEvents[i].first);
+		ASSERT_EQ(event.value, expectedEvents[i].second);
 	}
 }
 
@@ -187,17 +175,8 @@ TEST_F(TraceReaderTest, testdoubleBuffers)
 					  17, 187, 192, 234, 2,
 					  25, 170, 192, 23};
 
-	std::array<uint32_t, channels> trace{};
-
 	std::array<double, 10> expectedTimestamp = {7.6875e-06, 2.1875e-07, 2.25625e-06, 1.03125e-06, 7.6625e-06, 2.1875e-07, 2.2625e-06, 1.4375e-07};
-	std::array<std::array<uint32_t, channels>, 8> expectedTrace{{{{0, 187, 0, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 170, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 170, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 170, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 170, 0, 0, 0, 0, 0, 0}}}};
+	std::array<std::pair<uint8_t, uint32_t>, 8> expectedEvents{{{1, 187}, {2, 170}, {2, 187}, {1, 170}, {1, 187}, {2, 170}, {2, 187}, {3, 170}}};
 
 	EXPECT_CALL(*TraceProbe, readTraceBuffer(_, _))
 		.WillOnce(testing::Invoke([&](uint8_t* buffer, uint32_t size)
@@ -211,13 +190,16 @@ TEST_F(TraceReaderTest, testdoubleBuffers)
 	traceReader->startAcqusition(probeSettings, activeChannels);
 	std::this_thread::sleep_for(std::chrono::milliseconds(50));
 
-	int i = 0;
-	for (auto& e : expectedTrace)
+	/* the timestamps are deltas, the events carry the time since the start */
+	double time = 0.0;
+	for (size_t i = 0; i < expectedEvents.size(); i++)
 	{
-		double timestamp = 0.0;
-		ASSERT_EQ(traceReader->readTrace(timestamp, trace), true);
-		ASSERT_NEAR(expectedTimestamp[i++], timestamp, 10e-9);
-		ASSERT_EQ(trace, e);
+		TraceReader::TraceEvent event{};
+		time += expectedTimestamp[i];
+		ASSERT_EQ(traceReader->readTrace(event), true);
+		ASSERT_NEAR(time, event.timestamp, 10e-9);
+		ASSERT_EQ(event.channel, expectedEvents[i].first);
+		ASSERT_EQ(event.value, expectedEvents[i].second);
 	}
 }
 
@@ -233,17 +215,8 @@ TEST_F(TraceReaderTest, testdoubleBuffersBoundarySource)
 					  17, 187, 192, 234, 2,
 					  25, 170, 192, 23};
 
-	std::array<uint32_t, channels> trace{};
-
 	std::array<double, 10> expectedTimestamp = {7.6875e-06, 2.1875e-07, 2.25625e-06, 1.03125e-06, 7.6625e-06, 2.1875e-07, 2.2625e-06, 1.4375e-07};
-	std::array<std::array<uint32_t, channels>, 8> expectedTrace{{{{0, 187, 0, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 170, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 170, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 170, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 0, 0, 0, 0, 0, 0, 0}},
-																 {{0, 187, 187, 170, 0, 0, 0, 0, 0, 0}}}};
+	std::array<std::pair<uint8_t, uint32_t>, 8> expectedEvents{{{1, 187}, {2, 170}, {2, 187}, {1, 170}, {1, 187}, {2, 170}, {2, 187}, {3, 170}}};
 
 	EXPECT_CALL(*TraceProbe, readTraceBuffer(_, _))
 		.WillOnce(testing::Invoke([&](uint8_t* buffer, uint32_t size)
@@ -257,12 +230,36 @@ TEST_F(TraceReaderTest, testdoubleBuffersBoundarySource)
 	traceReader->startAcqusition(probeSettings, activeChannels);
 	std::this_thread::sleep_for(std::chrono::milliseconds(50));
 
-	int i = 0;
-	for (auto& e : expectedTrace)
+	/* the timestamps are deltas, the events carry the time since the start */
+	double time = 0.0;
+	for (size_t i = 0; i < expectedEvents.size(); i++)
 	{
-		double timestamp = 0.0;
-		ASSERT_EQ(traceReader->readTrace(timestamp, trace), true);
-		ASSERT_NEAR(expectedTimestamp[i++], timestamp, 10e-9);
-		ASSERT_EQ(trace, e);
+		TraceReader::TraceEvent event{};
+		time += expectedTimestamp[i];
+		ASSERT_EQ(traceReader->readTrace(event), true);
+		ASSERT_NEAR(time, event.timestamp, 10e-9);
+		ASSERT_EQ(event.channel, expectedEvents[i].first);
+		ASSERT_EQ(event.value, expectedEvents[i].second);
 	}
 }
+
+TEST_F(TraceReaderTest, testRawBufferIndicators)
+{
+	uint8_t buf[] = {9, 187, 192, 206, 9,
+					 17, 170, 192, 35};
+
+	EXPECT_CALL(*TraceProbe, readTraceBuffer(_, _))
+		.WillOnce(testing::Invoke([&](uint8_t* buffer, uint32_t size)
+								  {memcpy(buffer,buf,sizeof(buf));
+                                   return sizeof(buf); }))
+		.WillRepeatedly(Return(0));
+
+	traceReader->startAcqusition(probeSettings, activeChannels);
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	auto indicators = traceReader->getTraceIndicators();
+	ASSERT_EQ(indicators.rawBufferMaxDepth, sizeof(buf));
+	ASSERT_EQ(indicators.rawBufferOverflows, 0);
+	ASSERT_EQ(indicators.tableMaxDepth, 2);
+	ASSERT_EQ(indicators.framesTotal, 4);
+}
@@ -3,6 +3,7 @@
 #include <array>
 #include <iostream>
 
+#include "SampleDecoder.hpp"
 #include "Variable.hpp"
 
 TEST(VariableTest, testSignedFracPositive)
@@ -110,3 +111,45 @@ TEST(VariableTest, testUnsignedFracUnsignedVarNegative)
 
 	ASSERT_NEAR(value, 1.0, 10e-3);
 }
+
+TEST(VariableTest, testSampleDecoderMatchesTransformToDouble)
+{
+	struct Case
+	{
+		Variable::Type type;
+		Variable::HighLevelType highLevelType;
+		uint32_t raw;
+	};
+	const Case cases[] = {
+		{Variable::Type::U8, Variable::HighLevelType::NONE, 0xfe},
+		{Variable::Type::I8, Variable::HighLevelType::NONE, 0xfe},
+		{Variable::Type::U16, Variable::HighLevelType::NONE, 0x8001},
+		{Variable::Type::I16, Variable::HighLevelType::NONE, 0x8001},
+		{Variable::Type::U32, Variable::HighLevelType::NONE, 0x80000001},
+		{Variable::Type::I32, Variable::HighLevelType::NONE, 0x80000001},
+		{Variable::Type::F32, Variable::HighLevelType::NONE, 0x3fc00000},
+		{Variable::Type::I16, Variable::HighLevelType::SIGNEDFRAC, 0x8000},
+		{Variable::Type::U16, Variable::HighLevelType::UNSIGNEDFRAC, 0xfffe},
+	};
+
+	for (const auto& testCase : cases)
+	{
+		Variable var{"test"};
+		var.setType(testCase.type);
+		var.setHighLevelType(testCase.highLevelType);
+		var.setFractional({15, 3.3});
+		var.setRawValue(testCase.raw);
+
+		auto decoder = SampleDecoder::create(var);
+		ASSERT_NE(decoder, nullptr);
+		EXPECT_EQ(decoder->getWidth(), var.getSize());
+		EXPECT_EQ(decoder->decode(var.getRawValue()), var.transformToDouble()) << var.getTypeStr();
+	}
+
+	Variable base{"base"};
+	Variable scaled{"scaled"};
+	scaled.setType(Variable::Type::I16);
+	scaled.setHighLevelType(Variable::HighLevelType::SIGNEDFRAC);
+	scaled.setFractional({15, 1.0, &base});
+	EXPECT_EQ(SampleDecoder::create(scaled), nullptr);
+}